@@ -42,16 +42,62 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <chrono>
 #include <cmath>
+#include <condition_variable>
 #include <cstdint>
+#include <cstdio>
 #include <cstring>
+#include <exception>
 #include <fstream>
+#include <functional>
+#include <future>
 #include <iostream>
+#include <limits>
+#include <list>
 #include <memory>
+#include <mutex>
+#include <queue>
+#include <random>
 #include <string>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
 #include <vector>
 
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// NOTE: Define `LLAS_NO_SIMD` to use the scalar code paths only
+#if !defined(LLAS_NO_SIMD)
+#if defined(__AVX__)
+#define LLAS_SIMD_AVX
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define LLAS_SIMD_SSE2
+#if defined(__SSSE3__) || defined(__AVX__)
+#define LLAS_SIMD_SSSE3
+#endif
+#include <immintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#define LLAS_SIMD_NEON
+#include <arm_neon.h>
+#endif
+#endif
+
 #if defined(LLAS_STATIC)
 #define LLAS_FUNC_DECL_PREFIX static
 #else
@@ -101,7 +147,204 @@ namespace llas {
 // Utility Functions
 // ==========================================================================
 
-// Nothing
+// NOTE: Minimum number of items per thread. Smaller ranges are processed on the calling thread.
+#define LLAS_MIN_ITEMS_PER_THREAD 65536
+
+/// @brief Resolve the number of worker threads
+/// @param nThreads Requested number of threads. `0` means all hardware threads.
+/// @return `nThreads` (`size_t`): at least 1
+LLAS_FUNC_DECL_PREFIX size_t resolveNumThreads(const size_t nThreads) {
+  if (nThreads == 0) {
+    return std::max<size_t>(1, std::thread::hardware_concurrency());
+  }
+  return nThreads;
+}
+
+/// @brief Get the number of blocks `parallelFor` splits `[0, nItems)` into
+/// @param nItems Number of items
+/// @param nThreads Number of threads. `0` means all hardware threads.
+/// @param minItemsPerThread Minimum number of items per block. Use a small value for expensive items.
+/// @return `nBlocks` (`size_t`): at least 1
+LLAS_FUNC_DECL_PREFIX size_t getNumParallelBlocks(const size_t nItems,
+                                                  const size_t nThreads,
+                                                  const size_t minItemsPerThread = LLAS_MIN_ITEMS_PER_THREAD) {
+  return std::min(resolveNumThreads(nThreads), std::max<size_t>(1, nItems / std::max<size_t>(1, minItemsPerThread)));
+}
+
+/// @brief Split `[0, nItems)` into `getNumParallelBlocks` contiguous blocks and call `func(iBlock, begin, end)` for each block on its own thread
+/// @param nItems Number of items
+/// @param nThreads Number of threads. `0` means all hardware threads.
+/// @param func Callable with signature `void(size_t iBlock, size_t begin, size_t end)`. The first exception it throws is rethrown once all blocks are done.
+/// @param minItemsPerThread Minimum number of items per block
+template <class Func>
+void parallelForBlocks(const size_t nItems, const size_t nThreads, Func&& func, const size_t minItemsPerThread = LLAS_MIN_ITEMS_PER_THREAD) {
+  const size_t nBlocks = getNumParallelBlocks(nItems, nThreads, minItemsPerThread);
+
+  if (nBlocks <= 1) {
+    func((size_t)0, (size_t)0, nItems);
+    return;
+  }
+
+  const size_t blockSize = (nItems + nBlocks - 1) / nBlocks;
+
+  // NOTE: An exception must not leave a thread unjoined or escape a thread, both of which terminate the process
+  std::exception_ptr exception = nullptr;
+  std::mutex exceptionMutex;
+  const auto runBlock = [&](const size_t iBlock, const size_t begin, const size_t end) {
+    try {
+      func(iBlock, begin, end);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(exceptionMutex);
+      if (exception == nullptr) {
+        exception = std::current_exception();
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(nBlocks - 1);
+
+  for (size_t iBlock = 1; iBlock < nBlocks; ++iBlock) {
+    const size_t begin = std::min(nItems, iBlock * blockSize);
+    const size_t end = std::min(nItems, begin + blockSize);
+    threads.emplace_back([&runBlock, iBlock, begin, end]() { runBlock(iBlock, begin, end); });
+  }
+
+  // NOTE: The first block runs on the calling thread
+  runBlock((size_t)0, (size_t)0, std::min(nItems, blockSize));
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  if (exception != nullptr) {
+    std::rethrow_exception(exception);
+  }
+}
+
+/// @brief Split `[0, nItems)` into contiguous blocks and call `func(begin, end)` for each block on its own thread
+/// @param nItems Number of items
+/// @param nThreads Number of threads. `0` means all hardware threads.
+/// @param func Callable with signature `void(size_t begin, size_t end)`
+/// @param minItemsPerThread Minimum number of items per block
+template <class Func>
+void parallelFor(const size_t nItems, const size_t nThreads, Func&& func, const size_t minItemsPerThread = LLAS_MIN_ITEMS_PER_THREAD) {
+  parallelForBlocks(
+      nItems, nThreads, [&func](const size_t, const size_t begin, const size_t end) { func(begin, end); }, minItemsPerThread);
+}
+
+/// @brief Measure elapsed times with a monotonic clock
+class Stopwatch {
+ public:
+  Stopwatch()
+      : _startTime(std::chrono::steady_clock::now()) {}
+
+  /// @brief Get the seconds since the construction or the last `lap` and restart
+  inline double lap() {
+    const auto now = std::chrono::steady_clock::now();
+    const double elapsedTime = std::chrono::duration<double>(now - _startTime).count();
+    _startTime = now;
+    return elapsedTime;
+  }
+
+ private:
+  std::chrono::steady_clock::time_point _startTime;
+};
+
+/// @brief Interleave the lower 21 bits of `x`, `y` and `z` into a Morton code (Z-order curve)
+/// @return `code` (`LLAS_ULLONG`): bits `[..., z1, y1, x1, z0, y0, x0]`
+LLAS_FUNC_DECL_PREFIX LLAS_ULLONG getMortonCode(const LLAS_ULONG x,
+                                                const LLAS_ULONG y,
+                                                const LLAS_ULONG z) {
+  const auto spreadBits = [](LLAS_ULLONG v) {
+    v &= 0x1FFFFFULL;
+    v = (v | v << 32) & 0x1F00000000FFFFULL;
+    v = (v | v << 16) & 0x1F0000FF0000FFULL;
+    v = (v | v << 8) & 0x100F00F00F00F00FULL;
+    v = (v | v << 4) & 0x10C30C30C30C30C3ULL;
+    v = (v | v << 2) & 0x1249249249249249ULL;
+    return v;
+  };
+  return spreadBits(x) | spreadBits(y) << 1 | spreadBits(z) << 2;
+}
+
+/// @brief Get the permutation which sorts `keys` in ascending order with a parallel LSD radix sort. Equal keys keep their order.
+/// @param keys Keys to sort
+/// @param nThreads Number of threads. `0` means all hardware threads.
+/// @return `indices` (`std::vector<size_t>`): `keys[indices[i]]` is the `i`-th smallest key
+LLAS_FUNC_DECL_PREFIX std::vector<size_t> sortIndicesByKeys(const std::vector<LLAS_ULLONG>& keys,
+                                                            const size_t nThreads = 1) {
+  const size_t RADIX_BITS = 11;
+  const size_t N_BUCKETS = (size_t)1 << RADIX_BITS;
+
+  struct Item {
+    LLAS_ULLONG key;
+    size_t index;
+  };
+
+  const size_t nItems = keys.size();
+  const size_t nBlocks = getNumParallelBlocks(nItems, nThreads);
+
+  std::vector<Item> items(nItems);
+  std::vector<LLAS_ULLONG> blockUsedBits(nBlocks, 0);
+  parallelForBlocks(nItems, nThreads, [&](const size_t iBlock, const size_t begin, const size_t end) {
+    LLAS_ULLONG usedBits = 0;
+    for (size_t i = begin; i < end; ++i) {
+      items[i] = {keys[i], i};
+      usedBits |= keys[i];
+    }
+    blockUsedBits[iBlock] = usedBits;
+  });
+
+  // NOTE: Digits above the highest set bit of all keys are zero and need no pass
+  LLAS_ULLONG usedBits = 0;
+  for (const LLAS_ULLONG& bits : blockUsedBits) {
+    usedBits |= bits;
+  }
+
+  std::vector<Item> sortedItems(nItems);
+  std::vector<size_t> offsets(nBlocks * N_BUCKETS);
+  for (size_t shift = 0; shift < 64 && (usedBits >> shift) != 0; shift += RADIX_BITS) {
+    std::fill(offsets.begin(), offsets.end(), 0);
+    parallelForBlocks(nItems, nThreads, [&](const size_t iBlock, const size_t begin, const size_t end) {
+      size_t* counts = offsets.data() + iBlock * N_BUCKETS;
+      for (size_t i = begin; i < end; ++i) {
+        ++counts[(items[i].key >> shift) & (N_BUCKETS - 1)];
+      }
+    });
+
+    // NOTE: Each block scatters its items of a bucket after those of the previous blocks, which keeps the sort stable
+    bool isDigitShared = false;
+    size_t offset = 0;
+    for (size_t iBucket = 0; iBucket < N_BUCKETS && !isDigitShared; ++iBucket) {
+      for (size_t iBlock = 0; iBlock < nBlocks; ++iBlock) {
+        const size_t count = offsets[iBlock * N_BUCKETS + iBucket];
+        isDigitShared = isDigitShared || count == nItems;
+        offsets[iBlock * N_BUCKETS + iBucket] = offset;
+        offset += count;
+      }
+    }
+    if (isDigitShared) {
+      continue;
+    }
+
+    parallelForBlocks(nItems, nThreads, [&](const size_t iBlock, const size_t begin, const size_t end) {
+      size_t* blockOffsets = offsets.data() + iBlock * N_BUCKETS;
+      for (size_t i = begin; i < end; ++i) {
+        sortedItems[blockOffsets[(items[i].key >> shift) & (N_BUCKETS - 1)]++] = items[i];
+      }
+    });
+    items.swap(sortedItems);
+  }
+
+  std::vector<size_t> indices(nItems);
+  parallelFor(nItems, nThreads, [&](const size_t begin, const size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      indices[i] = items[i].index;
+    }
+  });
+  return indices;
+}
 
 // ==========================================================================
 // Math utility
@@ -564,1118 +807,9818 @@ vec2_t<DType> operator/(const DType& left, const vec2_t<DType>& right) {
 }  // namespace math
 
 // ==========================================================================
-// Data structure
+// SIMD kernels
 // ==========================================================================
-struct PublicHeader {
-  // clang-format off
-  inline static const std::streamsize NUM_BYTES_FILE_SIGNATURE                                      = 4;
-  inline static const std::streamsize NUM_BYTES_FILE_SOURCE_ID                                      = 2;
-  inline static const std::streamsize NUM_BYTES_GLOBAL_ENCODING                                     = 2;
-  inline static const std::streamsize NUM_BYTES_PROJECT_ID_1                                        = 4;
-  inline static const std::streamsize NUM_BYTES_PROJECT_ID_2                                        = 2;
-  inline static const std::streamsize NUM_BYTES_PROJECT_ID_3                                        = 2;
-  inline static const std::streamsize NUM_BYTES_PROJECT_ID_4                                        = 8;
-  inline static const std::streamsize NUM_BYTES_VERSION_MAJOR                                       = 1;
-  inline static const std::streamsize NUM_BYTES_VERSION_MINOR                                       = 1;
-  inline static const std::streamsize NUM_BYTES_SYSTEM_IDENTIFIER                                   = 32;
-  inline static const std::streamsize NUM_BYTES_GENERATING_SOFTWARE                                 = 32;
-  inline static const std::streamsize NUM_BYTES_FILE_CREATION_DAY_OF_YEAR                           = 2;
-  inline static const std::streamsize NUM_BYTES_FILE_CREATION_YEAR                                  = 2;
-  inline static const std::streamsize NUM_BYTES_HEADER_SIZE                                         = 2;
-  inline static const std::streamsize NUM_BYTES_OFFSET_TO_POINT_DATA                                = 4;
-  inline static const std::streamsize NUM_BYTES_NUM_OF_VARIABLE_LENGTH_RECORDS                      = 4;
-  inline static const std::streamsize NUM_BYTES_POINT_DATA_RECORD_FORMAT                            = 1;
-  inline static const std::streamsize NUM_BYTES_POINT_DATA_RECORD_LENGTH                            = 2;
-  inline static const std::streamsize NUM_BYTES_LEGACY_NUM_OF_POINT_RECORDS                         = 4;
-  inline static const std::streamsize NUM_BYTES_LEGACY_NUM_OF_POINT_BY_RETURN                       = 20;
-  inline static const std::streamsize NUM_BYTES_X_SCALE_FACTOR                                      = 8;
-  inline static const std::streamsize NUM_BYTES_Y_SCALE_FACTOR                                      = 8;
-  inline static const std::streamsize NUM_BYTES_Z_SCALE_FACTOR                                      = 8;
-  inline static const std::streamsize NUM_BYTES_X_OFFSET                                            = 8;
-  inline static const std::streamsize NUM_BYTES_Y_OFFSET                                            = 8;
-  inline static const std::streamsize NUM_BYTES_Z_OFFSET                                            = 8;
-  inline static const std::streamsize NUM_BYTES_MAX_X                                               = 8;
-  inline static const std::streamsize NUM_BYTES_MAX_Y                                               = 8;
-  inline static const std::streamsize NUM_BYTES_MAX_Z                                               = 8;
-  inline static const std::streamsize NUM_BYTES_MIN_X                                               = 8;
-  inline static const std::streamsize NUM_BYTES_MIN_Y                                               = 8;
-  inline static const std::streamsize NUM_BYTES_MIN_Z                                               = 8;
-  inline static const std::streamsize NUM_BYTES_START_OF_WAVEFORM_DATA_PACKET_RECORD                = 8;
-  inline static const std::streamsize NUM_BYTES_START_OF_FIRST_EXTENDED_VARIABLE_LENGTH_RECORD      = 8;
-  inline static const std::streamsize NUM_BYTES_NUM_OF_EXTENDED_VARIABLE_LENGTH_RECORDS             = 4;
-  inline static const std::streamsize NUM_BYTES_NUM_OF_POINT_RECORDS                                = 8;
-  inline static const std::streamsize NUM_BYTES_NUM_OF_POINTS_BY_RETURN                             = 120;
-  // clang-format on
-
-  PublicHeader()
-      : fileSignature(),
-        fileSourceID(),
-        globalEncoding(),
-        projectID1(),
-        projectID2(),
-        projectID3(),
-        projectID4(),
-        versionMajor(),
-        versionMinor(),
-        systemIdentifier(),
-        generatingSoftware(),
-        fileCreationDayOfYear(),
-        fileCreationYear(),
-        headerSize(),
-        offsetToPointData(),
-        numOfVariableLengthRecords(),
-        pointDataRecordFormat(),
-        pointDataRecordLength(),
-        legacyNumOfPointRecords(),
-        legacyNumOfPointByReturn(),
-        xScaleFactor(),
-        yScaleFactor(),
-        zScaleFactor(),
-        xOffset(),
-        yOffset(),
-        zOffset(),
-        maxX(),
-        maxY(),
-        maxZ(),
-        minX(),
-        minY(),
-        minZ(),
-        startOfWaveformDataPacketRecord(),
-        startOfFirstExtendedVariableLengthRecord(),
-        numOfExtendedVariableLengthRecords(),
-        numOfPointRecords(),
-        numOfPointsByReturn(),
-        hasStartOfWaveformDataPacketRecord(),
-        hasStartOfFirstExtendedVariableLengthRecord(),
-        hasNumOfExtendedVariableLengthRecords(),
-        hasNumOfPointRecords(),
-        hasNumOfPointsByReturn() {
-  }
+namespace simd {
+#if defined(LLAS_SIMD_SSE2)
+/// @brief Store 2 points as `[x0, y0, z0, x1, y1, z1]`
+inline void _storeInterleaved(double* out, const __m128d& x, const __m128d& y, const __m128d& z) {
+  _mm_storeu_pd(out + 0, _mm_unpacklo_pd(x, y));  // x0 y0
+  _mm_storeu_pd(out + 2, _mm_shuffle_pd(z, x, 2));  // z0 x1
+  _mm_storeu_pd(out + 4, _mm_unpackhi_pd(y, z));  // y1 z1
+}
 
-  // clang-format off
-  LLAS_CHAR      fileSignature[NUM_BYTES_FILE_SIGNATURE + 1];           // plus null-termination
-  LLAS_USHORT    fileSourceID;
-  LLAS_USHORT    globalEncoding;
-  LLAS_ULONG     projectID1;
-  LLAS_USHORT    projectID2;
-  LLAS_USHORT    projectID3;
-  LLAS_CHAR      projectID4[NUM_BYTES_PROJECT_ID_4 + 1];                // plus null-termination
-  LLAS_UCHAR     versionMajor;
-  LLAS_UCHAR     versionMinor;
-  LLAS_CHAR      systemIdentifier[NUM_BYTES_SYSTEM_IDENTIFIER + 1];     // plus null-termination
-  LLAS_CHAR      generatingSoftware[NUM_BYTES_GENERATING_SOFTWARE + 1]; // plus null-termination
-  LLAS_USHORT    fileCreationDayOfYear;
-  LLAS_USHORT    fileCreationYear;
-  LLAS_USHORT    headerSize;
-  LLAS_ULONG     offsetToPointData;
-  LLAS_ULONG     numOfVariableLengthRecords;
-  LLAS_UCHAR     pointDataRecordFormat;
-  LLAS_USHORT    pointDataRecordLength;
-  LLAS_ULONG     legacyNumOfPointRecords;
-  LLAS_ULONG     legacyNumOfPointByReturn[NUM_BYTES_LEGACY_NUM_OF_POINT_BY_RETURN / sizeof(LLAS_ULONG)];
-  LLAS_DOUBLE    xScaleFactor;
-  LLAS_DOUBLE    yScaleFactor;
-  LLAS_DOUBLE    zScaleFactor;
-  LLAS_DOUBLE    xOffset;
-  LLAS_DOUBLE    yOffset;
-  LLAS_DOUBLE    zOffset;
-  LLAS_DOUBLE    maxX;
-  LLAS_DOUBLE    maxY;
-  LLAS_DOUBLE    maxZ;
-  LLAS_DOUBLE    minX;
-  LLAS_DOUBLE    minY;
-  LLAS_DOUBLE    minZ;
-  LLAS_ULLONG    startOfWaveformDataPacketRecord;
-  LLAS_ULLONG    startOfFirstExtendedVariableLengthRecord;
-  LLAS_ULONG     numOfExtendedVariableLengthRecords;
-  LLAS_ULLONG    numOfPointRecords;
-  LLAS_ULLONG    numOfPointsByReturn[NUM_BYTES_NUM_OF_POINTS_BY_RETURN / sizeof(LLAS_ULLONG)];
+/// @brief Store 4 points as `[x0, y0, z0, x1, ..., z3]`
+inline void _storeInterleaved(float* out, const __m128& x, const __m128& y, const __m128& z) {
+  const __m128 xyLow = _mm_unpacklo_ps(x, y);                                  // x0 y0 x1 y1
+  const __m128 xyHigh = _mm_unpackhi_ps(x, y);                                 // x2 y2 x3 y3
+  const __m128 z0x1 = _mm_shuffle_ps(z, xyLow, _MM_SHUFFLE(2, 2, 0, 0));       // z0 z0 x1 x1
+  const __m128 y1z1 = _mm_shuffle_ps(xyLow, z, _MM_SHUFFLE(1, 1, 3, 3));       // y1 y1 z1 z1
+  const __m128 z2z3x3y3 = _mm_shuffle_ps(z, xyHigh, _MM_SHUFFLE(3, 2, 3, 2));  // z2 z3 x3 y3
+
+  _mm_storeu_ps(out + 0, _mm_shuffle_ps(xyLow, z0x1, _MM_SHUFFLE(2, 0, 1, 0)));         // x0 y0 z0 x1
+  _mm_storeu_ps(out + 4, _mm_shuffle_ps(y1z1, xyHigh, _MM_SHUFFLE(1, 0, 2, 0)));        // y1 z1 x2 y2
+  _mm_storeu_ps(out + 8, _mm_shuffle_ps(z2z3x3y3, z2z3x3y3, _MM_SHUFFLE(1, 3, 2, 0)));  // z2 x3 y3 z3
+}
+#endif
 
-  bool hasStartOfWaveformDataPacketRecord;
-  bool hasStartOfFirstExtendedVariableLengthRecord;
-  bool hasNumOfExtendedVariableLengthRecords;
-  bool hasNumOfPointRecords;
-  bool hasNumOfPointsByReturn;
-  // clang-format on
+/// @brief Transform integer coordinates into interleaved `[x0, y0, z0, x1, ...]` values computed as `v * scale + offset` in double precision
+/// @param x Integer x coordinates (`n` elements)
+/// @param y Integer y coordinates (`n` elements)
+/// @param z Integer z coordinates (`n` elements)
+/// @param n Number of points
+/// @param scale Scale factors
+/// @param offset Offsets
+/// @param coords Output (`3 * n` elements)
+inline void transformCoords(const LLAS_LONG* x, const LLAS_LONG* y, const LLAS_LONG* z, const size_t n,
+                            const math::vec3d_t& scale, const math::vec3d_t& offset,
+                            double* coords) {
+  size_t i = 0;
+
+#if defined(LLAS_SIMD_AVX)
+  {
+    const __m256d sx = _mm256_set1_pd(scale[0]), sy = _mm256_set1_pd(scale[1]), sz = _mm256_set1_pd(scale[2]);
+    const __m256d ox = _mm256_set1_pd(offset[0]), oy = _mm256_set1_pd(offset[1]), oz = _mm256_set1_pd(offset[2]);
 
-  static PublicHeader readPublicHeader(const std::vector<char>& fileBytes) {
-    PublicHeader publicHeader;
-    const char* data = fileBytes.data();
-    size_t offset = 0;
+    for (; i + 4 <= n; i += 4) {
+      const __m256d vx = _mm256_add_pd(_mm256_mul_pd(_mm256_cvtepi32_pd(_mm_loadu_si128((const __m128i*)(x + i))), sx), ox);
+      const __m256d vy = _mm256_add_pd(_mm256_mul_pd(_mm256_cvtepi32_pd(_mm_loadu_si128((const __m128i*)(y + i))), sy), oy);
+      const __m256d vz = _mm256_add_pd(_mm256_mul_pd(_mm256_cvtepi32_pd(_mm_loadu_si128((const __m128i*)(z + i))), sz), oz);
 
-    {
-      // File signature
-      const std::streamsize nBytes = PublicHeader::NUM_BYTES_FILE_SIGNATURE;
-      std::memcpy(&publicHeader.fileSignature, data + offset, nBytes);
-      offset += nBytes;
+      _storeInterleaved(coords + 3 * i, _mm256_castpd256_pd128(vx), _mm256_castpd256_pd128(vy), _mm256_castpd256_pd128(vz));
+      _storeInterleaved(coords + 3 * i + 6, _mm256_extractf128_pd(vx, 1), _mm256_extractf128_pd(vy, 1), _mm256_extractf128_pd(vz, 1));
     }
+  }
+#endif
 
-    {
-      // File source ID
-      const std::streamsize nBytes = PublicHeader::NUM_BYTES_FILE_SOURCE_ID;
-      std::memcpy(&publicHeader.fileSourceID, data + offset, nBytes);
-      offset += nBytes;
-    }
+#if defined(LLAS_SIMD_SSE2)
+  {
+    const __m128d sx = _mm_set1_pd(scale[0]), sy = _mm_set1_pd(scale[1]), sz = _mm_set1_pd(scale[2]);
+    const __m128d ox = _mm_set1_pd(offset[0]), oy = _mm_set1_pd(offset[1]), oz = _mm_set1_pd(offset[2]);
 
-    {
-      // Global encoding
-      const std::streamsize nBytes = PublicHeader::NUM_BYTES_GLOBAL_ENCODING;
-      std::memcpy(&publicHeader.globalEncoding, data + offset, nBytes);
-      offset += nBytes;
-    }
+    for (; i + 2 <= n; i += 2) {
+      const __m128d vx = _mm_add_pd(_mm_mul_pd(_mm_cvtepi32_pd(_mm_loadl_epi64((const __m128i*)(x + i))), sx), ox);
+      const __m128d vy = _mm_add_pd(_mm_mul_pd(_mm_cvtepi32_pd(_mm_loadl_epi64((const __m128i*)(y + i))), sy), oy);
+      const __m128d vz = _mm_add_pd(_mm_mul_pd(_mm_cvtepi32_pd(_mm_loadl_epi64((const __m128i*)(z + i))), sz), oz);
 
-    {
-      // Project ID-GUID Data 1
-      const std::streamsize nBytes = PublicHeader::NUM_BYTES_PROJECT_ID_1;
-      std::memcpy(&publicHeader.projectID1, data + offset, nBytes);
-      offset += nBytes;
+      _storeInterleaved(coords + 3 * i, vx, vy, vz);
     }
+  }
+#elif defined(LLAS_SIMD_NEON)
+  {
+    const float64x2_t sx = vdupq_n_f64(scale[0]), sy = vdupq_n_f64(scale[1]), sz = vdupq_n_f64(scale[2]);
+    const float64x2_t ox = vdupq_n_f64(offset[0]), oy = vdupq_n_f64(offset[1]), oz = vdupq_n_f64(offset[2]);
 
-    {
-      // Project ID-GUID Data 2
-      const std::streamsize nBytes = PublicHeader::NUM_BYTES_PROJECT_ID_2;
-      std::memcpy(&publicHeader.projectID2, data + offset, nBytes);
-      offset += nBytes;
-    }
+    for (; i + 2 <= n; i += 2) {
+      float64x2x3_t v;
+      v.val[0] = vaddq_f64(vmulq_f64(vcvtq_f64_s64(vmovl_s32(vld1_s32(x + i))), sx), ox);
+      v.val[1] = vaddq_f64(vmulq_f64(vcvtq_f64_s64(vmovl_s32(vld1_s32(y + i))), sy), oy);
+      v.val[2] = vaddq_f64(vmulq_f64(vcvtq_f64_s64(vmovl_s32(vld1_s32(z + i))), sz), oz);
 
-    {
-      // Project ID-GUID Data 3
-      const std::streamsize nBytes = PublicHeader::NUM_BYTES_PROJECT_ID_3;
-      std::memcpy(&publicHeader.projectID3, data + offset, nBytes);
-      offset += nBytes;
+      vst3q_f64(coords + 3 * i, v);
     }
+  }
+#endif
 
-    {
-      // Project ID-GUID Data 4
-      const std::streamsize nBytes = PublicHeader::NUM_BYTES_PROJECT_ID_4;
-      std::memcpy(&publicHeader.projectID4, data + offset, nBytes);
-      offset += nBytes;
-    }
+  for (; i < n; ++i) {
+    coords[3 * i + 0] = (double)x[i] * scale[0] + offset[0];
+    coords[3 * i + 1] = (double)y[i] * scale[1] + offset[1];
+    coords[3 * i + 2] = (double)z[i] * scale[2] + offset[2];
+  }
+}
 
-    {
-      // Version major
-      const std::streamsize nBytes = PublicHeader::NUM_BYTES_VERSION_MAJOR;
-      std::memcpy(&publicHeader.versionMajor, data + offset, nBytes);
-      offset += nBytes;
-    }
+/// @brief Transform integer coordinates into interleaved `[x0, y0, z0, x1, ...]` values computed as `v * scale + offset` in double precision and rounded to float
+/// @param x Integer x coordinates (`n` elements)
+/// @param y Integer y coordinates (`n` elements)
+/// @param z Integer z coordinates (`n` elements)
+/// @param n Number of points
+/// @param scale Scale factors
+/// @param offset Offsets
+/// @param coords Output (`3 * n` elements)
+inline void transformCoords(const LLAS_LONG* x, const LLAS_LONG* y, const LLAS_LONG* z, const size_t n,
+                            const math::vec3d_t& scale, const math::vec3d_t& offset,
+                            float* coords) {
+  size_t i = 0;
+
+#if defined(LLAS_SIMD_AVX)
+  {
+    const __m256d sx = _mm256_set1_pd(scale[0]), sy = _mm256_set1_pd(scale[1]), sz = _mm256_set1_pd(scale[2]);
+    const __m256d ox = _mm256_set1_pd(offset[0]), oy = _mm256_set1_pd(offset[1]), oz = _mm256_set1_pd(offset[2]);
 
-    {
-      // Version minor
-      const std::streamsize nBytes = PublicHeader::NUM_BYTES_VERSION_MINOR;
-      std::memcpy(&publicHeader.versionMinor, data + offset, nBytes);
-      offset += nBytes;
+    for (; i + 4 <= n; i += 4) {
+      const __m128 vx = _mm256_cvtpd_ps(_mm256_add_pd(_mm256_mul_pd(_mm256_cvtepi32_pd(_mm_loadu_si128((const __m128i*)(x + i))), sx), ox));
+      const __m128 vy = _mm256_cvtpd_ps(_mm256_add_pd(_mm256_mul_pd(_mm256_cvtepi32_pd(_mm_loadu_si128((const __m128i*)(y + i))), sy), oy));
+      const __m128 vz = _mm256_cvtpd_ps(_mm256_add_pd(_mm256_mul_pd(_mm256_cvtepi32_pd(_mm_loadu_si128((const __m128i*)(z + i))), sz), oz));
 
-      if (publicHeader.versionMinor >= 3) {
-        publicHeader.hasStartOfWaveformDataPacketRecord = true;
-      }
-
-      if (publicHeader.versionMinor >= 4) {
-        publicHeader.hasStartOfFirstExtendedVariableLengthRecord = true;
-        publicHeader.hasNumOfExtendedVariableLengthRecords = true;
-        publicHeader.hasNumOfPointRecords = true;
-        publicHeader.hasNumOfPointsByReturn = true;
-      }
+      _storeInterleaved(coords + 3 * i, vx, vy, vz);
     }
-
-    {
-      // System Identifier
-      const std::streamsize nBytes = PublicHeader::NUM_BYTES_SYSTEM_IDENTIFIER;
-      std::memcpy(&publicHeader.systemIdentifier, data + offset, nBytes);
-      offset += nBytes;
+  }
+#elif defined(LLAS_SIMD_SSE2)
+  {
+    const __m128d sx = _mm_set1_pd(scale[0]), sy = _mm_set1_pd(scale[1]), sz = _mm_set1_pd(scale[2]);
+    const __m128d ox = _mm_set1_pd(offset[0]), oy = _mm_set1_pd(offset[1]), oz = _mm_set1_pd(offset[2]);
+
+    // NOTE: Convert 4 integers to 4 floats through 2 + 2 doubles
+    const auto transform = [](const LLAS_LONG* v, const __m128d& s, const __m128d& o) {
+      const __m128i vi = _mm_loadu_si128((const __m128i*)v);
+      const __m128d low = _mm_add_pd(_mm_mul_pd(_mm_cvtepi32_pd(vi), s), o);
+      const __m128d high = _mm_add_pd(_mm_mul_pd(_mm_cvtepi32_pd(_mm_shuffle_epi32(vi, _MM_SHUFFLE(1, 0, 3, 2))), s), o);
+      return _mm_movelh_ps(_mm_cvtpd_ps(low), _mm_cvtpd_ps(high));
+    };
+
+    for (; i + 4 <= n; i += 4) {
+      _storeInterleaved(coords + 3 * i, transform(x + i, sx, ox), transform(y + i, sy, oy), transform(z + i, sz, oz));
     }
-
-    {
-      // Generating Software
-      const std::streamsize nBytes = PublicHeader::NUM_BYTES_GENERATING_SOFTWARE;
-      std::memcpy(&publicHeader.generatingSoftware, data + offset, nBytes);
-      offset += nBytes;
+  }
+#elif defined(LLAS_SIMD_NEON)
+  {
+    const float64x2_t sx = vdupq_n_f64(scale[0]), sy = vdupq_n_f64(scale[1]), sz = vdupq_n_f64(scale[2]);
+    const float64x2_t ox = vdupq_n_f64(offset[0]), oy = vdupq_n_f64(offset[1]), oz = vdupq_n_f64(offset[2]);
+
+    // NOTE: Convert 4 integers to 4 floats through 2 + 2 doubles
+    const auto transform = [](const LLAS_LONG* v, const float64x2_t& s, const float64x2_t& o) {
+      const int32x4_t vi = vld1q_s32(v);
+      const float64x2_t low = vaddq_f64(vmulq_f64(vcvtq_f64_s64(vmovl_s32(vget_low_s32(vi))), s), o);
+      const float64x2_t high = vaddq_f64(vmulq_f64(vcvtq_f64_s64(vmovl_high_s32(vi)), s), o);
+      return vcvt_high_f32_f64(vcvt_f32_f64(low), high);
+    };
+
+    for (; i + 4 <= n; i += 4) {
+      float32x4x3_t v;
+      v.val[0] = transform(x + i, sx, ox);
+      v.val[1] = transform(y + i, sy, oy);
+      v.val[2] = transform(z + i, sz, oz);
+
+      vst3q_f32(coords + 3 * i, v);
     }
+  }
+#endif
 
-    {
-      // File Creation Day of Year
-      const std::streamsize nBytes = PublicHeader::NUM_BYTES_FILE_CREATION_DAY_OF_YEAR;
-      std::memcpy(&publicHeader.fileCreationDayOfYear, data + offset, nBytes);
-      offset += nBytes;
-    }
+  for (; i < n; ++i) {
+    coords[3 * i + 0] = (float)((double)x[i] * scale[0] + offset[0]);
+    coords[3 * i + 1] = (float)((double)y[i] * scale[1] + offset[1]);
+    coords[3 * i + 2] = (float)((double)z[i] * scale[2] + offset[2]);
+  }
+}
 
-    {
-      // File Creation Year
-      const std::streamsize nBytes = PublicHeader::NUM_BYTES_FILE_CREATION_YEAR;
-      std::memcpy(&publicHeader.fileCreationYear, data + offset, nBytes);
-      offset += nBytes;
+/// @brief Re-quantize integer coordinates as `round(v * scale + offset)`, e.g. from the scale factor and the offset of one file into those of another
+/// @param v Integer coordinates (`n` elements)
+/// @param n Number of coordinates
+/// @param scale Ratio of the source scale factor to the target one
+/// @param offset Difference of the source offset and the target one in units of the target scale factor
+/// @param out Output (`n` elements), which may be `v`
+/// @return `true` if all the coordinates fit into 32 bits. Others are clamped.
+inline bool requantizeCoords(const LLAS_LONG* v, const size_t n,
+                             const double scale, const double offset,
+                             LLAS_LONG* out) {
+  size_t i = 0;
+  bool isInRange = true;
+
+  const double minValue = (double)std::numeric_limits<LLAS_LONG>::min();
+  const double maxValue = (double)std::numeric_limits<LLAS_LONG>::max();
+
+  // NOTE: The vector conversions round to nearest even like `std::nearbyint` in the default rounding mode
+#if defined(LLAS_SIMD_AVX)
+  {
+    const __m256d s = _mm256_set1_pd(scale), o = _mm256_set1_pd(offset);
+    const __m256d lower = _mm256_set1_pd(minValue), upper = _mm256_set1_pd(maxValue);
+    __m256d outOfRange = _mm256_setzero_pd();
+
+    for (; i + 4 <= n; i += 4) {
+      const __m256d x = _mm256_add_pd(_mm256_mul_pd(_mm256_cvtepi32_pd(_mm_loadu_si128((const __m128i*)(v + i))), s), o);
+      outOfRange = _mm256_or_pd(outOfRange, _mm256_or_pd(_mm256_cmp_pd(x, lower, _CMP_LT_OQ), _mm256_cmp_pd(x, upper, _CMP_GT_OQ)));
+      _mm_storeu_si128((__m128i*)(out + i), _mm256_cvtpd_epi32(_mm256_min_pd(_mm256_max_pd(x, lower), upper)));
     }
+    isInRange = _mm256_movemask_pd(outOfRange) == 0;
+  }
+#endif
 
-    {
-      // Header size
-      const std::streamsize nBytes = PublicHeader::NUM_BYTES_HEADER_SIZE;
-      std::memcpy(&publicHeader.headerSize, data + offset, nBytes);
-      offset += nBytes;
+#if defined(LLAS_SIMD_SSE2)
+  {
+    const __m128d s = _mm_set1_pd(scale), o = _mm_set1_pd(offset);
+    const __m128d lower = _mm_set1_pd(minValue), upper = _mm_set1_pd(maxValue);
+    __m128d outOfRange = _mm_setzero_pd();
+
+    for (; i + 2 <= n; i += 2) {
+      const __m128d x = _mm_add_pd(_mm_mul_pd(_mm_cvtepi32_pd(_mm_loadl_epi64((const __m128i*)(v + i))), s), o);
+      outOfRange = _mm_or_pd(outOfRange, _mm_or_pd(_mm_cmplt_pd(x, lower), _mm_cmpgt_pd(x, upper)));
+      _mm_storel_epi64((__m128i*)(out + i), _mm_cvtpd_epi32(_mm_min_pd(_mm_max_pd(x, lower), upper)));
     }
-
-    {
-      // Offset to point data
-      const std::streamsize nBytes = PublicHeader::NUM_BYTES_OFFSET_TO_POINT_DATA;
-      std::memcpy(&publicHeader.offsetToPointData, data + offset, nBytes);
-      offset += nBytes;
+    isInRange = isInRange && _mm_movemask_pd(outOfRange) == 0;
+  }
+#elif defined(LLAS_SIMD_NEON)
+  {
+    const float64x2_t s = vdupq_n_f64(scale), o = vdupq_n_f64(offset);
+    const float64x2_t lower = vdupq_n_f64(minValue), upper = vdupq_n_f64(maxValue);
+    uint64x2_t outOfRange = vdupq_n_u64(0);
+
+    for (; i + 2 <= n; i += 2) {
+      const float64x2_t x = vaddq_f64(vmulq_f64(vcvtq_f64_s64(vmovl_s32(vld1_s32(v + i))), s), o);
+      outOfRange = vorrq_u64(outOfRange, vorrq_u64(vcltq_f64(x, lower), vcgtq_f64(x, upper)));
+      vst1_s32(out + i, vmovn_s64(vcvtnq_s64_f64(vminq_f64(vmaxq_f64(x, lower), upper))));
     }
+    isInRange = (vgetq_lane_u64(outOfRange, 0) | vgetq_lane_u64(outOfRange, 1)) == 0;
+  }
+#endif
 
-    {
-      // Number of Variable Length Records
-      const std::streamsize nBytes = PublicHeader::NUM_BYTES_NUM_OF_VARIABLE_LENGTH_RECORDS;
-      std::memcpy(&publicHeader.numOfVariableLengthRecords, data + offset, nBytes);
-      offset += nBytes;
+  for (; i < n; ++i) {
+    const double x = (double)v[i] * scale + offset;
+    if (x < minValue || maxValue < x) {
+      isInRange = false;
     }
+    out[i] = (LLAS_LONG)std::nearbyint(std::min(std::max(x, minValue), maxValue));
+  }
 
-    {
-      // Point Data Record Format
-      const std::streamsize nBytes = PublicHeader::NUM_BYTES_POINT_DATA_RECORD_FORMAT;
-      std::memcpy(&publicHeader.pointDataRecordFormat, data + offset, nBytes);
-      offset += nBytes;
-    }
+  return isInRange;
+}
 
-    {
-      // Point Data Record Length
-      const std::streamsize nBytes = PublicHeader::NUM_BYTES_POINT_DATA_RECORD_LENGTH;
-      std::memcpy(&publicHeader.pointDataRecordLength, data + offset, nBytes);
-      offset += nBytes;
-    }
+/// @brief Convert 16-bit color channels into interleaved 8-bit `[r0, g0, b0, (a0,) r1, ...]` colors
+/// @param r Red channel (`n` elements)
+/// @param g Green channel (`n` elements)
+/// @param b Blue channel (`n` elements)
+/// @param n Number of points
+/// @param is8Bit The channels hold 8-bit values, which are clamped to 255. Otherwise they are scaled as `floor(v * 255 / 65535)`.
+/// @param hasAlpha Write a fourth channel of 255
+/// @param colors Output (`3 * n` or `4 * n` elements)
+inline void convertColors(const LLAS_USHORT* r, const LLAS_USHORT* g, const LLAS_USHORT* b, const size_t n,
+                          const bool is8Bit, const bool hasAlpha,
+                          unsigned char* colors) {
+  size_t i = 0;
+
+#if defined(LLAS_SIMD_SSE2)
+  {
+    const __m128i max8Bit = _mm_set1_epi16(255);
+    const __m128i alpha = _mm_set1_epi8((char)0xFF);
+
+    // NOTE: `(v - (v >> 8)) >> 8` equals `floor(v * 255 / 65535)` for every 16-bit value, and `v - max(v - 255, 0)` is `min(v, 255)`
+    const auto convert = [&](const LLAS_USHORT* v) {
+      const __m128i vi = _mm_loadu_si128((const __m128i*)v);
+      const __m128i c = is8Bit ? _mm_subs_epu16(vi, _mm_subs_epu16(vi, max8Bit)) : _mm_srli_epi16(_mm_sub_epi16(vi, _mm_srli_epi16(vi, 8)), 8);
+      return _mm_packus_epi16(c, c);
+    };
+
+#if defined(LLAS_SIMD_SSSE3)
+    const __m128i dropAlpha = _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+    const auto storeRGB = [&](unsigned char* out, const __m128i& rgba) {
+      const __m128i rgb = _mm_shuffle_epi8(rgba, dropAlpha);
+      const int last = _mm_cvtsi128_si32(_mm_srli_si128(rgb, 8));
+      _mm_storel_epi64((__m128i*)out, rgb);
+      std::memcpy(out + 8, &last, 4);
+    };
+    const bool isVectorized = true;
+#else
+    // NOTE: SSE2 has no byte shuffle to drop the alpha channel, so RGB is converted by the scalar loop
+    const bool isVectorized = hasAlpha;
+#endif
 
-    {
-      // Legacy Number of Point Records
-      const std::streamsize nBytes = PublicHeader::NUM_BYTES_LEGACY_NUM_OF_POINT_RECORDS;
-      std::memcpy(&publicHeader.legacyNumOfPointRecords, data + offset, nBytes);
-      offset += nBytes;
-    }
+    for (; isVectorized && i + 8 <= n; i += 8) {
+      const __m128i rg = _mm_unpacklo_epi8(convert(r + i), convert(g + i));  // r0 g0 r1 g1 ...
+      const __m128i ba = _mm_unpacklo_epi8(convert(b + i), alpha);           // b0 a0 b1 a1 ...
+      const __m128i rgbaLow = _mm_unpacklo_epi16(rg, ba);                    // points 0 to 3
+      const __m128i rgbaHigh = _mm_unpackhi_epi16(rg, ba);                   // points 4 to 7
 
-    {
-      // Legacy Number of Point by Return
-      const std::streamsize nBytes = PublicHeader::NUM_BYTES_LEGACY_NUM_OF_POINT_BY_RETURN;
-      std::memcpy(&publicHeader.legacyNumOfPointByReturn, data + offset, nBytes);
-      offset += nBytes;
+      if (hasAlpha) {
+        _mm_storeu_si128((__m128i*)(colors + 4 * i), rgbaLow);
+        _mm_storeu_si128((__m128i*)(colors + 4 * i + 16), rgbaHigh);
+      } else {
+#if defined(LLAS_SIMD_SSSE3)
+        storeRGB(colors + 3 * i, rgbaLow);
+        storeRGB(colors + 3 * i + 12, rgbaHigh);
+#endif
+      }
     }
-
-    {
-      // X Scale Factor
-      const std::streamsize nBytes = PublicHeader::NUM_BYTES_X_SCALE_FACTOR;
-      std::memcpy(&publicHeader.xScaleFactor, data + offset, nBytes);
-      offset += nBytes;
+  }
+#elif defined(LLAS_SIMD_NEON)
+  {
+    const uint16x8_t max8Bit = vdupq_n_u16(255);
+    const auto convert = [&](const LLAS_USHORT* v) {
+      const uint16x8_t vi = vld1q_u16(v);
+      return vmovn_u16(is8Bit ? vminq_u16(vi, max8Bit) : vshrq_n_u16(vsubq_u16(vi, vshrq_n_u16(vi, 8)), 8));
+    };
+
+    for (; i + 8 <= n; i += 8) {
+      if (hasAlpha) {
+        uint8x8x4_t v;
+        v.val[0] = convert(r + i);
+        v.val[1] = convert(g + i);
+        v.val[2] = convert(b + i);
+        v.val[3] = vdup_n_u8(255);
+        vst4_u8(colors + 4 * i, v);
+      } else {
+        uint8x8x3_t v;
+        v.val[0] = convert(r + i);
+        v.val[1] = convert(g + i);
+        v.val[2] = convert(b + i);
+        vst3_u8(colors + 3 * i, v);
+      }
     }
+  }
+#endif
 
-    {
-      // Y Scale Factor
-      const std::streamsize nBytes = PublicHeader::NUM_BYTES_Y_SCALE_FACTOR;
-      std::memcpy(&publicHeader.yScaleFactor, data + offset, nBytes);
-      offset += nBytes;
-    }
+  const auto convert = [is8Bit](const LLAS_USHORT v) {
+    return is8Bit ? (unsigned char)std::min<LLAS_USHORT>(v, 255) : (unsigned char)((v - (v >> 8)) >> 8);
+  };
 
-    {
-      // Z Scale Factor
-      const std::streamsize nBytes = PublicHeader::NUM_BYTES_Z_SCALE_FACTOR;
-      std::memcpy(&publicHeader.zScaleFactor, data + offset, nBytes);
-      offset += nBytes;
+  const size_t nChannels = hasAlpha ? 4 : 3;
+  for (; i < n; ++i) {
+    unsigned char* color = colors + nChannels * i;
+    color[0] = convert(r[i]);
+    color[1] = convert(g[i]);
+    color[2] = convert(b[i]);
+    if (hasAlpha) {
+      color[3] = 255;
     }
+  }
+}
 
-    {
-      // X Offset
-      const std::streamsize nBytes = PublicHeader::NUM_BYTES_X_OFFSET;
-      std::memcpy(&publicHeader.xOffset, data + offset, nBytes);
-      offset += nBytes;
-    }
+/// @brief Convert 16-bit color channels into interleaved `[r0, g0, b0, r1, ...]` colors normalized to `[0, 1]`
+/// @param r Red channel (`n` elements)
+/// @param g Green channel (`n` elements)
+/// @param b Blue channel (`n` elements)
+/// @param n Number of points
+/// @param is8Bit The channels hold 8-bit values, which are clamped to 255 and divided by 255. Otherwise they are divided by 65535.
+/// @param colors Output (`3 * n` elements)
+inline void convertColors(const LLAS_USHORT* r, const LLAS_USHORT* g, const LLAS_USHORT* b, const size_t n,
+                          const bool is8Bit,
+                          float* colors) {
+  size_t i = 0;
+
+  const LLAS_USHORT maxValue = is8Bit ? 255 : 65535;
+  const float scale = 1.0f / (float)maxValue;
+
+#if defined(LLAS_SIMD_SSE2)
+  {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i vMax = _mm_set1_epi16((short)maxValue);
+    const __m128 vScale = _mm_set1_ps(scale);
 
-    {
-      // Y Offset
-      const std::streamsize nBytes = PublicHeader::NUM_BYTES_Y_OFFSET;
-      std::memcpy(&publicHeader.yOffset, data + offset, nBytes);
-      offset += nBytes;
-    }
+    const auto load = [&](const LLAS_USHORT* v) {
+      const __m128i vi = _mm_loadu_si128((const __m128i*)v);
+      return _mm_subs_epu16(vi, _mm_subs_epu16(vi, vMax));
+    };
+    const auto toFloat = [&](const __m128i& v) { return _mm_mul_ps(_mm_cvtepi32_ps(v), vScale); };
 
-    {
-      // Z Offset
-      const std::streamsize nBytes = PublicHeader::NUM_BYTES_Z_OFFSET;
-      std::memcpy(&publicHeader.zOffset, data + offset, nBytes);
-      offset += nBytes;
-    }
+    for (; i + 8 <= n; i += 8) {
+      const __m128i vr = load(r + i), vg = load(g + i), vb = load(b + i);
 
-    {
-      // Max X
-      const std::streamsize nBytes = PublicHeader::NUM_BYTES_MAX_X;
-      std::memcpy(&publicHeader.maxX, data + offset, nBytes);
-      offset += nBytes;
+      _storeInterleaved(colors + 3 * i, toFloat(_mm_unpacklo_epi16(vr, zero)), toFloat(_mm_unpacklo_epi16(vg, zero)), toFloat(_mm_unpacklo_epi16(vb, zero)));
+      _storeInterleaved(colors + 3 * i + 12, toFloat(_mm_unpackhi_epi16(vr, zero)), toFloat(_mm_unpackhi_epi16(vg, zero)), toFloat(_mm_unpackhi_epi16(vb, zero)));
     }
+  }
+#elif defined(LLAS_SIMD_NEON)
+  {
+    const uint16x4_t vMax = vdup_n_u16(maxValue);
+    const auto toFloat = [&](const LLAS_USHORT* v) { return vmulq_n_f32(vcvtq_f32_u32(vmovl_u16(vmin_u16(vld1_u16(v), vMax))), scale); };
 
-    {
-      // Min X
-      const std::streamsize nBytes = PublicHeader::NUM_BYTES_MIN_X;
-      std::memcpy(&publicHeader.minX, data + offset, nBytes);
-      offset += nBytes;
-    }
+    for (; i + 4 <= n; i += 4) {
+      float32x4x3_t v;
+      v.val[0] = toFloat(r + i);
+      v.val[1] = toFloat(g + i);
+      v.val[2] = toFloat(b + i);
 
-    {
-      // Max Y
-      const std::streamsize nBytes = PublicHeader::NUM_BYTES_MAX_Y;
-      std::memcpy(&publicHeader.maxY, data + offset, nBytes);
-      offset += nBytes;
+      vst3q_f32(colors + 3 * i, v);
     }
+  }
+#endif
 
-    {
-      // Min Y
-      const std::streamsize nBytes = PublicHeader::NUM_BYTES_MIN_Y;
-      std::memcpy(&publicHeader.minY, data + offset, nBytes);
-      offset += nBytes;
-    }
+  for (; i < n; ++i) {
+    colors[3 * i + 0] = (float)std::min(r[i], maxValue) * scale;
+    colors[3 * i + 1] = (float)std::min(g[i], maxValue) * scale;
+    colors[3 * i + 2] = (float)std::min(b[i], maxValue) * scale;
+  }
+}
+}  // namespace simd
 
-    {
-      // Max Z
-      const std::streamsize nBytes = PublicHeader::NUM_BYTES_MAX_Z;
-      std::memcpy(&publicHeader.maxZ, data + offset, nBytes);
-      offset += nBytes;
-    }
+// ==========================================================================
+// File I/O
+// ==========================================================================
+namespace io {
+/// @brief Read-only memory mapping of a whole file.
+///        Backed by `mmap` on POSIX and `MapViewOfFile` on Windows, so that the readers can parse the file in place without copying it to the heap.
+class MappedFile {
+ public:
+  MappedFile()
+      : _data(nullptr),
+        _size(0)
+#if defined(_WIN32)
+        ,
+        _fileHandle(INVALID_HANDLE_VALUE),
+        _mappingHandle(nullptr)
+#endif
+  {
+  }
 
-    {
-      // Min Z
-      const std::streamsize nBytes = PublicHeader::NUM_BYTES_MIN_Z;
-      std::memcpy(&publicHeader.minZ, data + offset, nBytes);
-      offset += nBytes;
+  ~MappedFile() {
+    close();
+  }
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  /// @brief Map the whole file into memory
+  /// @param filePath Path to the file
+  /// @return `true` if the file was mapped
+  inline bool open(const std::string& filePath) {
+    close();
+
+#if defined(_WIN32)
+    _fileHandle = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (_fileHandle == INVALID_HANDLE_VALUE) {
+      return false;
     }
 
-    if (publicHeader.hasStartOfWaveformDataPacketRecord) {
-      // Start of Waveform Data Packet Record
-      const std::streamsize nBytes = PublicHeader::NUM_BYTES_START_OF_WAVEFORM_DATA_PACKET_RECORD;
-      std::memcpy(&publicHeader.startOfWaveformDataPacketRecord, data + offset, nBytes);
-      offset += nBytes;
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(_fileHandle, &fileSize) || fileSize.QuadPart <= 0) {
+      close();
+      return false;
     }
 
-    if (publicHeader.hasStartOfFirstExtendedVariableLengthRecord) {
-      // Start of First Extended Variable Length Record
-      const std::streamsize nBytes = PublicHeader::NUM_BYTES_START_OF_FIRST_EXTENDED_VARIABLE_LENGTH_RECORD;
-      std::memcpy(&publicHeader.startOfFirstExtendedVariableLengthRecord, data + offset, nBytes);
-      offset += nBytes;
+    _mappingHandle = CreateFileMappingA(_fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (_mappingHandle == nullptr) {
+      close();
+      return false;
     }
 
-    if (publicHeader.hasNumOfExtendedVariableLengthRecords) {
-      // Number of Extended Variable Length Records
-      const std::streamsize nBytes = PublicHeader::NUM_BYTES_NUM_OF_EXTENDED_VARIABLE_LENGTH_RECORDS;
-      std::memcpy(&publicHeader.numOfExtendedVariableLengthRecords, data + offset, nBytes);
-      offset += nBytes;
+    void* view = MapViewOfFile(_mappingHandle, FILE_MAP_READ, 0, 0, 0);
+    if (view == nullptr) {
+      close();
+      return false;
     }
 
-    if (publicHeader.hasNumOfPointRecords) {
-      // Number of Point Records
-      const std::streamsize nBytes = PublicHeader::NUM_BYTES_NUM_OF_POINT_RECORDS;
-      std::memcpy(&publicHeader.numOfPointRecords, data + offset, nBytes);
-      offset += nBytes;
+    _data = static_cast<const char*>(view);
+    _size = (size_t)fileSize.QuadPart;
+#else
+    const int fileDescriptor = ::open(filePath.c_str(), O_RDONLY);
+    if (fileDescriptor < 0) {
+      return false;
     }
 
-    if (publicHeader.hasNumOfPointsByReturn) {
-      // Number of Points by Return
-      const std::streamsize nBytes = PublicHeader::NUM_BYTES_NUM_OF_POINTS_BY_RETURN;
-      std::memcpy(&publicHeader.numOfPointsByReturn, data + offset, nBytes);
-      offset += nBytes;
+    struct stat fileStat;
+    if (::fstat(fileDescriptor, &fileStat) != 0 || fileStat.st_size <= 0) {
+      ::close(fileDescriptor);
+      return false;
     }
 
-    return publicHeader;
-  };
-};
+    void* view = ::mmap(nullptr, (size_t)fileStat.st_size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
 
-struct VariableLengthRecord {
-  // clang-format off
-  inline static const std::streamsize NUM_BYTES_RESERVED                                            = 2;
-  inline static const std::streamsize NUM_BYTES_USER_ID                                             = 16;
-  inline static const std::streamsize NUM_BYTES_RECORD_ID                                           = 2;
-  inline static const std::streamsize NUM_BYTES_RECORD_LENGTH_AFTER_HEADER                          = 2;
-  inline static const std::streamsize NUM_BYTES_DESCPIPTION                                         = 32;
-  // clang-format on
+    // NOTE: The mapping stays valid after the descriptor is closed
+    ::close(fileDescriptor);
 
-  VariableLengthRecord()
-      : reserved(),
-        userID(),
-        recordID(),
-        recordLengthAfterHeader(),
-        description(),
-        record() {}
+    if (view == MAP_FAILED) {
+      return false;
+    }
 
-  // clang-format off
-  LLAS_UCHAR        reserved;
-  LLAS_CHAR         userID[NUM_BYTES_USER_ID + 1];          // plus null-termination
-  LLAS_USHORT       recordID;
-  LLAS_USHORT       recordLengthAfterHeader;
-  LLAS_CHAR         description[NUM_BYTES_DESCPIPTION + 1]; // plus null-termination
-  std::vector<char> record;
-  // clang-format on
+    _data = static_cast<const char*>(view);
+    _size = (size_t)fileStat.st_size;
+#endif
 
-  static VariableLengthRecord readVariableLengthRecord(const std::vector<char>& fileBytes,
-                                                       std::streamsize& offset) {
-    VariableLengthRecord vlr;
+    return true;
+  }
 
-    {
-      // Reserved
-      const std::streamsize nBytes = VariableLengthRecord::NUM_BYTES_RESERVED;
-      std::memcpy(&vlr.reserved, fileBytes.data() + offset, nBytes);
-      offset += nBytes;
+  /// @brief Unmap the file
+  inline void close() {
+#if defined(_WIN32)
+    if (_data != nullptr) {
+      UnmapViewOfFile(_data);
     }
-
-    {
-      // User ID
-      const std::streamsize nBytes = VariableLengthRecord::NUM_BYTES_USER_ID;
-      std::memcpy(&vlr.userID, fileBytes.data() + offset, nBytes);
-      offset += nBytes;
+    if (_mappingHandle != nullptr) {
+      CloseHandle(_mappingHandle);
+      _mappingHandle = nullptr;
     }
-
-    {
-      // Record ID
-      const std::streamsize nBytes = VariableLengthRecord::NUM_BYTES_RECORD_ID;
-      std::memcpy(&vlr.recordID, fileBytes.data() + offset, nBytes);
-      offset += nBytes;
+    if (_fileHandle != INVALID_HANDLE_VALUE) {
+      CloseHandle(_fileHandle);
+      _fileHandle = INVALID_HANDLE_VALUE;
     }
-
-    {
-      // Record Length After Header
-      const std::streamsize nBytes = VariableLengthRecord::NUM_BYTES_RECORD_LENGTH_AFTER_HEADER;
-      std::memcpy(&vlr.recordLengthAfterHeader, fileBytes.data() + offset, nBytes);
-      offset += nBytes;
+#else
+    if (_data != nullptr) {
+      ::munmap(const_cast<char*>(_data), _size);
     }
+#endif
+    _data = nullptr;
+    _size = 0;
+  }
 
-    {
-      // Description
-      const std::streamsize nBytes = VariableLengthRecord::NUM_BYTES_DESCPIPTION;
-      std::memcpy(&vlr.description, fileBytes.data() + offset, nBytes);
-      offset += nBytes;
-    }
+  inline bool isOpen() const {
+    return _data != nullptr;
+  }
 
-    if (vlr.recordLengthAfterHeader <= 65535) {
-      // Record
-      const std::streamsize nBytes = (std::streamsize)vlr.recordLengthAfterHeader;
-      vlr.record.resize(nBytes);
-      vlr.record.assign(fileBytes.begin() + offset, fileBytes.begin() + offset + nBytes);
-      offset += nBytes;
-    } else {
-      _LLAS_logError("Exceed the payload limit of variable length record: " << vlr.recordLengthAfterHeader);
-    }
+  inline const char* data() const {
+    return _data;
+  }
 
-    return vlr;
+  inline size_t size() const {
+    return _size;
   }
+
+ private:
+  const char* _data;
+  size_t _size;
+#if defined(_WIN32)
+  HANDLE _fileHandle;
+  HANDLE _mappingHandle;
+#endif
 };
 
-struct PointDataRecord {
+/// @brief Read the whole file into `fileBytes`
+/// @param filePath Path to the file
+/// @param fileBytes Output buffer
+/// @return `true` if the file was read
+LLAS_FUNC_DECL_PREFIX bool readFileBytes(const std::string& filePath,
+                                         std::vector<char>& fileBytes) {
+  std::ifstream file = std::ifstream(filePath, std::ios::binary);
+  if (!file) {
+    return false;
+  }
+
+  file.seekg(0, std::ios::end);
+  std::streampos fileSize = file.tellg();
+  file.seekg(0, std::ios::beg);
+
+  fileBytes.resize(fileSize);
+  file.read(fileBytes.data(), fileSize);
+
+  file.close();
+
+  return true;
+}
+
+/// @brief Modification time and size of a file, which change when the file is rewritten
+struct FileStamp {
+  FileStamp()
+      : modificationTime(),
+        size() {}
+
   // clang-format off
-  inline static const std::streamsize NUM_BYTES_X                                                   = 4;
-  inline static const std::streamsize NUM_BYTES_Y                                                   = 4;
-  inline static const std::streamsize NUM_BYTES_Z                                                   = 4;
-  inline static const std::streamsize NUM_BYTES_INTENSITY                                           = 2;
-  inline static const std::streamsize NUM_BYTES_SENSOR_DATA                                         = 1;
-  inline static const std::streamsize NUM_BYTES_CLASSIFICATION                                      = 1;
-  inline static const std::streamsize NUM_BYTES_SCAN_ANGLE_RANK                                     = 1;
-  inline static const std::streamsize NUM_BYTES_USER_DATA                                           = 1;
-  inline static const std::streamsize NUM_BYTES_POINT_SOURCE_ID                                     = 2;
-  inline static const std::streamsize NUM_BYTES_GPS_TIME                                            = 8;
-  inline static const std::streamsize NUM_BYTES_RED                                                 = 2;
-  inline static const std::streamsize NUM_BYTES_GREEN                                               = 2;
-  inline static const std::streamsize NUM_BYTES_BLUE                                                = 2;
+  LLAS_LLONG  modificationTime;  // Nanoseconds since the epoch on POSIX, 100 nanosecond intervals since 1601 on Windows
+  LLAS_ULLONG size;              // Bytes
   // clang-format on
 
-  PointDataRecord()
-      : x(),
-        y(),
-        z(),
-        intensity(),
-        classification(),
-        scanAngleRank(),
-        userData(),
-        pointSourceID(),
-        GPSTime(),
-        red(),
-        green(),
-        blue() {
+  inline bool operator==(const FileStamp& other) const {
+    return modificationTime == other.modificationTime && size == other.size;
+  }
+
+  inline bool operator!=(const FileStamp& other) const {
+    return !(*this == other);
+  }
+};
+
+/// @brief Get the modification time and the size of a file without opening it
+/// @param filePath Path to the file
+/// @param fileStamp Output stamp
+/// @return `true` if the file exists
+LLAS_FUNC_DECL_PREFIX bool getFileStamp(const std::string& filePath,
+                                        FileStamp& fileStamp) {
+#if defined(_WIN32)
+  WIN32_FILE_ATTRIBUTE_DATA attributes;
+  if (!GetFileAttributesExA(filePath.c_str(), GetFileExInfoStandard, &attributes)) {
+    return false;
   }
 
+  fileStamp.modificationTime = (LLAS_LLONG)(((LLAS_ULLONG)attributes.ftLastWriteTime.dwHighDateTime << 32) | attributes.ftLastWriteTime.dwLowDateTime);
+  fileStamp.size = ((LLAS_ULLONG)attributes.nFileSizeHigh << 32) | attributes.nFileSizeLow;
+#else
+  struct stat fileStat;
+  if (::stat(filePath.c_str(), &fileStat) != 0) {
+    return false;
+  }
+
+#if defined(__APPLE__)
+  const struct timespec& modificationTime = fileStat.st_mtimespec;
+#else
+  const struct timespec& modificationTime = fileStat.st_mtim;
+#endif
+  fileStamp.modificationTime = (LLAS_LLONG)modificationTime.tv_sec * 1000000000 + (LLAS_LLONG)modificationTime.tv_nsec;
+  fileStamp.size = (LLAS_ULLONG)fileStat.st_size;
+#endif
+
+  return true;
+}
+
+/// @brief Random access to the bytes of a las file, e.g. a local file, a memory mapping or range requests to object storage
+class ByteSource {
+ public:
   // clang-format off
-  LLAS_LONG      x;
-  LLAS_LONG      y;
-  LLAS_LONG      z;
-  LLAS_USHORT    intensity;
-  LLAS_UCHAR     classification;
-  LLAS_SCHAR     scanAngleRank;
-  LLAS_UCHAR     userData;
-  LLAS_USHORT    pointSourceID;
-  LLAS_DOUBLE    GPSTime;
-  LLAS_USHORT    red;
-  LLAS_USHORT    green;
-  LLAS_USHORT    blue;
+  // NOTE: Large reads are split so that they are fetched concurrently
+  inline static const size_t         MAX_REQUEST_SIZE                                               = (size_t)8 << 20;
+  // NOTE: Byte ranges closer than this are fetched in one request since an extra request costs more than the bytes between them
+  inline static const size_t         MAX_REQUEST_GAP                                                = (size_t)64 << 10;
   // clang-format on
 
-  static PointDataRecord _readPointDataRecordFotmat0to4(const char* byteData,
-                                                        std::streamsize& offset,
-                                                        const LLAS_UCHAR& format) {
-    PointDataRecord pointDataRecord;
+  virtual ~ByteSource() {}
 
-    {
-      // X
-      const std::streamsize nBytes = PointDataRecord::NUM_BYTES_X;
-      std::memcpy(&pointDataRecord.x, byteData + offset, nBytes);
-      offset += nBytes;
+  /// @brief Get the size of the file in bytes
+  virtual LLAS_ULLONG size() const = 0;
+
+  /// @brief Copy `nBytes` bytes at `offset` into `data`. May be called from several threads at once.
+  /// @return `true` if all the bytes were read
+  virtual bool read(const LLAS_ULLONG offset,
+                    const size_t nBytes,
+                    char* data) const = 0;
+
+  /// @brief Get the bytes of the whole file if they are in memory, which are then parsed in place
+  /// @return `data` (`const char*`): `nullptr` if the bytes have to be read with `read`
+  virtual const char* data() const {
+    return nullptr;
+  }
+
+  /// @brief Read `nBytes` bytes at `offset` into `bytes`, which is resized
+  /// @return `true` if all the bytes were read
+  inline bool readBytes(const LLAS_ULLONG offset,
+                        const size_t nBytes,
+                        std::vector<char>& bytes) const {
+    if (offset > size() || nBytes > size() - offset) {
+      return false;
     }
 
-    {
-      // Y
-      const std::streamsize nBytes = PointDataRecord::NUM_BYTES_Y;
-      std::memcpy(&pointDataRecord.y, byteData + offset, nBytes);
-      offset += nBytes;
+    bytes.resize(nBytes);
+    return nBytes == 0 || read(offset, nBytes, bytes.data());
+  }
+};
+
+/// @brief Bytes of a local file read with `std::ifstream`
+class FileByteSource : public ByteSource {
+ public:
+  explicit FileByteSource(const std::string& filePath)
+      : _file(filePath, std::ios::binary),
+        _size(0),
+        _mutex() {
+    if (_file) {
+      _file.seekg(0, std::ios::end);
+      _size = (LLAS_ULLONG)_file.tellg();
+    }
+  }
+
+  inline bool isOpen() const {
+    return (bool)_file;
+  }
+
+  LLAS_ULLONG size() const override {
+    return _size;
+  }
+
+  bool read(const LLAS_ULLONG offset,
+            const size_t nBytes,
+            char* data) const override {
+    if (offset > _size || nBytes > _size - offset) {
+      return false;
+    }
+
+    // NOTE: The stream has a single position, so concurrent reads are serialized
+    std::lock_guard<std::mutex> lock(_mutex);
+    _file.clear();
+    _file.seekg((std::streamoff)offset, std::ios::beg);
+    _file.read(data, (std::streamsize)nBytes);
+    return _file.gcount() == (std::streamsize)nBytes;
+  }
+
+ private:
+  mutable std::ifstream _file;
+  LLAS_ULLONG _size;
+  mutable std::mutex _mutex;
+};
+
+/// @brief Bytes of a local file through a read-only memory mapping (`MappedFile`)
+class MappedByteSource : public ByteSource {
+ public:
+  explicit MappedByteSource(const std::string& filePath)
+      : _mappedFile() {
+    _mappedFile.open(filePath);
+  }
+
+  inline bool isOpen() const {
+    return _mappedFile.isOpen();
+  }
+
+  LLAS_ULLONG size() const override {
+    return _mappedFile.size();
+  }
+
+  bool read(const LLAS_ULLONG offset,
+            const size_t nBytes,
+            char* data) const override {
+    if (offset > size() || nBytes > size() - offset) {
+      return false;
+    }
+    std::memcpy(data, _mappedFile.data() + offset, nBytes);
+    return true;
+  }
+
+  const char* data() const override {
+    return _mappedFile.data();
+  }
+
+ private:
+  MappedFile _mappedFile;
+};
+
+/// @brief Bytes which are already in memory. They are not copied and must outlive the source.
+class MemoryByteSource : public ByteSource {
+ public:
+  MemoryByteSource(const char* data,
+                   const size_t size)
+      : _data(data),
+        _size(size) {}
+
+  LLAS_ULLONG size() const override {
+    return _size;
+  }
+
+  bool read(const LLAS_ULLONG offset,
+            const size_t nBytes,
+            char* data) const override {
+    if (offset > _size || nBytes > _size - offset) {
+      return false;
+    }
+    std::memcpy(data, _data + offset, nBytes);
+    return true;
+  }
+
+  const char* data() const override {
+    return _data;
+  }
+
+ private:
+  const char* _data;
+  size_t _size;
+};
+
+/// @brief Called to copy `nBytes` bytes at `offset` of the file into `data`, e.g. with an HTTP range request
+/// @return `true` if all the bytes were read
+using RangeReadCallback = std::function<bool(const LLAS_ULLONG offset, const size_t nBytes, char* data)>;
+
+/// @brief Bytes fetched on demand by a user-provided callback, e.g. from object storage
+class RangeReadByteSource : public ByteSource {
+ public:
+  /// @param size Size of the file in bytes
+  /// @param rangeRead Callback which must be safe to call from several threads at once
+  RangeReadByteSource(const LLAS_ULLONG size,
+                      RangeReadCallback rangeRead)
+      : _size(size),
+        _rangeRead(std::move(rangeRead)) {}
+
+  LLAS_ULLONG size() const override {
+    return _size;
+  }
+
+  bool read(const LLAS_ULLONG offset,
+            const size_t nBytes,
+            char* data) const override {
+    if (offset > _size || nBytes > _size - offset) {
+      return false;
+    }
+    return _rangeRead(offset, nBytes, data);
+  }
+
+ private:
+  LLAS_ULLONG _size;
+  RangeReadCallback _rangeRead;
+};
+}  // namespace io
+
+// ==========================================================================
+// Data structure
+// ==========================================================================
+struct PublicHeader {
+  // clang-format off
+  inline static const std::streamsize NUM_BYTES_FILE_SIGNATURE                                      = 4;
+  inline static const std::streamsize NUM_BYTES_FILE_SOURCE_ID                                      = 2;
+  inline static const std::streamsize NUM_BYTES_GLOBAL_ENCODING                                     = 2;
+  inline static const std::streamsize NUM_BYTES_PROJECT_ID_1                                        = 4;
+  inline static const std::streamsize NUM_BYTES_PROJECT_ID_2                                        = 2;
+  inline static const std::streamsize NUM_BYTES_PROJECT_ID_3                                        = 2;
+  inline static const std::streamsize NUM_BYTES_PROJECT_ID_4                                        = 8;
+  inline static const std::streamsize NUM_BYTES_VERSION_MAJOR                                       = 1;
+  inline static const std::streamsize NUM_BYTES_VERSION_MINOR                                       = 1;
+  inline static const std::streamsize NUM_BYTES_SYSTEM_IDENTIFIER                                   = 32;
+  inline static const std::streamsize NUM_BYTES_GENERATING_SOFTWARE                                 = 32;
+  inline static const std::streamsize NUM_BYTES_FILE_CREATION_DAY_OF_YEAR                           = 2;
+  inline static const std::streamsize NUM_BYTES_FILE_CREATION_YEAR                                  = 2;
+  inline static const std::streamsize NUM_BYTES_HEADER_SIZE                                         = 2;
+  inline static const std::streamsize NUM_BYTES_OFFSET_TO_POINT_DATA                                = 4;
+  inline static const std::streamsize NUM_BYTES_NUM_OF_VARIABLE_LENGTH_RECORDS                      = 4;
+  inline static const std::streamsize NUM_BYTES_POINT_DATA_RECORD_FORMAT                            = 1;
+  inline static const std::streamsize NUM_BYTES_POINT_DATA_RECORD_LENGTH                            = 2;
+  inline static const std::streamsize NUM_BYTES_LEGACY_NUM_OF_POINT_RECORDS                         = 4;
+  inline static const std::streamsize NUM_BYTES_LEGACY_NUM_OF_POINT_BY_RETURN                       = 20;
+  inline static const std::streamsize NUM_BYTES_X_SCALE_FACTOR                                      = 8;
+  inline static const std::streamsize NUM_BYTES_Y_SCALE_FACTOR                                      = 8;
+  inline static const std::streamsize NUM_BYTES_Z_SCALE_FACTOR                                      = 8;
+  inline static const std::streamsize NUM_BYTES_X_OFFSET                                            = 8;
+  inline static const std::streamsize NUM_BYTES_Y_OFFSET                                            = 8;
+  inline static const std::streamsize NUM_BYTES_Z_OFFSET                                            = 8;
+  inline static const std::streamsize NUM_BYTES_MAX_X                                               = 8;
+  inline static const std::streamsize NUM_BYTES_MAX_Y                                               = 8;
+  inline static const std::streamsize NUM_BYTES_MAX_Z                                               = 8;
+  inline static const std::streamsize NUM_BYTES_MIN_X                                               = 8;
+  inline static const std::streamsize NUM_BYTES_MIN_Y                                               = 8;
+  inline static const std::streamsize NUM_BYTES_MIN_Z                                               = 8;
+  inline static const std::streamsize NUM_BYTES_START_OF_WAVEFORM_DATA_PACKET_RECORD                = 8;
+  inline static const std::streamsize NUM_BYTES_START_OF_FIRST_EXTENDED_VARIABLE_LENGTH_RECORD      = 8;
+  inline static const std::streamsize NUM_BYTES_NUM_OF_EXTENDED_VARIABLE_LENGTH_RECORDS             = 4;
+  inline static const std::streamsize NUM_BYTES_NUM_OF_POINT_RECORDS                                = 8;
+  inline static const std::streamsize NUM_BYTES_NUM_OF_POINTS_BY_RETURN                             = 120;
+
+  // NOTE: Size of the public header of LAS 1.0 to 1.2, 1.3 and 1.4
+  inline static const std::streamsize MIN_HEADER_SIZE                                               = 227;
+  inline static const std::streamsize HEADER_SIZE_V13                                               = 235;
+  inline static const std::streamsize HEADER_SIZE_V14                                               = 375;
+  // clang-format on
+
+  PublicHeader()
+      : fileSignature(),
+        fileSourceID(),
+        globalEncoding(),
+        projectID1(),
+        projectID2(),
+        projectID3(),
+        projectID4(),
+        versionMajor(),
+        versionMinor(),
+        systemIdentifier(),
+        generatingSoftware(),
+        fileCreationDayOfYear(),
+        fileCreationYear(),
+        headerSize(),
+        offsetToPointData(),
+        numOfVariableLengthRecords(),
+        pointDataRecordFormat(),
+        pointDataRecordLength(),
+        legacyNumOfPointRecords(),
+        legacyNumOfPointByReturn(),
+        xScaleFactor(),
+        yScaleFactor(),
+        zScaleFactor(),
+        xOffset(),
+        yOffset(),
+        zOffset(),
+        maxX(),
+        maxY(),
+        maxZ(),
+        minX(),
+        minY(),
+        minZ(),
+        startOfWaveformDataPacketRecord(),
+        startOfFirstExtendedVariableLengthRecord(),
+        numOfExtendedVariableLengthRecords(),
+        numOfPointRecords(),
+        numOfPointsByReturn(),
+        hasStartOfWaveformDataPacketRecord(),
+        hasStartOfFirstExtendedVariableLengthRecord(),
+        hasNumOfExtendedVariableLengthRecords(),
+        hasNumOfPointRecords(),
+        hasNumOfPointsByReturn() {
+  }
+
+  // clang-format off
+  LLAS_CHAR      fileSignature[NUM_BYTES_FILE_SIGNATURE + 1];           // plus null-termination
+  LLAS_USHORT    fileSourceID;
+  LLAS_USHORT    globalEncoding;
+  LLAS_ULONG     projectID1;
+  LLAS_USHORT    projectID2;
+  LLAS_USHORT    projectID3;
+  LLAS_CHAR      projectID4[NUM_BYTES_PROJECT_ID_4 + 1];                // plus null-termination
+  LLAS_UCHAR     versionMajor;
+  LLAS_UCHAR     versionMinor;
+  LLAS_CHAR      systemIdentifier[NUM_BYTES_SYSTEM_IDENTIFIER + 1];     // plus null-termination
+  LLAS_CHAR      generatingSoftware[NUM_BYTES_GENERATING_SOFTWARE + 1]; // plus null-termination
+  LLAS_USHORT    fileCreationDayOfYear;
+  LLAS_USHORT    fileCreationYear;
+  LLAS_USHORT    headerSize;
+  LLAS_ULONG     offsetToPointData;
+  LLAS_ULONG     numOfVariableLengthRecords;
+  LLAS_UCHAR     pointDataRecordFormat;
+  LLAS_USHORT    pointDataRecordLength;
+  LLAS_ULONG     legacyNumOfPointRecords;
+  LLAS_ULONG     legacyNumOfPointByReturn[NUM_BYTES_LEGACY_NUM_OF_POINT_BY_RETURN / sizeof(LLAS_ULONG)];
+  LLAS_DOUBLE    xScaleFactor;
+  LLAS_DOUBLE    yScaleFactor;
+  LLAS_DOUBLE    zScaleFactor;
+  LLAS_DOUBLE    xOffset;
+  LLAS_DOUBLE    yOffset;
+  LLAS_DOUBLE    zOffset;
+  LLAS_DOUBLE    maxX;
+  LLAS_DOUBLE    maxY;
+  LLAS_DOUBLE    maxZ;
+  LLAS_DOUBLE    minX;
+  LLAS_DOUBLE    minY;
+  LLAS_DOUBLE    minZ;
+  LLAS_ULLONG    startOfWaveformDataPacketRecord;
+  LLAS_ULLONG    startOfFirstExtendedVariableLengthRecord;
+  LLAS_ULONG     numOfExtendedVariableLengthRecords;
+  LLAS_ULLONG    numOfPointRecords;
+  LLAS_ULLONG    numOfPointsByReturn[NUM_BYTES_NUM_OF_POINTS_BY_RETURN / sizeof(LLAS_ULLONG)];
+
+  bool hasStartOfWaveformDataPacketRecord;
+  bool hasStartOfFirstExtendedVariableLengthRecord;
+  bool hasNumOfExtendedVariableLengthRecords;
+  bool hasNumOfPointRecords;
+  bool hasNumOfPointsByReturn;
+  // clang-format on
+
+  /// @brief Check whether the point data is LASzip compressed (LAZ), which sets bit 7 or 6 of the point data record format
+  inline bool isCompressed() const {
+    return (pointDataRecordFormat & 0xC0) != 0;
+  }
+
+  /// @brief Get the number of point records
+  /// @return `nPointRecords` (`LLAS_ULLONG`): legacy count for formats 0 to 5, 64-bit count otherwise
+  inline LLAS_ULLONG getNumPointRecords() const {
+    const bool isLegacyFormat = pointDataRecordFormat <= 5;
+
+    if (isLegacyFormat && !(legacyNumOfPointRecords == 0 && hasNumOfPointRecords)) {
+      return legacyNumOfPointRecords;
+    }
+
+    return numOfPointRecords;
+  }
+
+  static PublicHeader readPublicHeader(const std::vector<char>& fileBytes) {
+    return readPublicHeader(fileBytes.data());
+  }
+
+  static PublicHeader readPublicHeader(const char* data) {
+    PublicHeader publicHeader;
+    size_t offset = 0;
+
+    {
+      // File signature
+      const std::streamsize nBytes = PublicHeader::NUM_BYTES_FILE_SIGNATURE;
+      std::memcpy(&publicHeader.fileSignature, data + offset, nBytes);
+      offset += nBytes;
+    }
+
+    {
+      // File source ID
+      const std::streamsize nBytes = PublicHeader::NUM_BYTES_FILE_SOURCE_ID;
+      std::memcpy(&publicHeader.fileSourceID, data + offset, nBytes);
+      offset += nBytes;
+    }
+
+    {
+      // Global encoding
+      const std::streamsize nBytes = PublicHeader::NUM_BYTES_GLOBAL_ENCODING;
+      std::memcpy(&publicHeader.globalEncoding, data + offset, nBytes);
+      offset += nBytes;
+    }
+
+    {
+      // Project ID-GUID Data 1
+      const std::streamsize nBytes = PublicHeader::NUM_BYTES_PROJECT_ID_1;
+      std::memcpy(&publicHeader.projectID1, data + offset, nBytes);
+      offset += nBytes;
+    }
+
+    {
+      // Project ID-GUID Data 2
+      const std::streamsize nBytes = PublicHeader::NUM_BYTES_PROJECT_ID_2;
+      std::memcpy(&publicHeader.projectID2, data + offset, nBytes);
+      offset += nBytes;
+    }
+
+    {
+      // Project ID-GUID Data 3
+      const std::streamsize nBytes = PublicHeader::NUM_BYTES_PROJECT_ID_3;
+      std::memcpy(&publicHeader.projectID3, data + offset, nBytes);
+      offset += nBytes;
+    }
+
+    {
+      // Project ID-GUID Data 4
+      const std::streamsize nBytes = PublicHeader::NUM_BYTES_PROJECT_ID_4;
+      std::memcpy(&publicHeader.projectID4, data + offset, nBytes);
+      offset += nBytes;
+    }
+
+    {
+      // Version major
+      const std::streamsize nBytes = PublicHeader::NUM_BYTES_VERSION_MAJOR;
+      std::memcpy(&publicHeader.versionMajor, data + offset, nBytes);
+      offset += nBytes;
+    }
+
+    {
+      // Version minor
+      const std::streamsize nBytes = PublicHeader::NUM_BYTES_VERSION_MINOR;
+      std::memcpy(&publicHeader.versionMinor, data + offset, nBytes);
+      offset += nBytes;
+
+      if (publicHeader.versionMinor >= 3) {
+        publicHeader.hasStartOfWaveformDataPacketRecord = true;
+      }
+
+      if (publicHeader.versionMinor >= 4) {
+        publicHeader.hasStartOfFirstExtendedVariableLengthRecord = true;
+        publicHeader.hasNumOfExtendedVariableLengthRecords = true;
+        publicHeader.hasNumOfPointRecords = true;
+        publicHeader.hasNumOfPointsByReturn = true;
+      }
+    }
+
+    {
+      // System Identifier
+      const std::streamsize nBytes = PublicHeader::NUM_BYTES_SYSTEM_IDENTIFIER;
+      std::memcpy(&publicHeader.systemIdentifier, data + offset, nBytes);
+      offset += nBytes;
+    }
+
+    {
+      // Generating Software
+      const std::streamsize nBytes = PublicHeader::NUM_BYTES_GENERATING_SOFTWARE;
+      std::memcpy(&publicHeader.generatingSoftware, data + offset, nBytes);
+      offset += nBytes;
+    }
+
+    {
+      // File Creation Day of Year
+      const std::streamsize nBytes = PublicHeader::NUM_BYTES_FILE_CREATION_DAY_OF_YEAR;
+      std::memcpy(&publicHeader.fileCreationDayOfYear, data + offset, nBytes);
+      offset += nBytes;
+    }
+
+    {
+      // File Creation Year
+      const std::streamsize nBytes = PublicHeader::NUM_BYTES_FILE_CREATION_YEAR;
+      std::memcpy(&publicHeader.fileCreationYear, data + offset, nBytes);
+      offset += nBytes;
+    }
+
+    {
+      // Header size
+      const std::streamsize nBytes = PublicHeader::NUM_BYTES_HEADER_SIZE;
+      std::memcpy(&publicHeader.headerSize, data + offset, nBytes);
+      offset += nBytes;
+    }
+
+    {
+      // Offset to point data
+      const std::streamsize nBytes = PublicHeader::NUM_BYTES_OFFSET_TO_POINT_DATA;
+      std::memcpy(&publicHeader.offsetToPointData, data + offset, nBytes);
+      offset += nBytes;
+    }
+
+    {
+      // Number of Variable Length Records
+      const std::streamsize nBytes = PublicHeader::NUM_BYTES_NUM_OF_VARIABLE_LENGTH_RECORDS;
+      std::memcpy(&publicHeader.numOfVariableLengthRecords, data + offset, nBytes);
+      offset += nBytes;
+    }
+
+    {
+      // Point Data Record Format
+      const std::streamsize nBytes = PublicHeader::NUM_BYTES_POINT_DATA_RECORD_FORMAT;
+      std::memcpy(&publicHeader.pointDataRecordFormat, data + offset, nBytes);
+      offset += nBytes;
+    }
+
+    {
+      // Point Data Record Length
+      const std::streamsize nBytes = PublicHeader::NUM_BYTES_POINT_DATA_RECORD_LENGTH;
+      std::memcpy(&publicHeader.pointDataRecordLength, data + offset, nBytes);
+      offset += nBytes;
+    }
+
+    {
+      // Legacy Number of Point Records
+      const std::streamsize nBytes = PublicHeader::NUM_BYTES_LEGACY_NUM_OF_POINT_RECORDS;
+      std::memcpy(&publicHeader.legacyNumOfPointRecords, data + offset, nBytes);
+      offset += nBytes;
+    }
+
+    {
+      // Legacy Number of Point by Return
+      const std::streamsize nBytes = PublicHeader::NUM_BYTES_LEGACY_NUM_OF_POINT_BY_RETURN;
+      std::memcpy(&publicHeader.legacyNumOfPointByReturn, data + offset, nBytes);
+      offset += nBytes;
+    }
+
+    {
+      // X Scale Factor
+      const std::streamsize nBytes = PublicHeader::NUM_BYTES_X_SCALE_FACTOR;
+      std::memcpy(&publicHeader.xScaleFactor, data + offset, nBytes);
+      offset += nBytes;
+    }
+
+    {
+      // Y Scale Factor
+      const std::streamsize nBytes = PublicHeader::NUM_BYTES_Y_SCALE_FACTOR;
+      std::memcpy(&publicHeader.yScaleFactor, data + offset, nBytes);
+      offset += nBytes;
+    }
+
+    {
+      // Z Scale Factor
+      const std::streamsize nBytes = PublicHeader::NUM_BYTES_Z_SCALE_FACTOR;
+      std::memcpy(&publicHeader.zScaleFactor, data + offset, nBytes);
+      offset += nBytes;
+    }
+
+    {
+      // X Offset
+      const std::streamsize nBytes = PublicHeader::NUM_BYTES_X_OFFSET;
+      std::memcpy(&publicHeader.xOffset, data + offset, nBytes);
+      offset += nBytes;
+    }
+
+    {
+      // Y Offset
+      const std::streamsize nBytes = PublicHeader::NUM_BYTES_Y_OFFSET;
+      std::memcpy(&publicHeader.yOffset, data + offset, nBytes);
+      offset += nBytes;
+    }
+
+    {
+      // Z Offset
+      const std::streamsize nBytes = PublicHeader::NUM_BYTES_Z_OFFSET;
+      std::memcpy(&publicHeader.zOffset, data + offset, nBytes);
+      offset += nBytes;
+    }
+
+    {
+      // Max X
+      const std::streamsize nBytes = PublicHeader::NUM_BYTES_MAX_X;
+      std::memcpy(&publicHeader.maxX, data + offset, nBytes);
+      offset += nBytes;
+    }
+
+    {
+      // Min X
+      const std::streamsize nBytes = PublicHeader::NUM_BYTES_MIN_X;
+      std::memcpy(&publicHeader.minX, data + offset, nBytes);
+      offset += nBytes;
+    }
+
+    {
+      // Max Y
+      const std::streamsize nBytes = PublicHeader::NUM_BYTES_MAX_Y;
+      std::memcpy(&publicHeader.maxY, data + offset, nBytes);
+      offset += nBytes;
+    }
+
+    {
+      // Min Y
+      const std::streamsize nBytes = PublicHeader::NUM_BYTES_MIN_Y;
+      std::memcpy(&publicHeader.minY, data + offset, nBytes);
+      offset += nBytes;
+    }
+
+    {
+      // Max Z
+      const std::streamsize nBytes = PublicHeader::NUM_BYTES_MAX_Z;
+      std::memcpy(&publicHeader.maxZ, data + offset, nBytes);
+      offset += nBytes;
+    }
+
+    {
+      // Min Z
+      const std::streamsize nBytes = PublicHeader::NUM_BYTES_MIN_Z;
+      std::memcpy(&publicHeader.minZ, data + offset, nBytes);
+      offset += nBytes;
+    }
+
+    if (publicHeader.hasStartOfWaveformDataPacketRecord) {
+      // Start of Waveform Data Packet Record
+      const std::streamsize nBytes = PublicHeader::NUM_BYTES_START_OF_WAVEFORM_DATA_PACKET_RECORD;
+      std::memcpy(&publicHeader.startOfWaveformDataPacketRecord, data + offset, nBytes);
+      offset += nBytes;
+    }
+
+    if (publicHeader.hasStartOfFirstExtendedVariableLengthRecord) {
+      // Start of First Extended Variable Length Record
+      const std::streamsize nBytes = PublicHeader::NUM_BYTES_START_OF_FIRST_EXTENDED_VARIABLE_LENGTH_RECORD;
+      std::memcpy(&publicHeader.startOfFirstExtendedVariableLengthRecord, data + offset, nBytes);
+      offset += nBytes;
+    }
+
+    if (publicHeader.hasNumOfExtendedVariableLengthRecords) {
+      // Number of Extended Variable Length Records
+      const std::streamsize nBytes = PublicHeader::NUM_BYTES_NUM_OF_EXTENDED_VARIABLE_LENGTH_RECORDS;
+      std::memcpy(&publicHeader.numOfExtendedVariableLengthRecords, data + offset, nBytes);
+      offset += nBytes;
+    }
+
+    if (publicHeader.hasNumOfPointRecords) {
+      // Number of Point Records
+      const std::streamsize nBytes = PublicHeader::NUM_BYTES_NUM_OF_POINT_RECORDS;
+      std::memcpy(&publicHeader.numOfPointRecords, data + offset, nBytes);
+      offset += nBytes;
+    }
+
+    if (publicHeader.hasNumOfPointsByReturn) {
+      // Number of Points by Return
+      const std::streamsize nBytes = PublicHeader::NUM_BYTES_NUM_OF_POINTS_BY_RETURN;
+      std::memcpy(&publicHeader.numOfPointsByReturn, data + offset, nBytes);
+      offset += nBytes;
+    }
+
+    return publicHeader;
+  };
+
+  /// @brief Get the size of the public header defined by the LAS version
+  /// @param versionMinor Minor version of LAS 1.x
+  /// @return `headerSize` (`std::streamsize`)
+  static inline std::streamsize getHeaderSize(const LLAS_UCHAR& versionMinor) {
+    if (versionMinor >= 4) {
+      return HEADER_SIZE_V14;
+    }
+    if (versionMinor >= 3) {
+      return HEADER_SIZE_V13;
+    }
+    return MIN_HEADER_SIZE;
+  }
+
+  /// @brief Write the public header. The optional fields of LAS 1.3 and 1.4 are written if their `has*` flag is set.
+  /// @param data Output buffer of at least `getHeaderSize(versionMinor)` bytes
+  void writePublicHeader(char* data) const {
+    size_t offset = 0;
+
+    {
+      // File signature
+      const std::streamsize nBytes = PublicHeader::NUM_BYTES_FILE_SIGNATURE;
+      std::memcpy(data + offset, &fileSignature, nBytes);
+      offset += nBytes;
+    }
+
+    {
+      // File source ID
+      const std::streamsize nBytes = PublicHeader::NUM_BYTES_FILE_SOURCE_ID;
+      std::memcpy(data + offset, &fileSourceID, nBytes);
+      offset += nBytes;
+    }
+
+    {
+      // Global encoding
+      const std::streamsize nBytes = PublicHeader::NUM_BYTES_GLOBAL_ENCODING;
+      std::memcpy(data + offset, &globalEncoding, nBytes);
+      offset += nBytes;
+    }
+
+    {
+      // Project ID-GUID Data 1
+      const std::streamsize nBytes = PublicHeader::NUM_BYTES_PROJECT_ID_1;
+      std::memcpy(data + offset, &projectID1, nBytes);
+      offset += nBytes;
+    }
+
+    {
+      // Project ID-GUID Data 2
+      const std::streamsize nBytes = PublicHeader::NUM_BYTES_PROJECT_ID_2;
+      std::memcpy(data + offset, &projectID2, nBytes);
+      offset += nBytes;
+    }
+
+    {
+      // Project ID-GUID Data 3
+      const std::streamsize nBytes = PublicHeader::NUM_BYTES_PROJECT_ID_3;
+      std::memcpy(data + offset, &projectID3, nBytes);
+      offset += nBytes;
+    }
+
+    {
+      // Project ID-GUID Data 4
+      const std::streamsize nBytes = PublicHeader::NUM_BYTES_PROJECT_ID_4;
+      std::memcpy(data + offset, &projectID4, nBytes);
+      offset += nBytes;
+    }
+
+    {
+      // Version major
+      const std::streamsize nBytes = PublicHeader::NUM_BYTES_VERSION_MAJOR;
+      std::memcpy(data + offset, &versionMajor, nBytes);
+      offset += nBytes;
+    }
+
+    {
+      // Version minor
+      const std::streamsize nBytes = PublicHeader::NUM_BYTES_VERSION_MINOR;
+      std::memcpy(data + offset, &versionMinor, nBytes);
+      offset += nBytes;
+    }
+
+    {
+      // System Identifier
+      const std::streamsize nBytes = PublicHeader::NUM_BYTES_SYSTEM_IDENTIFIER;
+      std::memcpy(data + offset, &systemIdentifier, nBytes);
+      offset += nBytes;
+    }
+
+    {
+      // Generating Software
+      const std::streamsize nBytes = PublicHeader::NUM_BYTES_GENERATING_SOFTWARE;
+      std::memcpy(data + offset, &generatingSoftware, nBytes);
+      offset += nBytes;
+    }
+
+    {
+      // File Creation Day of Year
+      const std::streamsize nBytes = PublicHeader::NUM_BYTES_FILE_CREATION_DAY_OF_YEAR;
+      std::memcpy(data + offset, &fileCreationDayOfYear, nBytes);
+      offset += nBytes;
+    }
+
+    {
+      // File Creation Year
+      const std::streamsize nBytes = PublicHeader::NUM_BYTES_FILE_CREATION_YEAR;
+      std::memcpy(data + offset, &fileCreationYear, nBytes);
+      offset += nBytes;
+    }
+
+    {
+      // Header size
+      const std::streamsize nBytes = PublicHeader::NUM_BYTES_HEADER_SIZE;
+      std::memcpy(data + offset, &headerSize, nBytes);
+      offset += nBytes;
+    }
+
+    {
+      // Offset to point data
+      const std::streamsize nBytes = PublicHeader::NUM_BYTES_OFFSET_TO_POINT_DATA;
+      std::memcpy(data + offset, &offsetToPointData, nBytes);
+      offset += nBytes;
+    }
+
+    {
+      // Number of Variable Length Records
+      const std::streamsize nBytes = PublicHeader::NUM_BYTES_NUM_OF_VARIABLE_LENGTH_RECORDS;
+      std::memcpy(data + offset, &numOfVariableLengthRecords, nBytes);
+      offset += nBytes;
+    }
+
+    {
+      // Point Data Record Format
+      const std::streamsize nBytes = PublicHeader::NUM_BYTES_POINT_DATA_RECORD_FORMAT;
+      std::memcpy(data + offset, &pointDataRecordFormat, nBytes);
+      offset += nBytes;
+    }
+
+    {
+      // Point Data Record Length
+      const std::streamsize nBytes = PublicHeader::NUM_BYTES_POINT_DATA_RECORD_LENGTH;
+      std::memcpy(data + offset, &pointDataRecordLength, nBytes);
+      offset += nBytes;
+    }
+
+    {
+      // Legacy Number of Point Records
+      const std::streamsize nBytes = PublicHeader::NUM_BYTES_LEGACY_NUM_OF_POINT_RECORDS;
+      std::memcpy(data + offset, &legacyNumOfPointRecords, nBytes);
+      offset += nBytes;
+    }
+
+    {
+      // Legacy Number of Point by Return
+      const std::streamsize nBytes = PublicHeader::NUM_BYTES_LEGACY_NUM_OF_POINT_BY_RETURN;
+      std::memcpy(data + offset, &legacyNumOfPointByReturn, nBytes);
+      offset += nBytes;
+    }
+
+    {
+      // X Scale Factor
+      const std::streamsize nBytes = PublicHeader::NUM_BYTES_X_SCALE_FACTOR;
+      std::memcpy(data + offset, &xScaleFactor, nBytes);
+      offset += nBytes;
+    }
+
+    {
+      // Y Scale Factor
+      const std::streamsize nBytes = PublicHeader::NUM_BYTES_Y_SCALE_FACTOR;
+      std::memcpy(data + offset, &yScaleFactor, nBytes);
+      offset += nBytes;
+    }
+
+    {
+      // Z Scale Factor
+      const std::streamsize nBytes = PublicHeader::NUM_BYTES_Z_SCALE_FACTOR;
+      std::memcpy(data + offset, &zScaleFactor, nBytes);
+      offset += nBytes;
+    }
+
+    {
+      // X Offset
+      const std::streamsize nBytes = PublicHeader::NUM_BYTES_X_OFFSET;
+      std::memcpy(data + offset, &xOffset, nBytes);
+      offset += nBytes;
+    }
+
+    {
+      // Y Offset
+      const std::streamsize nBytes = PublicHeader::NUM_BYTES_Y_OFFSET;
+      std::memcpy(data + offset, &yOffset, nBytes);
+      offset += nBytes;
+    }
+
+    {
+      // Z Offset
+      const std::streamsize nBytes = PublicHeader::NUM_BYTES_Z_OFFSET;
+      std::memcpy(data + offset, &zOffset, nBytes);
+      offset += nBytes;
+    }
+
+    {
+      // Max X
+      const std::streamsize nBytes = PublicHeader::NUM_BYTES_MAX_X;
+      std::memcpy(data + offset, &maxX, nBytes);
+      offset += nBytes;
+    }
+
+    {
+      // Min X
+      const std::streamsize nBytes = PublicHeader::NUM_BYTES_MIN_X;
+      std::memcpy(data + offset, &minX, nBytes);
+      offset += nBytes;
+    }
+
+    {
+      // Max Y
+      const std::streamsize nBytes = PublicHeader::NUM_BYTES_MAX_Y;
+      std::memcpy(data + offset, &maxY, nBytes);
+      offset += nBytes;
+    }
+
+    {
+      // Min Y
+      const std::streamsize nBytes = PublicHeader::NUM_BYTES_MIN_Y;
+      std::memcpy(data + offset, &minY, nBytes);
+      offset += nBytes;
+    }
+
+    {
+      // Max Z
+      const std::streamsize nBytes = PublicHeader::NUM_BYTES_MAX_Z;
+      std::memcpy(data + offset, &maxZ, nBytes);
+      offset += nBytes;
+    }
+
+    {
+      // Min Z
+      const std::streamsize nBytes = PublicHeader::NUM_BYTES_MIN_Z;
+      std::memcpy(data + offset, &minZ, nBytes);
+      offset += nBytes;
+    }
+
+    if (hasStartOfWaveformDataPacketRecord) {
+      // Start of Waveform Data Packet Record
+      const std::streamsize nBytes = PublicHeader::NUM_BYTES_START_OF_WAVEFORM_DATA_PACKET_RECORD;
+      std::memcpy(data + offset, &startOfWaveformDataPacketRecord, nBytes);
+      offset += nBytes;
+    }
+
+    if (hasStartOfFirstExtendedVariableLengthRecord) {
+      // Start of First Extended Variable Length Record
+      const std::streamsize nBytes = PublicHeader::NUM_BYTES_START_OF_FIRST_EXTENDED_VARIABLE_LENGTH_RECORD;
+      std::memcpy(data + offset, &startOfFirstExtendedVariableLengthRecord, nBytes);
+      offset += nBytes;
+    }
+
+    if (hasNumOfExtendedVariableLengthRecords) {
+      // Number of Extended Variable Length Records
+      const std::streamsize nBytes = PublicHeader::NUM_BYTES_NUM_OF_EXTENDED_VARIABLE_LENGTH_RECORDS;
+      std::memcpy(data + offset, &numOfExtendedVariableLengthRecords, nBytes);
+      offset += nBytes;
+    }
+
+    if (hasNumOfPointRecords) {
+      // Number of Point Records
+      const std::streamsize nBytes = PublicHeader::NUM_BYTES_NUM_OF_POINT_RECORDS;
+      std::memcpy(data + offset, &numOfPointRecords, nBytes);
+      offset += nBytes;
+    }
+
+    if (hasNumOfPointsByReturn) {
+      // Number of Points by Return
+      const std::streamsize nBytes = PublicHeader::NUM_BYTES_NUM_OF_POINTS_BY_RETURN;
+      std::memcpy(data + offset, &numOfPointsByReturn, nBytes);
+      offset += nBytes;
+    }
+  }
+};
+
+/// @brief Read-only payload of a (E)VLR. The records read from one file refer to a single shared arena instead of owning
+///        one allocation each, and the arena is freed together with the last record referring to it.
+class RecordBytes {
+ public:
+  using Arena = std::shared_ptr<const std::vector<char>>;
+
+  RecordBytes()
+      : _arena(),
+        _data(nullptr),
+        _size(0) {}
+
+  /// @brief Copy `bytes` into an arena of its own
+  RecordBytes(const std::vector<char>& bytes)
+      : RecordBytes(bytes.data(), bytes.size()) {}
+
+  /// @brief Copy `size` bytes of `data` into an arena of its own
+  RecordBytes(const char* data, const size_t size)
+      : RecordBytes() {
+    if (size > 0) {
+      _arena = std::make_shared<const std::vector<char>>(data, data + size);
+      _data = _arena->data();
+      _size = size;
+    }
+  }
+
+  /// @brief Refer to `size` bytes at `offset` of `arena` without copying them
+  RecordBytes(const Arena& arena, const size_t offset, const size_t size)
+      : _arena(arena),
+        _data(arena->data() + offset),
+        _size(size) {}
+
+  inline const char* data() const {
+    return _data;
+  }
+
+  inline size_t size() const {
+    return _size;
+  }
+
+  inline bool empty() const {
+    return _size == 0;
+  }
+
+  inline const char* begin() const {
+    return _data;
+  }
+
+  inline const char* end() const {
+    return _data + _size;
+  }
+
+  inline const char& operator[](const size_t i) const {
+    return _data[i];
+  }
+
+  /// @brief Replace the payload with a copy of `[first, last)`
+  inline void assign(const char* first, const char* last) {
+    *this = RecordBytes(first, (size_t)(last - first));
+  }
+
+  /// @brief Copy the payload to a vector
+  inline std::vector<char> toVector() const {
+    return std::vector<char>(begin(), end());
+  }
+
+  inline bool operator==(const RecordBytes& other) const {
+    return _size == other._size && std::equal(begin(), end(), other.begin());
+  }
+
+  inline bool operator!=(const RecordBytes& other) const {
+    return !(*this == other);
+  }
+
+ private:
+  Arena _arena;
+  const char* _data;
+  size_t _size;
+};
+
+struct VariableLengthRecord {
+  // clang-format off
+  inline static const std::streamsize NUM_BYTES_RESERVED                                            = 2;
+  inline static const std::streamsize NUM_BYTES_USER_ID                                             = 16;
+  inline static const std::streamsize NUM_BYTES_RECORD_ID                                           = 2;
+  inline static const std::streamsize NUM_BYTES_RECORD_LENGTH_AFTER_HEADER                          = 2;
+  inline static const std::streamsize NUM_BYTES_DESCPIPTION                                         = 32;
+  inline static const std::streamsize NUM_BYTES_HEADER                                              = 54;
+  // clang-format on
+
+  VariableLengthRecord()
+      : reserved(),
+        userID(),
+        recordID(),
+        recordLengthAfterHeader(),
+        description(),
+        record() {}
+
+  // clang-format off
+  LLAS_USHORT       reserved;
+  LLAS_CHAR         userID[NUM_BYTES_USER_ID + 1];          // plus null-termination
+  LLAS_USHORT       recordID;
+  LLAS_USHORT       recordLengthAfterHeader;
+  LLAS_CHAR         description[NUM_BYTES_DESCPIPTION + 1]; // plus null-termination
+  RecordBytes       record;
+  // clang-format on
+
+  static VariableLengthRecord readVariableLengthRecord(const std::vector<char>& fileBytes,
+                                                       std::streamsize& offset) {
+    return readVariableLengthRecord(fileBytes.data(), offset);
+  }
+
+  static VariableLengthRecord readVariableLengthRecord(const char* data,
+                                                       std::streamsize& offset) {
+    return readVariableLengthRecord(data, offset, nullptr, 0);
+  }
+
+  /// @brief Read the record at `offset` and advance `offset` past it
+  /// @param arena Copy of `data` from `arenaOffset` on which the payload refers to. The payload is copied if `nullptr`.
+  /// @param arenaOffset Offset of `arena` in `data`
+  static VariableLengthRecord readVariableLengthRecord(const char* data,
+                                                       std::streamsize& offset,
+                                                       const RecordBytes::Arena& arena,
+                                                       const std::streamsize arenaOffset) {
+    VariableLengthRecord vlr;
+
+    {
+      // Reserved
+      const std::streamsize nBytes = VariableLengthRecord::NUM_BYTES_RESERVED;
+      std::memcpy(&vlr.reserved, data + offset, nBytes);
+      offset += nBytes;
+    }
+
+    {
+      // User ID
+      const std::streamsize nBytes = VariableLengthRecord::NUM_BYTES_USER_ID;
+      std::memcpy(&vlr.userID, data + offset, nBytes);
+      offset += nBytes;
+    }
+
+    {
+      // Record ID
+      const std::streamsize nBytes = VariableLengthRecord::NUM_BYTES_RECORD_ID;
+      std::memcpy(&vlr.recordID, data + offset, nBytes);
+      offset += nBytes;
+    }
+
+    {
+      // Record Length After Header
+      const std::streamsize nBytes = VariableLengthRecord::NUM_BYTES_RECORD_LENGTH_AFTER_HEADER;
+      std::memcpy(&vlr.recordLengthAfterHeader, data + offset, nBytes);
+      offset += nBytes;
+    }
+
+    {
+      // Description
+      const std::streamsize nBytes = VariableLengthRecord::NUM_BYTES_DESCPIPTION;
+      std::memcpy(&vlr.description, data + offset, nBytes);
+      offset += nBytes;
+    }
+
+    if (vlr.recordLengthAfterHeader <= 65535) {
+      // Record
+      const std::streamsize nBytes = (std::streamsize)vlr.recordLengthAfterHeader;
+      if (arena != nullptr) {
+        vlr.record = RecordBytes(arena, (size_t)(offset - arenaOffset), (size_t)nBytes);
+      } else {
+        vlr.record = RecordBytes(data + offset, (size_t)nBytes);
+      }
+      offset += nBytes;
+    } else {
+      _LLAS_logError("Exceed the payload limit of variable length record: " << vlr.recordLengthAfterHeader);
+    }
+
+    return vlr;
+  }
+
+  /// @brief Write the record at `offset` and advance `offset` past it. 'Record Length After Header' is the size of `record`.
+  /// @param data Output buffer of at least `NUM_BYTES_HEADER + record.size()` bytes after `offset`
+  void writeVariableLengthRecord(char* data,
+                                 std::streamsize& offset) const {
+    const LLAS_USHORT recordLengthAfterHeader_ = (LLAS_USHORT)record.size();
+
+    {
+      // Reserved
+      const std::streamsize nBytes = VariableLengthRecord::NUM_BYTES_RESERVED;
+      std::memcpy(data + offset, &reserved, nBytes);
+      offset += nBytes;
+    }
+
+    {
+      // User ID
+      const std::streamsize nBytes = VariableLengthRecord::NUM_BYTES_USER_ID;
+      std::memcpy(data + offset, &userID, nBytes);
+      offset += nBytes;
+    }
+
+    {
+      // Record ID
+      const std::streamsize nBytes = VariableLengthRecord::NUM_BYTES_RECORD_ID;
+      std::memcpy(data + offset, &recordID, nBytes);
+      offset += nBytes;
+    }
+
+    {
+      // Record Length After Header
+      const std::streamsize nBytes = VariableLengthRecord::NUM_BYTES_RECORD_LENGTH_AFTER_HEADER;
+      std::memcpy(data + offset, &recordLengthAfterHeader_, nBytes);
+      offset += nBytes;
+    }
+
+    {
+      // Description
+      const std::streamsize nBytes = VariableLengthRecord::NUM_BYTES_DESCPIPTION;
+      std::memcpy(data + offset, &description, nBytes);
+      offset += nBytes;
+    }
+
+    {
+      // Record
+      std::copy(record.begin(), record.end(), data + offset);
+      offset += (std::streamsize)record.size();
+    }
+  }
+};
+
+/// @brief Bit mask of the attributes of 'Point Data Records' to decode
+struct PointField {
+  // clang-format off
+  inline static const LLAS_ULONG X                                                                  = 1 << 0;
+  inline static const LLAS_ULONG Y                                                                  = 1 << 1;
+  inline static const LLAS_ULONG Z                                                                  = 1 << 2;
+  inline static const LLAS_ULONG INTENSITY                                                          = 1 << 3;
+  inline static const LLAS_ULONG CLASSIFICATION                                                     = 1 << 4;  // Classification and classification flags
+  inline static const LLAS_ULONG SCAN_ANGLE                                                         = 1 << 5;
+  inline static const LLAS_ULONG USER_DATA                                                          = 1 << 6;
+  inline static const LLAS_ULONG POINT_SOURCE_ID                                                    = 1 << 7;
+  inline static const LLAS_ULONG GPS_TIME                                                           = 1 << 8;
+  inline static const LLAS_ULONG RGB                                                                = 1 << 9;
+  inline static const LLAS_ULONG RETURNS                                                            = 1 << 10;  // Return number and number of returns
+  inline static const LLAS_ULONG SCAN_FLAGS                                                         = 1 << 11;  // Scanner channel, scan direction flag and edge of flight line
+  inline static const LLAS_ULONG NIR                                                                = 1 << 12;
+  inline static const LLAS_ULONG WAVE_PACKET                                                        = 1 << 13;
+
+  inline static const LLAS_ULONG XYZ                                                                = X | Y | Z;
+  inline static const LLAS_ULONG ALL                                                                = 0xFFFFFFFF;
+  // clang-format on
+
+  /// @brief Get the names of the attributes in `fields`, e.g. for messages
+  /// @return `names` (`std::string`): comma separated
+  static inline std::string getNames(const LLAS_ULONG fields) {
+    // clang-format off
+    static const std::pair<LLAS_ULONG, const char*> NAMES[] = {
+        {X,               "X"},
+        {Y,               "Y"},
+        {Z,               "Z"},
+        {INTENSITY,       "intensity"},
+        {CLASSIFICATION,  "classification"},
+        {SCAN_ANGLE,      "scan angle"},
+        {USER_DATA,       "user data"},
+        {POINT_SOURCE_ID, "point source ID"},
+        {GPS_TIME,        "GPS time"},
+        {RGB,             "RGB"},
+        {RETURNS,         "returns"},
+        {SCAN_FLAGS,      "scan flags"},
+        {NIR,             "NIR"},
+        {WAVE_PACKET,     "wave packet"},
+    };
+    // clang-format on
+
+    std::string names;
+    for (const auto& name : NAMES) {
+      if (fields & name.first) {
+        names += (names.empty() ? "" : ", ") + std::string(name.second);
+      }
+    }
+    return names;
+  }
+};
+
+/// @brief Compile-time byte layout of the point data record format `FORMAT`
+template <int FORMAT>
+struct PointDataRecordFormat {
+  // clang-format off
+  // NOTE: Formats 6 to 10 (LAS 1.4) share the extended layout with 4-bit returns, a separate flags byte and a 16-bit scan angle
+  static constexpr bool IS_EXTENDED                        = FORMAT >= 6;
+  static constexpr bool HAS_GPS_TIME                       = FORMAT == 1 || FORMAT >= 3;
+  static constexpr bool HAS_RGB                            = FORMAT == 2 || FORMAT == 3 || FORMAT == 5 || FORMAT == 7 || FORMAT == 8 || FORMAT == 10;
+  static constexpr bool HAS_NIR                            = FORMAT == 8 || FORMAT == 10;
+  static constexpr bool HAS_WAVE_PACKET                    = FORMAT == 4 || FORMAT == 5 || FORMAT == 9 || FORMAT == 10;
+
+  static constexpr std::streamsize OFFSET_X                = 0;
+  static constexpr std::streamsize OFFSET_Y                = 4;
+  static constexpr std::streamsize OFFSET_Z                = 8;
+  static constexpr std::streamsize OFFSET_INTENSITY        = 12;
+  static constexpr std::streamsize OFFSET_SENSOR_DATA      = 14;
+  static constexpr std::streamsize OFFSET_SCAN_FLAGS       = IS_EXTENDED ? 15 : 14;
+  static constexpr std::streamsize OFFSET_CLASSIFICATION   = IS_EXTENDED ? 16 : 15;
+  static constexpr std::streamsize OFFSET_SCAN_ANGLE       = IS_EXTENDED ? 18 : 16;
+  static constexpr std::streamsize OFFSET_USER_DATA        = 17;
+  static constexpr std::streamsize OFFSET_POINT_SOURCE_ID  = IS_EXTENDED ? 20 : 18;
+  static constexpr std::streamsize OFFSET_GPS_TIME         = IS_EXTENDED ? 22 : 20;
+  static constexpr std::streamsize OFFSET_RGB              = IS_EXTENDED ? 30 : (HAS_GPS_TIME ? 28 : 20);
+  static constexpr std::streamsize OFFSET_NIR              = OFFSET_RGB + (HAS_RGB ? 6 : 0);
+  static constexpr std::streamsize OFFSET_WAVE_PACKET      = OFFSET_NIR + (HAS_NIR ? 2 : 0);
+
+  // NOTE: Size of the fields defined by the format. Records may carry extra bytes after them.
+  static constexpr std::streamsize SIZE                    = OFFSET_WAVE_PACKET + (HAS_WAVE_PACKET ? 29 : 0);
+  // clang-format on
+};
+
+/// @brief Call `func(std::integral_constant<int, FORMAT>())` for the supported point data record format
+/// @param format Point data record format
+/// @param func Generic callable which receives the format as a compile-time constant
+/// @return `true` if the format is supported
+template <class Func>
+inline bool visitPointDataRecordFormat(const LLAS_UCHAR& format, Func&& func) {
+  switch (format) {
+    case 0:
+      func(std::integral_constant<int, 0>());
+      return true;
+    case 1:
+      func(std::integral_constant<int, 1>());
+      return true;
+    case 2:
+      func(std::integral_constant<int, 2>());
+      return true;
+    case 3:
+      func(std::integral_constant<int, 3>());
+      return true;
+    case 4:
+      func(std::integral_constant<int, 4>());
+      return true;
+    case 5:
+      func(std::integral_constant<int, 5>());
+      return true;
+    case 6:
+      func(std::integral_constant<int, 6>());
+      return true;
+    case 7:
+      func(std::integral_constant<int, 7>());
+      return true;
+    case 8:
+      func(std::integral_constant<int, 8>());
+      return true;
+    case 9:
+      func(std::integral_constant<int, 9>());
+      return true;
+    case 10:
+      func(std::integral_constant<int, 10>());
+      return true;
+    default:
+      return false;
+  }
+}
+
+struct PointDataRecord {
+  // clang-format off
+  inline static const std::streamsize NUM_BYTES_X                                                   = 4;
+  inline static const std::streamsize NUM_BYTES_Y                                                   = 4;
+  inline static const std::streamsize NUM_BYTES_Z                                                   = 4;
+  inline static const std::streamsize NUM_BYTES_INTENSITY                                           = 2;
+  inline static const std::streamsize NUM_BYTES_SENSOR_DATA                                         = 1;
+  inline static const std::streamsize NUM_BYTES_CLASSIFICATION                                      = 1;
+  inline static const std::streamsize NUM_BYTES_SCAN_ANGLE_RANK                                     = 1;
+  inline static const std::streamsize NUM_BYTES_SCAN_ANGLE                                          = 2;
+  inline static const std::streamsize NUM_BYTES_USER_DATA                                           = 1;
+  inline static const std::streamsize NUM_BYTES_POINT_SOURCE_ID                                     = 2;
+  inline static const std::streamsize NUM_BYTES_GPS_TIME                                            = 8;
+  inline static const std::streamsize NUM_BYTES_RED                                                 = 2;
+  inline static const std::streamsize NUM_BYTES_GREEN                                               = 2;
+  inline static const std::streamsize NUM_BYTES_BLUE                                                = 2;
+  inline static const std::streamsize NUM_BYTES_NIR                                                 = 2;
+  inline static const std::streamsize NUM_BYTES_WAVE_PACKET_DESCRIPTOR_INDEX                        = 1;
+  inline static const std::streamsize NUM_BYTES_BYTE_OFFSET_TO_WAVEFORM_DATA                        = 8;
+  inline static const std::streamsize NUM_BYTES_WAVEFORM_PACKET_SIZE                                = 4;
+  inline static const std::streamsize NUM_BYTES_RETURN_POINT_WAVEFORM_LOCATION                      = 4;
+  inline static const std::streamsize NUM_BYTES_X_T                                                 = 4;
+  inline static const std::streamsize NUM_BYTES_Y_T                                                 = 4;
+  inline static const std::streamsize NUM_BYTES_Z_T                                                 = 4;
+
+  inline static const LLAS_UCHAR CLASSIFICATION_FLAG_SYNTHETIC                                      = 1 << 0;
+  inline static const LLAS_UCHAR CLASSIFICATION_FLAG_KEY_POINT                                      = 1 << 1;
+  inline static const LLAS_UCHAR CLASSIFICATION_FLAG_WITHHELD                                       = 1 << 2;
+  inline static const LLAS_UCHAR CLASSIFICATION_FLAG_OVERLAP                                        = 1 << 3;  // Formats 6 to 10 only
+  // clang-format on
+
+  PointDataRecord()
+      : x(),
+        y(),
+        z(),
+        intensity(),
+        returnNumber(),
+        numberOfReturns(),
+        classification(),
+        classificationFlags(),
+        scannerChannel(),
+        scanDirectionFlag(),
+        edgeOfFlightLine(),
+        scanAngleRank(),
+        userData(),
+        wavePacketDescriptorIndex(),
+        pointSourceID(),
+        scanAngle(),
+        waveformPacketSize(),
+        GPSTime(),
+        red(),
+        green(),
+        blue(),
+        NIR(),
+        byteOffsetToWaveformData(),
+        returnPointWaveformLocation(),
+        Xt(),
+        Yt(),
+        Zt() {
+  }
+
+  // clang-format off
+  LLAS_LONG      x;
+  LLAS_LONG      y;
+  LLAS_LONG      z;
+  LLAS_USHORT    intensity;
+  LLAS_UCHAR     returnNumber;
+  LLAS_UCHAR     numberOfReturns;
+  LLAS_UCHAR     classification;               // Class only. The synthetic, key-point and withheld bits of formats 0 to 5 are moved to `classificationFlags`.
+  LLAS_UCHAR     classificationFlags;          // `CLASSIFICATION_FLAG_*`
+  LLAS_UCHAR     scannerChannel;               // Formats 6 to 10 only
+  LLAS_UCHAR     scanDirectionFlag;
+  LLAS_UCHAR     edgeOfFlightLine;
+  LLAS_SCHAR     scanAngleRank;                // Formats 0 to 5 only, in degrees
+  LLAS_UCHAR     userData;
+  LLAS_UCHAR     wavePacketDescriptorIndex;
+  LLAS_USHORT    pointSourceID;
+  LLAS_SHORT     scanAngle;                    // Formats 6 to 10 only, in 0.006 degrees
+  LLAS_ULONG     waveformPacketSize;
+  LLAS_DOUBLE    GPSTime;
+  LLAS_USHORT    red;
+  LLAS_USHORT    green;
+  LLAS_USHORT    blue;
+  LLAS_USHORT    NIR;
+  LLAS_ULLONG    byteOffsetToWaveformData;
+  LLAS_FLOAT     returnPointWaveformLocation;
+  LLAS_FLOAT     Xt;
+  LLAS_FLOAT     Yt;
+  LLAS_FLOAT     Zt;
+  // clang-format on
+
+  /// @brief Check whether the point data record format uses the extended layout of LAS 1.4 (formats 6 to 10)
+  static inline bool isExtendedFormat(const LLAS_UCHAR& format) {
+    return 6 <= format && format <= 10;
+  }
+
+  /// @brief Check whether the point data record format contains 'GPS Time'
+  static inline bool hasGPSTime(const LLAS_UCHAR& format) {
+    return format == 1 || format == 3 || format == 4 || format == 5 || (6 <= format && format <= 10);
+  }
+
+  /// @brief Check whether the point data record format contains 'Red', 'Green' and 'Blue'
+  static inline bool hasRGB(const LLAS_UCHAR& format) {
+    return format == 2 || format == 3 || format == 5 || format == 7 || format == 8 || format == 10;
+  }
+
+  /// @brief Check whether the point data record format contains 'NIR'
+  static inline bool hasNIR(const LLAS_UCHAR& format) {
+    return format == 8 || format == 10;
+  }
+
+  /// @brief Check whether the point data record format contains the wave packet fields
+  static inline bool hasWavePacket(const LLAS_UCHAR& format) {
+    return format == 4 || format == 5 || format == 9 || format == 10;
+  }
+
+  /// @brief Get the attributes defined by the point data record format
+  /// @return `fields` (`PointField`)
+  static inline LLAS_ULONG getFormatFields(const LLAS_UCHAR& format) {
+    LLAS_ULONG fields = PointField::XYZ | PointField::INTENSITY | PointField::RETURNS | PointField::CLASSIFICATION | PointField::SCAN_FLAGS |
+                        PointField::SCAN_ANGLE | PointField::USER_DATA | PointField::POINT_SOURCE_ID;
+    fields |= hasGPSTime(format) ? PointField::GPS_TIME : 0;
+    fields |= hasRGB(format) ? PointField::RGB : 0;
+    fields |= hasNIR(format) ? PointField::NIR : 0;
+    fields |= hasWavePacket(format) ? PointField::WAVE_PACKET : 0;
+    return fields;
+  }
+
+  /// @brief Get the size of the fields defined by the point data record format
+  /// @return `size` (`std::streamsize`): 0 if the format is not supported
+  static inline std::streamsize getFormatSize(const LLAS_UCHAR& format) {
+    std::streamsize size = 0;
+    visitPointDataRecordFormat(format, [&](auto formatTag) {
+      size = PointDataRecordFormat<decltype(formatTag)::value>::SIZE;
+    });
+    return size;
+  }
+
+  /// @brief Get the 'Classification' byte as it is stored in a record of `format`.
+  ///        For formats 0 to 5 it holds the class in bits 0 to 4 and the synthetic, key-point and withheld flags in bits 5 to 7,
+  ///        which is what `classification` held before the flags were moved to `classificationFlags`. For formats 6 to 10 it is `classification`.
+  inline LLAS_UCHAR getClassificationByte(const LLAS_UCHAR& format) const {
+    return isExtendedFormat(format) ? classification : (LLAS_UCHAR)((classification & 0x1F) | (classificationFlags << 5));
+  }
+
+  /// @brief Decode a record of the point data record format `FORMAT`.
+  ///        The format is resolved at compile time so that every attribute is read at a fixed offset without branching on the format.
+  /// @param record Bytes starting at the beginning of the record
+  /// @param fields Attributes to decode (`PointField`). Other attributes are left untouched.
+  /// @param pointDataRecord Output record
+  template <int FORMAT>
+  static inline void decodePointDataRecord(const char* record,
+                                           const LLAS_ULONG fields,
+                                           PointDataRecord& pointDataRecord) {
+    using Format = PointDataRecordFormat<FORMAT>;
+
+    if (fields & PointField::X) {
+      std::memcpy(&pointDataRecord.x, record + Format::OFFSET_X, PointDataRecord::NUM_BYTES_X);
+    }
+
+    if (fields & PointField::Y) {
+      std::memcpy(&pointDataRecord.y, record + Format::OFFSET_Y, PointDataRecord::NUM_BYTES_Y);
+    }
+
+    if (fields & PointField::Z) {
+      std::memcpy(&pointDataRecord.z, record + Format::OFFSET_Z, PointDataRecord::NUM_BYTES_Z);
+    }
+
+    if (fields & PointField::INTENSITY) {
+      std::memcpy(&pointDataRecord.intensity, record + Format::OFFSET_INTENSITY, PointDataRecord::NUM_BYTES_INTENSITY);
+    }
+
+    if (fields & PointField::RETURNS) {
+      const LLAS_UCHAR returns = (LLAS_UCHAR)record[Format::OFFSET_SENSOR_DATA];
+      if constexpr (Format::IS_EXTENDED) {
+        pointDataRecord.returnNumber = returns & 0x0F;
+        pointDataRecord.numberOfReturns = returns >> 4;
+      } else {
+        pointDataRecord.returnNumber = returns & 0x07;
+        pointDataRecord.numberOfReturns = (returns >> 3) & 0x07;
+      }
+    }
+
+    if (fields & PointField::SCAN_FLAGS) {
+      const LLAS_UCHAR scanFlags = (LLAS_UCHAR)record[Format::OFFSET_SCAN_FLAGS];
+      if constexpr (Format::IS_EXTENDED) {
+        pointDataRecord.scannerChannel = (scanFlags >> 4) & 0x03;
+      }
+      pointDataRecord.scanDirectionFlag = (scanFlags >> 6) & 0x01;
+      pointDataRecord.edgeOfFlightLine = scanFlags >> 7;
+    }
+
+    if (fields & PointField::CLASSIFICATION) {
+      const LLAS_UCHAR classification = (LLAS_UCHAR)record[Format::OFFSET_CLASSIFICATION];
+      if constexpr (Format::IS_EXTENDED) {
+        pointDataRecord.classification = classification;
+        pointDataRecord.classificationFlags = (LLAS_UCHAR)record[Format::OFFSET_SCAN_FLAGS] & 0x0F;
+      } else {
+        pointDataRecord.classification = classification & 0x1F;
+        pointDataRecord.classificationFlags = classification >> 5;
+      }
+    }
+
+    if (fields & PointField::SCAN_ANGLE) {
+      if constexpr (Format::IS_EXTENDED) {
+        std::memcpy(&pointDataRecord.scanAngle, record + Format::OFFSET_SCAN_ANGLE, PointDataRecord::NUM_BYTES_SCAN_ANGLE);
+      } else {
+        std::memcpy(&pointDataRecord.scanAngleRank, record + Format::OFFSET_SCAN_ANGLE, PointDataRecord::NUM_BYTES_SCAN_ANGLE_RANK);
+      }
+    }
+
+    if (fields & PointField::USER_DATA) {
+      std::memcpy(&pointDataRecord.userData, record + Format::OFFSET_USER_DATA, PointDataRecord::NUM_BYTES_USER_DATA);
+    }
+
+    if (fields & PointField::POINT_SOURCE_ID) {
+      std::memcpy(&pointDataRecord.pointSourceID, record + Format::OFFSET_POINT_SOURCE_ID, PointDataRecord::NUM_BYTES_POINT_SOURCE_ID);
+    }
+
+    if constexpr (Format::HAS_GPS_TIME) {
+      if (fields & PointField::GPS_TIME) {
+        std::memcpy(&pointDataRecord.GPSTime, record + Format::OFFSET_GPS_TIME, PointDataRecord::NUM_BYTES_GPS_TIME);
+      }
+    }
+
+    if constexpr (Format::HAS_RGB) {
+      if (fields & PointField::RGB) {
+        std::memcpy(&pointDataRecord.red, record + Format::OFFSET_RGB, PointDataRecord::NUM_BYTES_RED);
+        std::memcpy(&pointDataRecord.green, record + Format::OFFSET_RGB + PointDataRecord::NUM_BYTES_RED, PointDataRecord::NUM_BYTES_GREEN);
+        std::memcpy(&pointDataRecord.blue, record + Format::OFFSET_RGB + PointDataRecord::NUM_BYTES_RED + PointDataRecord::NUM_BYTES_GREEN, PointDataRecord::NUM_BYTES_BLUE);
+      }
+    }
+
+    if constexpr (Format::HAS_NIR) {
+      if (fields & PointField::NIR) {
+        std::memcpy(&pointDataRecord.NIR, record + Format::OFFSET_NIR, PointDataRecord::NUM_BYTES_NIR);
+      }
+    }
+
+    if constexpr (Format::HAS_WAVE_PACKET) {
+      if (fields & PointField::WAVE_PACKET) {
+        const char* wavePacket = record + Format::OFFSET_WAVE_PACKET;
+        std::memcpy(&pointDataRecord.wavePacketDescriptorIndex, wavePacket, PointDataRecord::NUM_BYTES_WAVE_PACKET_DESCRIPTOR_INDEX);
+        wavePacket += PointDataRecord::NUM_BYTES_WAVE_PACKET_DESCRIPTOR_INDEX;
+        std::memcpy(&pointDataRecord.byteOffsetToWaveformData, wavePacket, PointDataRecord::NUM_BYTES_BYTE_OFFSET_TO_WAVEFORM_DATA);
+        wavePacket += PointDataRecord::NUM_BYTES_BYTE_OFFSET_TO_WAVEFORM_DATA;
+        std::memcpy(&pointDataRecord.waveformPacketSize, wavePacket, PointDataRecord::NUM_BYTES_WAVEFORM_PACKET_SIZE);
+        wavePacket += PointDataRecord::NUM_BYTES_WAVEFORM_PACKET_SIZE;
+        std::memcpy(&pointDataRecord.returnPointWaveformLocation, wavePacket, PointDataRecord::NUM_BYTES_RETURN_POINT_WAVEFORM_LOCATION);
+        wavePacket += PointDataRecord::NUM_BYTES_RETURN_POINT_WAVEFORM_LOCATION;
+        std::memcpy(&pointDataRecord.Xt, wavePacket, PointDataRecord::NUM_BYTES_X_T);
+        wavePacket += PointDataRecord::NUM_BYTES_X_T;
+        std::memcpy(&pointDataRecord.Yt, wavePacket, PointDataRecord::NUM_BYTES_Y_T);
+        wavePacket += PointDataRecord::NUM_BYTES_Y_T;
+        std::memcpy(&pointDataRecord.Zt, wavePacket, PointDataRecord::NUM_BYTES_Z_T);
+      }
+    }
+  }
+
+  /// @brief Encode a record in the point data record format `FORMAT`. This is the inverse of `decodePointDataRecord`.
+  /// @param pointDataRecord Input record. Attributes which `FORMAT` does not define are ignored.
+  /// @param record Output bytes of at least `PointDataRecordFormat<FORMAT>::SIZE`
+  template <int FORMAT>
+  static inline void encodePointDataRecord(const PointDataRecord& pointDataRecord,
+                                           char* record) {
+    using Format = PointDataRecordFormat<FORMAT>;
+
+    std::memcpy(record + Format::OFFSET_X, &pointDataRecord.x, PointDataRecord::NUM_BYTES_X);
+    std::memcpy(record + Format::OFFSET_Y, &pointDataRecord.y, PointDataRecord::NUM_BYTES_Y);
+    std::memcpy(record + Format::OFFSET_Z, &pointDataRecord.z, PointDataRecord::NUM_BYTES_Z);
+    std::memcpy(record + Format::OFFSET_INTENSITY, &pointDataRecord.intensity, PointDataRecord::NUM_BYTES_INTENSITY);
+
+    const LLAS_UCHAR scanFlags = (LLAS_UCHAR)(((pointDataRecord.scanDirectionFlag & 0x01) << 6) | ((pointDataRecord.edgeOfFlightLine & 0x01) << 7));
+
+    if constexpr (Format::IS_EXTENDED) {
+      record[Format::OFFSET_SENSOR_DATA] = (char)((pointDataRecord.returnNumber & 0x0F) | (pointDataRecord.numberOfReturns << 4));
+      record[Format::OFFSET_SCAN_FLAGS] = (char)((pointDataRecord.classificationFlags & 0x0F) | ((pointDataRecord.scannerChannel & 0x03) << 4) | scanFlags);
+      record[Format::OFFSET_CLASSIFICATION] = (char)pointDataRecord.classification;
+      std::memcpy(record + Format::OFFSET_SCAN_ANGLE, &pointDataRecord.scanAngle, PointDataRecord::NUM_BYTES_SCAN_ANGLE);
+    } else {
+      record[Format::OFFSET_SENSOR_DATA] = (char)((pointDataRecord.returnNumber & 0x07) | ((pointDataRecord.numberOfReturns & 0x07) << 3) | scanFlags);
+      record[Format::OFFSET_CLASSIFICATION] = (char)((pointDataRecord.classification & 0x1F) | (pointDataRecord.classificationFlags << 5));
+      std::memcpy(record + Format::OFFSET_SCAN_ANGLE, &pointDataRecord.scanAngleRank, PointDataRecord::NUM_BYTES_SCAN_ANGLE_RANK);
+    }
+
+    std::memcpy(record + Format::OFFSET_USER_DATA, &pointDataRecord.userData, PointDataRecord::NUM_BYTES_USER_DATA);
+    std::memcpy(record + Format::OFFSET_POINT_SOURCE_ID, &pointDataRecord.pointSourceID, PointDataRecord::NUM_BYTES_POINT_SOURCE_ID);
+
+    if constexpr (Format::HAS_GPS_TIME) {
+      std::memcpy(record + Format::OFFSET_GPS_TIME, &pointDataRecord.GPSTime, PointDataRecord::NUM_BYTES_GPS_TIME);
+    }
+
+    if constexpr (Format::HAS_RGB) {
+      std::memcpy(record + Format::OFFSET_RGB, &pointDataRecord.red, PointDataRecord::NUM_BYTES_RED);
+      std::memcpy(record + Format::OFFSET_RGB + PointDataRecord::NUM_BYTES_RED, &pointDataRecord.green, PointDataRecord::NUM_BYTES_GREEN);
+      std::memcpy(record + Format::OFFSET_RGB + PointDataRecord::NUM_BYTES_RED + PointDataRecord::NUM_BYTES_GREEN, &pointDataRecord.blue, PointDataRecord::NUM_BYTES_BLUE);
+    }
+
+    if constexpr (Format::HAS_NIR) {
+      std::memcpy(record + Format::OFFSET_NIR, &pointDataRecord.NIR, PointDataRecord::NUM_BYTES_NIR);
+    }
+
+    if constexpr (Format::HAS_WAVE_PACKET) {
+      char* wavePacket = record + Format::OFFSET_WAVE_PACKET;
+      std::memcpy(wavePacket, &pointDataRecord.wavePacketDescriptorIndex, PointDataRecord::NUM_BYTES_WAVE_PACKET_DESCRIPTOR_INDEX);
+      wavePacket += PointDataRecord::NUM_BYTES_WAVE_PACKET_DESCRIPTOR_INDEX;
+      std::memcpy(wavePacket, &pointDataRecord.byteOffsetToWaveformData, PointDataRecord::NUM_BYTES_BYTE_OFFSET_TO_WAVEFORM_DATA);
+      wavePacket += PointDataRecord::NUM_BYTES_BYTE_OFFSET_TO_WAVEFORM_DATA;
+      std::memcpy(wavePacket, &pointDataRecord.waveformPacketSize, PointDataRecord::NUM_BYTES_WAVEFORM_PACKET_SIZE);
+      wavePacket += PointDataRecord::NUM_BYTES_WAVEFORM_PACKET_SIZE;
+      std::memcpy(wavePacket, &pointDataRecord.returnPointWaveformLocation, PointDataRecord::NUM_BYTES_RETURN_POINT_WAVEFORM_LOCATION);
+      wavePacket += PointDataRecord::NUM_BYTES_RETURN_POINT_WAVEFORM_LOCATION;
+      std::memcpy(wavePacket, &pointDataRecord.Xt, PointDataRecord::NUM_BYTES_X_T);
+      wavePacket += PointDataRecord::NUM_BYTES_X_T;
+      std::memcpy(wavePacket, &pointDataRecord.Yt, PointDataRecord::NUM_BYTES_Y_T);
+      wavePacket += PointDataRecord::NUM_BYTES_Y_T;
+      std::memcpy(wavePacket, &pointDataRecord.Zt, PointDataRecord::NUM_BYTES_Z_T);
+    }
+  }
+
+  static PointDataRecord readPointDataRecord(const char* byteData,
+                                             std::streamsize& offset,
+                                             const LLAS_UCHAR& format,
+                                             const LLAS_ULONG fields = PointField::ALL) {
+    PointDataRecord pointDataRecord;
+    readPointDataRecord(byteData, offset, format, fields, pointDataRecord);
+    return pointDataRecord;
+  }
+
+  /// @brief Decode a record in place. Attributes outside `fields` are left untouched.
+  /// @note This resolves the format for every call. Use `readPointDataRecords` to decode many records.
+  static void readPointDataRecord(const char* byteData,
+                                  std::streamsize& offset,
+                                  const LLAS_UCHAR& format,
+                                  const LLAS_ULONG fields,
+                                  PointDataRecord& pointDataRecord) {
+    const bool isSupported = visitPointDataRecordFormat(format, [&](auto formatTag) {
+      constexpr int FORMAT = decltype(formatTag)::value;
+      decodePointDataRecord<FORMAT>(byteData + offset, fields, pointDataRecord);
+      offset += PointDataRecordFormat<FORMAT>::SIZE;
+    });
+
+    if (!isSupported) {
+      _LLAS_logError("Unsupported point data record format: " + std::to_string((int)format));
+    }
+  }
+};
+
+/// @brief Memory layout of decoded 'Point Data Records'
+enum class PointDataLayout {
+  ArrayOfStructs,  // `LasData::pointDataRecords`
+  StructOfArrays,  // `LasData::pointDataColumns`
+  Packed,          // `LasData::packedPointData`
+};
+
+/// @brief Bit depth of the values in the 16-bit color channels
+enum class ColorDepth {
+  Auto,    // `Bits8` if no channel of any point exceeds 255 (`LasData::getColorDepth`), otherwise `Bits16`
+  Bits8,   // 8-bit values, as written by some software contrary to the specification
+  Bits16,  // Full 16-bit range
+};
+
+/// @brief Order of points for `LasData::sortPoints`
+enum class PointOrder {
+  Morton,   // Z-order curve of the integer coordinates, which keeps nearby points close in memory
+  GPSTime,  // Ascending GPS time
+};
+
+/// @brief 'Point Data Records' stored as one contiguous array per attribute (structure of arrays).
+///        Columns which the point data record format does not define or which were not requested are left empty.
+struct PointDataColumns {
+  PointDataColumns()
+      : nPoints(),
+        format(),
+        fields(),
+        x(),
+        y(),
+        z(),
+        intensity(),
+        returnNumber(),
+        numberOfReturns(),
+        classification(),
+        classificationFlags(),
+        scannerChannel(),
+        scanDirectionFlag(),
+        edgeOfFlightLine(),
+        scanAngleRank(),
+        scanAngle(),
+        userData(),
+        pointSourceID(),
+        GPSTime(),
+        red(),
+        green(),
+        blue(),
+        NIR(),
+        wavePacketDescriptorIndex(),
+        byteOffsetToWaveformData(),
+        waveformPacketSize(),
+        returnPointWaveformLocation(),
+        Xt(),
+        Yt(),
+        Zt() {}
+
+  // clang-format off
+  size_t                   nPoints;
+  LLAS_UCHAR               format;   // Point data record format
+  LLAS_ULONG               fields;   // Stored attributes (`PointField`)
+  std::vector<LLAS_LONG>   x;
+  std::vector<LLAS_LONG>   y;
+  std::vector<LLAS_LONG>   z;
+  std::vector<LLAS_USHORT> intensity;
+  std::vector<LLAS_UCHAR>  returnNumber;
+  std::vector<LLAS_UCHAR>  numberOfReturns;
+  std::vector<LLAS_UCHAR>  classification;
+  std::vector<LLAS_UCHAR>  classificationFlags;
+  std::vector<LLAS_UCHAR>  scannerChannel;    // Formats 6 to 10 only
+  std::vector<LLAS_UCHAR>  scanDirectionFlag;
+  std::vector<LLAS_UCHAR>  edgeOfFlightLine;
+  std::vector<LLAS_SCHAR>  scanAngleRank;     // Formats 0 to 5 only
+  std::vector<LLAS_SHORT>  scanAngle;         // Formats 6 to 10 only
+  std::vector<LLAS_UCHAR>  userData;
+  std::vector<LLAS_USHORT> pointSourceID;
+  std::vector<LLAS_DOUBLE> GPSTime;
+  std::vector<LLAS_USHORT> red;
+  std::vector<LLAS_USHORT> green;
+  std::vector<LLAS_USHORT> blue;
+  std::vector<LLAS_USHORT> NIR;
+  std::vector<LLAS_UCHAR>  wavePacketDescriptorIndex;
+  std::vector<LLAS_ULLONG> byteOffsetToWaveformData;
+  std::vector<LLAS_ULONG>  waveformPacketSize;
+  std::vector<LLAS_FLOAT>  returnPointWaveformLocation;
+  std::vector<LLAS_FLOAT>  Xt;
+  std::vector<LLAS_FLOAT>  Yt;
+  std::vector<LLAS_FLOAT>  Zt;
+  // clang-format on
+
+  inline size_t size() const {
+    return nPoints;
+  }
+
+  inline bool hasXYZ() const {
+    return fields & PointField::XYZ;
+  }
+
+  inline bool hasGPSTime() const {
+    return fields & PointField::GPS_TIME;
+  }
+
+  inline bool hasRGB() const {
+    return fields & PointField::RGB;
+  }
+
+  inline bool hasNIR() const {
+    return fields & PointField::NIR;
+  }
+
+  inline bool hasWavePacket() const {
+    return fields & PointField::WAVE_PACKET;
+  }
+
+  /// @brief Allocate the columns defined by the point data record format and requested by `fields_`
+  /// @param nPoints_ Number of points
+  /// @param format_ Point data record format
+  /// @param fields_ Attributes to store (`PointField`)
+  inline void resize(const size_t nPoints_,
+                     const LLAS_UCHAR& format_,
+                     const LLAS_ULONG fields_ = PointField::ALL) {
+    fields = fields_ & PointDataRecord::getFormatFields(format_);
+
+    nPoints = nPoints_;
+    format = format_;
+
+    const bool isExtended = PointDataRecord::isExtendedFormat(format);
+    const size_t nReturns = fields & PointField::RETURNS ? nPoints : 0;
+    const size_t nClassifications = fields & PointField::CLASSIFICATION ? nPoints : 0;
+    const size_t nScanFlags = fields & PointField::SCAN_FLAGS ? nPoints : 0;
+    const size_t nScanAngles = fields & PointField::SCAN_ANGLE ? nPoints : 0;
+    const size_t nWavePackets = hasWavePacket() ? nPoints : 0;
+
+    x.resize(fields & PointField::X ? nPoints : 0);
+    y.resize(fields & PointField::Y ? nPoints : 0);
+    z.resize(fields & PointField::Z ? nPoints : 0);
+    intensity.resize(fields & PointField::INTENSITY ? nPoints : 0);
+    returnNumber.resize(nReturns);
+    numberOfReturns.resize(nReturns);
+    classification.resize(nClassifications);
+    classificationFlags.resize(nClassifications);
+    scannerChannel.resize(isExtended ? nScanFlags : 0);
+    scanDirectionFlag.resize(nScanFlags);
+    edgeOfFlightLine.resize(nScanFlags);
+    scanAngleRank.resize(isExtended ? 0 : nScanAngles);
+    scanAngle.resize(isExtended ? nScanAngles : 0);
+    userData.resize(fields & PointField::USER_DATA ? nPoints : 0);
+    pointSourceID.resize(fields & PointField::POINT_SOURCE_ID ? nPoints : 0);
+    GPSTime.resize(hasGPSTime() ? nPoints : 0);
+    red.resize(hasRGB() ? nPoints : 0);
+    green.resize(hasRGB() ? nPoints : 0);
+    blue.resize(hasRGB() ? nPoints : 0);
+    NIR.resize(hasNIR() ? nPoints : 0);
+    wavePacketDescriptorIndex.resize(nWavePackets);
+    byteOffsetToWaveformData.resize(nWavePackets);
+    waveformPacketSize.resize(nWavePackets);
+    returnPointWaveformLocation.resize(nWavePackets);
+    Xt.resize(nWavePackets);
+    Yt.resize(nWavePackets);
+    Zt.resize(nWavePackets);
+  }
+
+  /// @brief Release all columns
+  inline void clear() {
+    *this = PointDataColumns();
+  }
+
+  /// @brief Get the number of bytes allocated for the columns
+  inline size_t getMemorySize() const {
+    return _getColumnSize(x) + _getColumnSize(y) + _getColumnSize(z) + _getColumnSize(intensity) +
+           _getColumnSize(returnNumber) + _getColumnSize(numberOfReturns) + _getColumnSize(classification) + _getColumnSize(classificationFlags) +
+           _getColumnSize(scannerChannel) + _getColumnSize(scanDirectionFlag) + _getColumnSize(edgeOfFlightLine) + _getColumnSize(scanAngleRank) +
+           _getColumnSize(scanAngle) + _getColumnSize(userData) + _getColumnSize(pointSourceID) + _getColumnSize(GPSTime) +
+           _getColumnSize(red) + _getColumnSize(green) + _getColumnSize(blue) + _getColumnSize(NIR) +
+           _getColumnSize(wavePacketDescriptorIndex) + _getColumnSize(byteOffsetToWaveformData) + _getColumnSize(waveformPacketSize) +
+           _getColumnSize(returnPointWaveformLocation) + _getColumnSize(Xt) + _getColumnSize(Yt) + _getColumnSize(Zt);
+  }
+
+  /// @brief Copy `nCopied` points from `sourceIndex` of `source`, whose format must be the same, to `index`.
+  ///        Columns which `source` does not store are left as they are.
+  inline void copy(const PointDataColumns& source,
+                   const size_t sourceIndex,
+                   const size_t nCopied,
+                   const size_t index) {
+    _copyColumn(source.x, sourceIndex, nCopied, index, x);
+    _copyColumn(source.y, sourceIndex, nCopied, index, y);
+    _copyColumn(source.z, sourceIndex, nCopied, index, z);
+    _copyColumn(source.intensity, sourceIndex, nCopied, index, intensity);
+    _copyColumn(source.returnNumber, sourceIndex, nCopied, index, returnNumber);
+    _copyColumn(source.numberOfReturns, sourceIndex, nCopied, index, numberOfReturns);
+    _copyColumn(source.classification, sourceIndex, nCopied, index, classification);
+    _copyColumn(source.classificationFlags, sourceIndex, nCopied, index, classificationFlags);
+    _copyColumn(source.scannerChannel, sourceIndex, nCopied, index, scannerChannel);
+    _copyColumn(source.scanDirectionFlag, sourceIndex, nCopied, index, scanDirectionFlag);
+    _copyColumn(source.edgeOfFlightLine, sourceIndex, nCopied, index, edgeOfFlightLine);
+    _copyColumn(source.scanAngleRank, sourceIndex, nCopied, index, scanAngleRank);
+    _copyColumn(source.scanAngle, sourceIndex, nCopied, index, scanAngle);
+    _copyColumn(source.userData, sourceIndex, nCopied, index, userData);
+    _copyColumn(source.pointSourceID, sourceIndex, nCopied, index, pointSourceID);
+    _copyColumn(source.GPSTime, sourceIndex, nCopied, index, GPSTime);
+    _copyColumn(source.red, sourceIndex, nCopied, index, red);
+    _copyColumn(source.green, sourceIndex, nCopied, index, green);
+    _copyColumn(source.blue, sourceIndex, nCopied, index, blue);
+    _copyColumn(source.NIR, sourceIndex, nCopied, index, NIR);
+    _copyColumn(source.wavePacketDescriptorIndex, sourceIndex, nCopied, index, wavePacketDescriptorIndex);
+    _copyColumn(source.byteOffsetToWaveformData, sourceIndex, nCopied, index, byteOffsetToWaveformData);
+    _copyColumn(source.waveformPacketSize, sourceIndex, nCopied, index, waveformPacketSize);
+    _copyColumn(source.returnPointWaveformLocation, sourceIndex, nCopied, index, returnPointWaveformLocation);
+    _copyColumn(source.Xt, sourceIndex, nCopied, index, Xt);
+    _copyColumn(source.Yt, sourceIndex, nCopied, index, Yt);
+    _copyColumn(source.Zt, sourceIndex, nCopied, index, Zt);
+  }
+
+  /// @brief Store a decoded record at `index`
+  inline void set(const size_t index, const PointDataRecord& pointDataRecord) {
+    if (fields & PointField::X) {
+      x[index] = pointDataRecord.x;
+    }
+    if (fields & PointField::Y) {
+      y[index] = pointDataRecord.y;
+    }
+    if (fields & PointField::Z) {
+      z[index] = pointDataRecord.z;
+    }
+    if (fields & PointField::INTENSITY) {
+      intensity[index] = pointDataRecord.intensity;
+    }
+    if (fields & PointField::RETURNS) {
+      returnNumber[index] = pointDataRecord.returnNumber;
+      numberOfReturns[index] = pointDataRecord.numberOfReturns;
+    }
+    if (fields & PointField::CLASSIFICATION) {
+      classification[index] = pointDataRecord.classification;
+      classificationFlags[index] = pointDataRecord.classificationFlags;
+    }
+    if (fields & PointField::SCAN_FLAGS) {
+      if (!scannerChannel.empty()) {
+        scannerChannel[index] = pointDataRecord.scannerChannel;
+      }
+      scanDirectionFlag[index] = pointDataRecord.scanDirectionFlag;
+      edgeOfFlightLine[index] = pointDataRecord.edgeOfFlightLine;
+    }
+    if (fields & PointField::SCAN_ANGLE) {
+      if (scanAngle.empty()) {
+        scanAngleRank[index] = pointDataRecord.scanAngleRank;
+      } else {
+        scanAngle[index] = pointDataRecord.scanAngle;
+      }
+    }
+    if (fields & PointField::USER_DATA) {
+      userData[index] = pointDataRecord.userData;
+    }
+    if (fields & PointField::POINT_SOURCE_ID) {
+      pointSourceID[index] = pointDataRecord.pointSourceID;
+    }
+    if (hasGPSTime()) {
+      GPSTime[index] = pointDataRecord.GPSTime;
+    }
+    if (hasRGB()) {
+      red[index] = pointDataRecord.red;
+      green[index] = pointDataRecord.green;
+      blue[index] = pointDataRecord.blue;
+    }
+    if (hasNIR()) {
+      NIR[index] = pointDataRecord.NIR;
+    }
+    if (hasWavePacket()) {
+      wavePacketDescriptorIndex[index] = pointDataRecord.wavePacketDescriptorIndex;
+      byteOffsetToWaveformData[index] = pointDataRecord.byteOffsetToWaveformData;
+      waveformPacketSize[index] = pointDataRecord.waveformPacketSize;
+      returnPointWaveformLocation[index] = pointDataRecord.returnPointWaveformLocation;
+      Xt[index] = pointDataRecord.Xt;
+      Yt[index] = pointDataRecord.Yt;
+      Zt[index] = pointDataRecord.Zt;
+    }
+  }
+
+  /// @brief Gather the record at `index`. Attributes without a column are zero.
+  inline PointDataRecord get(const size_t index) const {
+    PointDataRecord pointDataRecord;
+    if (fields & PointField::X) {
+      pointDataRecord.x = x[index];
+    }
+    if (fields & PointField::Y) {
+      pointDataRecord.y = y[index];
+    }
+    if (fields & PointField::Z) {
+      pointDataRecord.z = z[index];
+    }
+    if (fields & PointField::INTENSITY) {
+      pointDataRecord.intensity = intensity[index];
+    }
+    if (fields & PointField::RETURNS) {
+      pointDataRecord.returnNumber = returnNumber[index];
+      pointDataRecord.numberOfReturns = numberOfReturns[index];
+    }
+    if (fields & PointField::CLASSIFICATION) {
+      pointDataRecord.classification = classification[index];
+      pointDataRecord.classificationFlags = classificationFlags[index];
+    }
+    if (fields & PointField::SCAN_FLAGS) {
+      if (!scannerChannel.empty()) {
+        pointDataRecord.scannerChannel = scannerChannel[index];
+      }
+      pointDataRecord.scanDirectionFlag = scanDirectionFlag[index];
+      pointDataRecord.edgeOfFlightLine = edgeOfFlightLine[index];
+    }
+    if (fields & PointField::SCAN_ANGLE) {
+      if (scanAngle.empty()) {
+        pointDataRecord.scanAngleRank = scanAngleRank[index];
+      } else {
+        pointDataRecord.scanAngle = scanAngle[index];
+      }
+    }
+    if (fields & PointField::USER_DATA) {
+      pointDataRecord.userData = userData[index];
+    }
+    if (fields & PointField::POINT_SOURCE_ID) {
+      pointDataRecord.pointSourceID = pointSourceID[index];
+    }
+    if (hasGPSTime()) {
+      pointDataRecord.GPSTime = GPSTime[index];
+    }
+    if (hasRGB()) {
+      pointDataRecord.red = red[index];
+      pointDataRecord.green = green[index];
+      pointDataRecord.blue = blue[index];
+    }
+    if (hasNIR()) {
+      pointDataRecord.NIR = NIR[index];
+    }
+    if (hasWavePacket()) {
+      pointDataRecord.wavePacketDescriptorIndex = wavePacketDescriptorIndex[index];
+      pointDataRecord.byteOffsetToWaveformData = byteOffsetToWaveformData[index];
+      pointDataRecord.waveformPacketSize = waveformPacketSize[index];
+      pointDataRecord.returnPointWaveformLocation = returnPointWaveformLocation[index];
+      pointDataRecord.Xt = Xt[index];
+      pointDataRecord.Yt = Yt[index];
+      pointDataRecord.Zt = Zt[index];
+    }
+    return pointDataRecord;
+  }
+
+  /// @brief Rearrange the points so that the point at `indices[i]` moves to `i`. Points not in `indices` are removed.
+  /// @param indices Indices of the points in their new order
+  /// @param nThreads Number of threads. `0` means all hardware threads.
+  inline void reorder(const std::vector<size_t>& indices,
+                      const size_t nThreads = 1) {
+    _reorderColumn(x, indices, nThreads);
+    _reorderColumn(y, indices, nThreads);
+    _reorderColumn(z, indices, nThreads);
+    _reorderColumn(intensity, indices, nThreads);
+    _reorderColumn(returnNumber, indices, nThreads);
+    _reorderColumn(numberOfReturns, indices, nThreads);
+    _reorderColumn(classification, indices, nThreads);
+    _reorderColumn(classificationFlags, indices, nThreads);
+    _reorderColumn(scannerChannel, indices, nThreads);
+    _reorderColumn(scanDirectionFlag, indices, nThreads);
+    _reorderColumn(edgeOfFlightLine, indices, nThreads);
+    _reorderColumn(scanAngleRank, indices, nThreads);
+    _reorderColumn(scanAngle, indices, nThreads);
+    _reorderColumn(userData, indices, nThreads);
+    _reorderColumn(pointSourceID, indices, nThreads);
+    _reorderColumn(GPSTime, indices, nThreads);
+    _reorderColumn(red, indices, nThreads);
+    _reorderColumn(green, indices, nThreads);
+    _reorderColumn(blue, indices, nThreads);
+    _reorderColumn(NIR, indices, nThreads);
+    _reorderColumn(wavePacketDescriptorIndex, indices, nThreads);
+    _reorderColumn(byteOffsetToWaveformData, indices, nThreads);
+    _reorderColumn(waveformPacketSize, indices, nThreads);
+    _reorderColumn(returnPointWaveformLocation, indices, nThreads);
+    _reorderColumn(Xt, indices, nThreads);
+    _reorderColumn(Yt, indices, nThreads);
+    _reorderColumn(Zt, indices, nThreads);
+    nPoints = indices.size();
+  }
+
+  template <class T>
+  static inline void _reorderColumn(std::vector<T>& column,
+                                    const std::vector<size_t>& indices,
+                                    const size_t nThreads) {
+    if (column.empty()) {
+      return;
+    }
+
+    std::vector<T> reordered(indices.size());
+    parallelFor(indices.size(), nThreads, [&](const size_t begin, const size_t end) {
+      for (size_t i = begin; i < end; ++i) {
+        reordered[i] = column[indices[i]];
+      }
+    });
+    column.swap(reordered);
+  }
+
+  template <class T>
+  static inline void _copyColumn(const std::vector<T>& source,
+                                 const size_t sourceIndex,
+                                 const size_t nCopied,
+                                 const size_t index,
+                                 std::vector<T>& column) {
+    if (source.empty() || column.empty()) {
+      return;
+    }
+    std::copy(source.begin() + sourceIndex, source.begin() + sourceIndex + nCopied, column.begin() + index);
+  }
+
+  template <class T>
+  static inline size_t _getColumnSize(const std::vector<T>& column) {
+    return column.capacity() * sizeof(T);
+  }
+};
+
+/// @brief 'Point Data Records' kept in the byte layout of their point data record format and decoded on demand.
+///        Only the fields defined by the format are stored (e.g. 20 bytes per point for format 0), without extra bytes.
+struct PackedPointData {
+  PackedPointData()
+      : nPoints(),
+        format(),
+        recordSize(),
+        bytes(),
+        _offsetClassification(),
+        _offsetGPSTime(),
+        _offsetRGB() {}
+
+  // clang-format off
+  size_t            nPoints;
+  LLAS_UCHAR        format;      // Point data record format
+  LLAS_USHORT       recordSize;  // Size of the fields defined by `format`
+  std::vector<char> bytes;       // `nPoints * recordSize` bytes
+  // clang-format on
+
+  inline size_t size() const {
+    return nPoints;
+  }
+
+  inline bool hasGPSTime() const {
+    return PointDataRecord::hasGPSTime(format);
+  }
+
+  inline bool hasRGB() const {
+    return PointDataRecord::hasRGB(format);
+  }
+
+  /// @brief Allocate the records
+  /// @param nPoints_ Number of points
+  /// @param format_ Point data record format
+  /// @return `true` if the format is supported
+  inline bool resize(const size_t nPoints_,
+                     const LLAS_UCHAR& format_) {
+    const bool isSupported = visitPointDataRecordFormat(format_, [&](auto formatTag) {
+      using Format = PointDataRecordFormat<decltype(formatTag)::value>;
+      recordSize = (LLAS_USHORT)Format::SIZE;
+      _offsetClassification = (LLAS_USHORT)Format::OFFSET_CLASSIFICATION;
+      _offsetGPSTime = (LLAS_USHORT)Format::OFFSET_GPS_TIME;
+      _offsetRGB = (LLAS_USHORT)Format::OFFSET_RGB;
+    });
+    if (!isSupported) {
+      _LLAS_logError("Unsupported point data record format: " + std::to_string((int)format_));
+      return false;
+    }
+
+    nPoints = nPoints_;
+    format = format_;
+    bytes.resize(nPoints * recordSize);
+    return true;
+  }
+
+  /// @brief Release all records
+  inline void clear() {
+    *this = PackedPointData();
+  }
+
+  /// @brief Get the bytes of the record at `index`
+  inline const char* getRecord(const size_t index) const {
+    return bytes.data() + index * recordSize;
+  }
+
+  inline char* getRecord(const size_t index) {
+    return bytes.data() + index * recordSize;
+  }
+
+  /// @brief Decode the record at `index`
+  inline PointDataRecord get(const size_t index) const {
+    PointDataRecord pointDataRecord;
+    visitPointDataRecordFormat(format, [&](auto formatTag) {
+      PointDataRecord::decodePointDataRecord<decltype(formatTag)::value>(getRecord(index), PointField::ALL, pointDataRecord);
+    });
+    return pointDataRecord;
+  }
+
+  /// @brief Encode a record at `index`. Attributes which the format does not define are dropped.
+  inline void set(const size_t index, const PointDataRecord& pointDataRecord) {
+    visitPointDataRecordFormat(format, [&](auto formatTag) {
+      PointDataRecord::encodePointDataRecord<decltype(formatTag)::value>(pointDataRecord, getRecord(index));
+    });
+  }
+
+  // NOTE: The accessors below read a single attribute at an offset resolved by `resize` without decoding the whole record
+
+  /// @brief Get the integer coordinates `[x, y, z]` of the record at `index`
+  inline std::array<LLAS_LONG, 3> getCoords(const size_t index) const {
+    std::array<LLAS_LONG, 3> coords;
+    std::memcpy(coords.data(), getRecord(index), PointDataRecord::NUM_BYTES_X + PointDataRecord::NUM_BYTES_Y + PointDataRecord::NUM_BYTES_Z);
+    return coords;
+  }
+
+  /// @brief Set the integer coordinates `[x, y, z]` of the record at `index`
+  inline void setCoords(const size_t index,
+                        const std::array<LLAS_LONG, 3>& coords) {
+    std::memcpy(getRecord(index), coords.data(), PointDataRecord::NUM_BYTES_X + PointDataRecord::NUM_BYTES_Y + PointDataRecord::NUM_BYTES_Z);
+  }
+
+  inline LLAS_USHORT getIntensity(const size_t index) const {
+    LLAS_USHORT intensity;
+    std::memcpy(&intensity, getRecord(index) + PointDataRecordFormat<0>::OFFSET_INTENSITY, PointDataRecord::NUM_BYTES_INTENSITY);
+    return intensity;
+  }
+
+  inline LLAS_UCHAR getReturnNumber(const size_t index) const {
+    const LLAS_UCHAR returns = (LLAS_UCHAR)getRecord(index)[PointDataRecordFormat<0>::OFFSET_SENSOR_DATA];
+    return PointDataRecord::isExtendedFormat(format) ? returns & 0x0F : returns & 0x07;
+  }
+
+  /// @brief Get the class without the flags of formats 0 to 5, like `PointDataRecord::classification`
+  inline LLAS_UCHAR getClassification(const size_t index) const {
+    const LLAS_UCHAR classification = (LLAS_UCHAR)getRecord(index)[_offsetClassification];
+    return PointDataRecord::isExtendedFormat(format) ? classification : classification & 0x1F;
+  }
+
+  /// @return `GPS time` (`LLAS_DOUBLE`): 0 if the format has no GPS time
+  inline LLAS_DOUBLE getGPSTime(const size_t index) const {
+    LLAS_DOUBLE GPSTime = 0.0;
+    if (hasGPSTime()) {
+      std::memcpy(&GPSTime, getRecord(index) + _offsetGPSTime, PointDataRecord::NUM_BYTES_GPS_TIME);
+    }
+    return GPSTime;
+  }
+
+  /// @return `RGB` (`std::array<LLAS_USHORT, 3>`): zero if the format has no colors
+  inline std::array<LLAS_USHORT, 3> getRGB(const size_t index) const {
+    std::array<LLAS_USHORT, 3> rgb = {0, 0, 0};
+    if (hasRGB()) {
+      std::memcpy(rgb.data(), getRecord(index) + _offsetRGB, PointDataRecord::NUM_BYTES_RED + PointDataRecord::NUM_BYTES_GREEN + PointDataRecord::NUM_BYTES_BLUE);
+    }
+    return rgb;
+  }
+
+  /// @brief Rearrange the points so that the point at `indices[i]` moves to `i`. Points not in `indices` are removed.
+  /// @param indices Indices of the points in their new order
+  /// @param nThreads Number of threads. `0` means all hardware threads.
+  inline void reorder(const std::vector<size_t>& indices,
+                      const size_t nThreads = 1) {
+    std::vector<char> reordered(indices.size() * recordSize);
+    parallelFor(indices.size(), nThreads, [&](const size_t begin, const size_t end) {
+      for (size_t i = begin; i < end; ++i) {
+        std::memcpy(reordered.data() + i * recordSize, getRecord(indices[i]), recordSize);
+      }
+    });
+    bytes.swap(reordered);
+    nPoints = indices.size();
+  }
+
+  LLAS_USHORT _offsetClassification;
+  LLAS_USHORT _offsetGPSTime;
+  LLAS_USHORT _offsetRGB;
+};
+
+struct ExtendedVariableLengthRecord {
+  // clang-format off
+  inline static const std::streamsize NUM_BYTES_RESERVED                                            = 2;
+  inline static const std::streamsize NUM_BYTES_USER_ID                                             = 16;
+  inline static const std::streamsize NUM_BYTES_RECORD_ID                                           = 2;
+  inline static const std::streamsize NUM_BYTES_RECORD_LENGTH_AFTER_HEADER                          = 8;
+  inline static const std::streamsize NUM_BYTES_DESCPIPTION                                         = 32;
+  inline static const std::streamsize NUM_BYTES_HEADER                                              = 60;
+  // clang-format on
+
+  ExtendedVariableLengthRecord()
+      : reserved(),
+        userID(),
+        recordID(),
+        recordLengthAfterHeader(),
+        description(),
+        record() {}
+
+  // clang-format off
+  LLAS_USHORT       reserved;
+  LLAS_CHAR         userID[NUM_BYTES_USER_ID + 1];          // plus null-termination
+  LLAS_USHORT       recordID;
+  LLAS_ULLONG       recordLengthAfterHeader;
+  LLAS_CHAR         description[NUM_BYTES_DESCPIPTION + 1]; // plus null-termination
+  RecordBytes       record;
+  // clang-format on
+
+  static ExtendedVariableLengthRecord readExtendedVariableLengthRecord(const std::vector<char>& fileBytes,
+                                                                       std::streamsize& offset) {
+    return readExtendedVariableLengthRecord(fileBytes.data(), offset);
+  }
+
+  static ExtendedVariableLengthRecord readExtendedVariableLengthRecord(const char* data,
+                                                                       std::streamsize& offset) {
+    return readExtendedVariableLengthRecord(data, offset, nullptr, 0);
+  }
+
+  /// @brief Read the record at `offset` and advance `offset` past it
+  /// @param arena Copy of `data` from `arenaOffset` on which the payload refers to. The payload is copied if `nullptr`.
+  /// @param arenaOffset Offset of `arena` in `data`
+  static ExtendedVariableLengthRecord readExtendedVariableLengthRecord(const char* data,
+                                                                       std::streamsize& offset,
+                                                                       const RecordBytes::Arena& arena,
+                                                                       const std::streamsize arenaOffset) {
+    ExtendedVariableLengthRecord evlr;
+
+    {
+      // Reserved
+      const std::streamsize nBytes = ExtendedVariableLengthRecord::NUM_BYTES_RESERVED;
+      std::memcpy(&evlr.reserved, data + offset, nBytes);
+      offset += nBytes;
+    }
+
+    {
+      // User ID
+      const std::streamsize nBytes = ExtendedVariableLengthRecord::NUM_BYTES_USER_ID;
+      std::memcpy(&evlr.userID, data + offset, nBytes);
+      offset += nBytes;
+    }
+
+    {
+      // Record ID
+      const std::streamsize nBytes = ExtendedVariableLengthRecord::NUM_BYTES_RECORD_ID;
+      std::memcpy(&evlr.recordID, data + offset, nBytes);
+      offset += nBytes;
+    }
+
+    {
+      // Record Length After Header
+      const std::streamsize nBytes = ExtendedVariableLengthRecord::NUM_BYTES_RECORD_LENGTH_AFTER_HEADER;
+      std::memcpy(&evlr.recordLengthAfterHeader, data + offset, nBytes);
+      offset += nBytes;
+    }
+
+    {
+      // Description
+      const std::streamsize nBytes = ExtendedVariableLengthRecord::NUM_BYTES_DESCPIPTION;
+      std::memcpy(&evlr.description, data + offset, nBytes);
+      offset += nBytes;
+    }
+
+    {
+      // Record
+      const std::streamsize nBytes = (std::streamsize)evlr.recordLengthAfterHeader;
+      if (arena != nullptr) {
+        evlr.record = RecordBytes(arena, (size_t)(offset - arenaOffset), (size_t)nBytes);
+      } else {
+        evlr.record = RecordBytes(data + offset, (size_t)nBytes);
+      }
+      offset += nBytes;
+    }
+
+    return evlr;
+  }
+
+  /// @brief Write the record at `offset` and advance `offset` past it. 'Record Length After Header' is the size of `record`.
+  /// @param data Output buffer of at least `NUM_BYTES_HEADER + record.size()` bytes after `offset`
+  void writeExtendedVariableLengthRecord(char* data,
+                                         std::streamsize& offset) const {
+    const LLAS_ULLONG recordLengthAfterHeader_ = (LLAS_ULLONG)record.size();
+
+    {
+      // Reserved
+      const std::streamsize nBytes = ExtendedVariableLengthRecord::NUM_BYTES_RESERVED;
+      std::memcpy(data + offset, &reserved, nBytes);
+      offset += nBytes;
+    }
+
+    {
+      // User ID
+      const std::streamsize nBytes = ExtendedVariableLengthRecord::NUM_BYTES_USER_ID;
+      std::memcpy(data + offset, &userID, nBytes);
+      offset += nBytes;
+    }
+
+    {
+      // Record ID
+      const std::streamsize nBytes = ExtendedVariableLengthRecord::NUM_BYTES_RECORD_ID;
+      std::memcpy(data + offset, &recordID, nBytes);
+      offset += nBytes;
+    }
+
+    {
+      // Record Length After Header
+      const std::streamsize nBytes = ExtendedVariableLengthRecord::NUM_BYTES_RECORD_LENGTH_AFTER_HEADER;
+      std::memcpy(data + offset, &recordLengthAfterHeader_, nBytes);
+      offset += nBytes;
+    }
+
+    {
+      // Description
+      const std::streamsize nBytes = ExtendedVariableLengthRecord::NUM_BYTES_DESCPIPTION;
+      std::memcpy(data + offset, &description, nBytes);
+      offset += nBytes;
+    }
+
+    {
+      // Record
+      std::copy(record.begin(), record.end(), data + offset);
+      offset += (std::streamsize)record.size();
+    }
+  }
+};
+
+/// @brief Statistics of the points of `LasData` (`LasData::getStatistics`)
+struct PointStatistics {
+  PointStatistics()
+      : nPoints(),
+        fields(),
+        minCoords(),
+        maxCoords(),
+        minBound(),
+        maxBound(),
+        classificationCounts(),
+        returnNumberCounts(),
+        minIntensity(),
+        maxIntensity(),
+        minGPSTime(),
+        maxGPSTime() {}
+
+  // clang-format off
+  size_t                       nPoints;
+  LLAS_ULONG                   fields;                // Attributes which were available (`PointField`). Coordinates which were not decoded count as zero.
+  std::array<LLAS_LONG, 3>     minCoords;             // Integer coordinates
+  std::array<LLAS_LONG, 3>     maxCoords;
+  math::vec3d_t                minBound;              // World coordinates
+  math::vec3d_t                maxBound;
+  std::array<LLAS_ULLONG, 256> classificationCounts;  // Number of points of every class
+  std::array<LLAS_ULLONG, 16>  returnNumberCounts;    // Number of points of every return number
+  LLAS_USHORT                  minIntensity;
+  LLAS_USHORT                  maxIntensity;
+  LLAS_DOUBLE                  minGPSTime;
+  LLAS_DOUBLE                  maxGPSTime;
+  // clang-format on
+
+  /// @brief Check whether the number of points is the number of point records in `header`
+  inline bool matchesPointCount(const PublicHeader& header) const {
+    return (LLAS_ULLONG)nPoints == header.getNumPointRecords();
+  }
+
+  /// @brief Check whether the bounds are the bounds in `header` up to one integer unit of the scale factors
+  inline bool matchesBounds(const PublicHeader& header) const {
+    if ((fields & PointField::XYZ) != PointField::XYZ || nPoints == 0) {
+      return true;
+    }
+
+    const math::vec3d_t tolerances = {std::abs(header.xScaleFactor), std::abs(header.yScaleFactor), std::abs(header.zScaleFactor)};
+    const math::vec3d_t headerMinBound = {header.minX, header.minY, header.minZ};
+    const math::vec3d_t headerMaxBound = {header.maxX, header.maxY, header.maxZ};
+    for (size_t iAxis = 0; iAxis < 3; ++iAxis) {
+      if (std::abs(minBound[iAxis] - headerMinBound[iAxis]) > tolerances[iAxis] || std::abs(maxBound[iAxis] - headerMaxBound[iAxis]) > tolerances[iAxis]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /// @brief Check whether the numbers of points by return are the ones in `header`.
+  ///        The legacy counts (returns 1 to 5) are compared if `header` has a legacy point count,
+  ///        and the 64-bit counts (returns 1 to 15) if `header` has a 64-bit point count.
+  inline bool matchesReturnCounts(const PublicHeader& header) const {
+    if (!(fields & PointField::RETURNS)) {
+      return true;
+    }
+
+    if (header.legacyNumOfPointRecords != 0) {
+      for (size_t iReturn = 0; iReturn < 5; ++iReturn) {
+        if ((LLAS_ULLONG)header.legacyNumOfPointByReturn[iReturn] != std::min<LLAS_ULLONG>(returnNumberCounts[iReturn + 1], std::numeric_limits<LLAS_ULONG>::max())) {
+          return false;
+        }
+      }
+    }
+
+    if (header.hasNumOfPointsByReturn && header.numOfPointRecords != 0) {
+      for (size_t iReturn = 0; iReturn < 15; ++iReturn) {
+        if (header.numOfPointsByReturn[iReturn] != returnNumberCounts[iReturn + 1]) {
+          return false;
+        }
+      }
+    }
+
+    return true;
+  }
+
+  /// @brief Check the number of points, the bounds and the numbers of points by return against `header`
+  inline bool matchesHeader(const PublicHeader& header) const {
+    return matchesPointCount(header) && matchesBounds(header) && matchesReturnCounts(header);
+  }
+
+  /// @brief Merge the statistics of other points
+  inline void merge(const PointStatistics& other) {
+    if (other.nPoints == 0) {
+      return;
+    }
+    if (nPoints == 0) {
+      *this = other;
+      return;
+    }
+
+    nPoints += other.nPoints;
+    fields &= other.fields;
+    for (size_t iAxis = 0; iAxis < 3; ++iAxis) {
+      minCoords[iAxis] = std::min(minCoords[iAxis], other.minCoords[iAxis]);
+      maxCoords[iAxis] = std::max(maxCoords[iAxis], other.maxCoords[iAxis]);
+      minBound[iAxis] = std::min(minBound[iAxis], other.minBound[iAxis]);
+      maxBound[iAxis] = std::max(maxBound[iAxis], other.maxBound[iAxis]);
+    }
+    for (size_t iClass = 0; iClass < classificationCounts.size(); ++iClass) {
+      classificationCounts[iClass] += other.classificationCounts[iClass];
+    }
+    for (size_t iReturn = 0; iReturn < returnNumberCounts.size(); ++iReturn) {
+      returnNumberCounts[iReturn] += other.returnNumberCounts[iReturn];
+    }
+    minIntensity = std::min(minIntensity, other.minIntensity);
+    maxIntensity = std::max(maxIntensity, other.maxIntensity);
+    minGPSTime = std::min(minGPSTime, other.minGPSTime);
+    maxGPSTime = std::max(maxGPSTime, other.maxGPSTime);
+  }
+};
+
+struct LasData {
+  LasData()
+      : header(),
+        variableLengthRecords(),
+        layout(PointDataLayout::ArrayOfStructs),
+        fields(PointField::ALL),
+        pointDataRecords(),
+        pointDataColumns(),
+        packedPointData(),
+        extendedVariableLengthRecord() {}
+
+  PublicHeader header;
+  std::vector<VariableLengthRecord> variableLengthRecords;
+  PointDataLayout layout;                         // Which one of `pointDataRecords`, `pointDataColumns` or `packedPointData` holds the points
+  LLAS_ULONG fields;                              // Attributes held by `pointDataRecords` (`PointField`), e.g. restricted by `ReadOptions::fields`
+  std::vector<PointDataRecord> pointDataRecords;  // `PointDataLayout::ArrayOfStructs`
+  PointDataColumns pointDataColumns;              // `PointDataLayout::StructOfArrays`
+  PackedPointData packedPointData;                // `PointDataLayout::Packed`
+  std::vector<ExtendedVariableLengthRecord> extendedVariableLengthRecord;
+
+  /// @brief Get the number of bytes held by the points and the records in every layout, e.g. to budget caches of decoded files
+  /// @return `nBytes` (`size_t`)
+  inline size_t getMemorySize() const {
+    size_t nBytes = sizeof(LasData);
+    nBytes += pointDataRecords.capacity() * sizeof(PointDataRecord);
+    nBytes += pointDataColumns.getMemorySize();
+    nBytes += packedPointData.bytes.capacity();
+
+    // NOTE: Records share the arena of their file, whose size is that of the payloads
+    nBytes += variableLengthRecords.capacity() * sizeof(VariableLengthRecord);
+    for (const VariableLengthRecord& vlr : variableLengthRecords) {
+      nBytes += vlr.record.size();
+    }
+    nBytes += extendedVariableLengthRecord.capacity() * sizeof(ExtendedVariableLengthRecord);
+    for (const ExtendedVariableLengthRecord& evlr : extendedVariableLengthRecord) {
+      nBytes += evlr.record.size();
+    }
+
+    return nBytes;
+  };
+
+  /// @brief Get the attributes held by the points in the current layout
+  /// @return `fields` (`PointField`): the columns of `pointDataColumns`, the format of `packedPointData` or `fields`
+  inline LLAS_ULONG getFields() const {
+    if (layout == PointDataLayout::StructOfArrays) {
+      return pointDataColumns.fields;
+    }
+    if (layout == PointDataLayout::Packed) {
+      return PointDataRecord::getFormatFields(packedPointData.format);
+    }
+    return fields;
+  }
+
+  /// @brief Get the number of points
+  /// @return `nPoints` (`size_t`)
+  inline size_t getNumPoints() const {
+    if (layout == PointDataLayout::StructOfArrays) {
+      return pointDataColumns.size();
+    }
+    if (layout == PointDataLayout::Packed) {
+      return packedPointData.size();
+    }
+    return pointDataRecords.size();
+  };
+
+  /// @brief Get the point at `index` regardless of the layout
+  /// @return `Point data record` (`PointDataRecord`)
+  inline PointDataRecord getPointDataRecord(const size_t index) const {
+    if (layout == PointDataLayout::StructOfArrays) {
+      return pointDataColumns.get(index);
+    }
+    if (layout == PointDataLayout::Packed) {
+      return packedPointData.get(index);
+    }
+    return pointDataRecords[index];
+  }
+
+  /// @brief Get point coords
+  /// @param rescale by scales and add offsets based on values in public header
+  /// @return `Point coordinates` (`vecd_t`): arranged like `[x0, y0, z0, x1, y1, z1, ...]`.
+  inline math::vecd_t getPointCoords(const bool rescale = true) const {
+    math::vecd_t coords;
+
+    const size_t nPoints = getNumPoints();
+    coords.resize(3 * nPoints);
+
+    getPointCoords(coords.data(), rescale);
+
+    return coords;
+  };
+
+  /// @brief Write point coords into a caller-owned buffer
+  /// @param coords Output buffer. Point `i` is written as 3 doubles `[x, y, z]` at `(char*)coords + i * strideInBytes`.
+  /// @param rescale by scales and add offsets based on values in public header
+  /// @param strideInBytes Distance between consecutive points in bytes. `0` means tightly packed (24 bytes).
+  inline void getPointCoords(double* coords,
+                             const bool rescale = true,
+                             const size_t strideInBytes = 0) const {
+    if (rescale) {
+      _transformPointCoords(getScaleFactors(), getOffsets(), coords, strideInBytes);
+    } else {
+      _transformPointCoords({1.0, 1.0, 1.0}, {0.0, 0.0, 0.0}, coords, strideInBytes);
+    }
+  };
+
+  /// @brief Get point coords in single precision relative to `origin`
+  /// @param origin Origin in world coordinates which is subtracted from every point
+  /// @return `Point coordinates` (`vecf_t`): arranged like `[x0, y0, z0, x1, y1, z1, ...]`.
+  inline math::vecf_t getLocalPointCoords(const math::vec3d_t& origin) const {
+    math::vecf_t coords;
+
+    const size_t nPoints = getNumPoints();
+    coords.resize(3 * nPoints);
+
+    getLocalPointCoords(coords.data(), origin);
+
+    return coords;
+  };
+
+  /// @brief Write point coords in single precision relative to `origin` into a caller-owned buffer (e.g. a mapped vertex buffer)
+  /// @param coords Output buffer. Point `i` is written as 3 floats `[x, y, z]` at `(char*)coords + i * strideInBytes`.
+  /// @param origin Origin in world coordinates which is subtracted from every point
+  /// @param strideInBytes Distance between consecutive points in bytes. `0` means tightly packed (12 bytes).
+  inline void getLocalPointCoords(float* coords,
+                                  const math::vec3d_t& origin,
+                                  const size_t strideInBytes = 0) const {
+    // NOTE: The offsets are combined with the origin in double precision before rounding to float
+    const math::vec3d_t offset = {header.xOffset - origin[0], header.yOffset - origin[1], header.zOffset - origin[2]};
+    _transformPointCoords(getScaleFactors(), offset, coords, strideInBytes);
+  };
+
+  /// @brief Get point coords in single precision relative to `getLocalOrigin()`
+  /// @return `Point coordinates` (`vecf_t`): arranged like `[x0, y0, z0, x1, y1, z1, ...]`.
+  inline math::vecf_t getLocalPointCoords() const {
+    return getLocalPointCoords(getLocalOrigin());
+  };
+
+  /// @brief Get the center of the bounding box in the public header
+  /// @return `Origin` (`vec3d_t`)
+  inline math::vec3d_t getLocalOrigin() const {
+    return {
+        0.5 * (header.minX + header.maxX),
+        0.5 * (header.minY + header.maxY),
+        0.5 * (header.minZ + header.maxZ),
+    };
+  };
+
+  /// @brief Get scale factors in public header
+  inline math::vec3d_t getScaleFactors() const {
+    return {header.xScaleFactor, header.yScaleFactor, header.zScaleFactor};
+  };
+
+  /// @brief Get offsets in public header
+  inline math::vec3d_t getOffsets() const {
+    return {header.xOffset, header.yOffset, header.zOffset};
+  };
+
+  /// @brief Get point colors
+  /// @param depth Bit depth of the color channels
+  /// @param nThreads Number of threads. `0` means all hardware threads.
+  /// @return `Point colors` (`std::vector<unsigned char>`): arranged like `[r0, g0, b0, r1, g1, b1, ...]`.
+  inline math::vec_t<unsigned char> getPointColors(const ColorDepth depth = ColorDepth::Bits16,
+                                                   const size_t nThreads = 1) const {
+    math::vec_t<unsigned char> colors;
+
+    const size_t nPoints = getNumPoints();
+    colors.resize(3 * nPoints);
+
+    getPointColors(colors.data(), 0, depth, nThreads);
+
+    return colors;
+  };
+
+  /// @brief Write point colors into a caller-owned buffer
+  /// @param colors Output buffer. The color of point `i` is written as 3 bytes `[r, g, b]` at `colors + i * strideInBytes`.
+  /// @param strideInBytes Distance between consecutive points in bytes. `0` means tightly packed (3 bytes).
+  /// @param depth Bit depth of the color channels
+  /// @param nThreads Number of threads. `0` means all hardware threads.
+  inline void getPointColors(unsigned char* colors,
+                             const size_t strideInBytes = 0,
+                             const ColorDepth depth = ColorDepth::Bits16,
+                             const size_t nThreads = 1) const {
+    _convertPointColors(colors, false, strideInBytes, depth, nThreads);
+  };
+
+  /// @brief Get point colors with an opaque alpha channel (e.g. for RGBA8 textures or vertex buffers)
+  /// @param depth Bit depth of the color channels
+  /// @param nThreads Number of threads. `0` means all hardware threads.
+  /// @return `Point colors` (`std::vector<unsigned char>`): arranged like `[r0, g0, b0, 255, r1, g1, b1, 255, ...]`.
+  inline math::vec_t<unsigned char> getPointColorsRGBA(const ColorDepth depth = ColorDepth::Bits16,
+                                                       const size_t nThreads = 1) const {
+    math::vec_t<unsigned char> colors;
+
+    const size_t nPoints = getNumPoints();
+    colors.resize(4 * nPoints);
+
+    getPointColorsRGBA(colors.data(), 0, depth, nThreads);
+
+    return colors;
+  };
+
+  /// @brief Write point colors with an opaque alpha channel into a caller-owned buffer
+  /// @param colors Output buffer. The color of point `i` is written as 4 bytes `[r, g, b, 255]` at `colors + i * strideInBytes`.
+  /// @param strideInBytes Distance between consecutive points in bytes. `0` means tightly packed (4 bytes).
+  /// @param depth Bit depth of the color channels
+  /// @param nThreads Number of threads. `0` means all hardware threads.
+  inline void getPointColorsRGBA(unsigned char* colors,
+                                 const size_t strideInBytes = 0,
+                                 const ColorDepth depth = ColorDepth::Bits16,
+                                 const size_t nThreads = 1) const {
+    _convertPointColors(colors, true, strideInBytes, depth, nThreads);
+  };
+
+  /// @brief Get point colors normalized to `[0, 1]`
+  /// @param depth Bit depth of the color channels
+  /// @param nThreads Number of threads. `0` means all hardware threads.
+  /// @return `Point colors` (`vecf_t`): arranged like `[r0, g0, b0, r1, g1, b1, ...]`.
+  inline math::vecf_t getNormalizedPointColors(const ColorDepth depth = ColorDepth::Bits16,
+                                               const size_t nThreads = 1) const {
+    math::vecf_t colors;
+
+    const size_t nPoints = getNumPoints();
+    colors.resize(3 * nPoints);
+
+    getPointColors(colors.data(), 0, depth, nThreads);
+
+    return colors;
+  };
+
+  /// @brief Write point colors normalized to `[0, 1]` into a caller-owned buffer
+  /// @param colors Output buffer. The color of point `i` is written as 3 floats `[r, g, b]` at `(char*)colors + i * strideInBytes`.
+  /// @param strideInBytes Distance between consecutive points in bytes. `0` means tightly packed (12 bytes).
+  /// @param depth Bit depth of the color channels
+  /// @param nThreads Number of threads. `0` means all hardware threads.
+  inline void getPointColors(float* colors,
+                             const size_t strideInBytes = 0,
+                             const ColorDepth depth = ColorDepth::Bits16,
+                             const size_t nThreads = 1) const {
+    _convertPointColors(colors, false, strideInBytes, depth, nThreads);
+  };
+
+  /// @brief Detect the bit depth of the colors. Files whose channels never exceed 255 are assumed to store 8-bit values.
+  /// @param nThreads Number of threads. `0` means all hardware threads.
+  /// @return `Depth` (`ColorDepth`): `ColorDepth::Bits8` or `ColorDepth::Bits16`
+  inline ColorDepth getColorDepth(const size_t nThreads = 1) const {
+    std::atomic<bool> is16Bit(false);
+    _forEachColorBlock(nThreads, [&](const size_t, const size_t nBlockPoints, const LLAS_USHORT* red, const LLAS_USHORT* green, const LLAS_USHORT* blue) {
+      if (is16Bit.load(std::memory_order_relaxed)) {
+        return;
+      }
+
+      LLAS_USHORT bits = 0;
+      for (size_t i = 0; i < nBlockPoints; ++i) {
+        bits |= red[i] | green[i] | blue[i];
+      }
+      if (bits > 255) {
+        is16Bit.store(true, std::memory_order_relaxed);
+      }
+    });
+    return is16Bit ? ColorDepth::Bits16 : ColorDepth::Bits8;
+  };
+
+  /// @brief Compute the bounds, the histograms of classes and return numbers and the ranges of intensities and GPS times
+  ///        in a single multithreaded pass over the integer coordinates and attributes, without copying them
+  /// @param nThreads Number of threads. `0` means all hardware threads.
+  /// @return `Statistics` (`PointStatistics`)
+  inline PointStatistics getStatistics(const size_t nThreads = 1) const {
+    const size_t nPoints = getNumPoints();
+    const size_t nBlocks = getNumParallelBlocks(nPoints, nThreads);
+    std::vector<PointStatistics> blockStatistics(nBlocks);
+
+    // NOTE: Attributes which were not decoded (e.g. `ReadOptions::fields`) are zero and are not reported
+    LLAS_ULONG statFields = getFields() & (PointField::XYZ | PointField::CLASSIFICATION | PointField::RETURNS | PointField::INTENSITY | PointField::GPS_TIME);
+    if (layout == PointDataLayout::ArrayOfStructs && !PointDataRecord::hasGPSTime(header.pointDataRecordFormat)) {
+      statFields &= ~PointField::GPS_TIME;
+    }
+
+    parallelForBlocks(nPoints, nThreads, [&](const size_t iBlock, const size_t begin, const size_t end) {
+      PointStatistics& statistics = blockStatistics[iBlock];
+      statistics.nPoints = end - begin;
+      statistics.minCoords.fill(std::numeric_limits<LLAS_LONG>::max());
+      statistics.maxCoords.fill(std::numeric_limits<LLAS_LONG>::min());
+      statistics.minIntensity = std::numeric_limits<LLAS_USHORT>::max();
+      statistics.maxIntensity = 0;
+      statistics.minGPSTime = std::numeric_limits<LLAS_DOUBLE>::infinity();
+      statistics.maxGPSTime = -std::numeric_limits<LLAS_DOUBLE>::infinity();
+
+      if (layout == PointDataLayout::StructOfArrays) {
+        // NOTE: Every attribute is reduced in its own loop over a contiguous column, which the compiler vectorizes
+        _accumulateColumnRange(pointDataColumns.x, begin, end, statistics.minCoords[0], statistics.maxCoords[0]);
+        _accumulateColumnRange(pointDataColumns.y, begin, end, statistics.minCoords[1], statistics.maxCoords[1]);
+        _accumulateColumnRange(pointDataColumns.z, begin, end, statistics.minCoords[2], statistics.maxCoords[2]);
+        _accumulateColumnRange(pointDataColumns.intensity, begin, end, statistics.minIntensity, statistics.maxIntensity);
+        _accumulateColumnRange(pointDataColumns.GPSTime, begin, end, statistics.minGPSTime, statistics.maxGPSTime);
+        for (size_t iAxis = 0; iAxis < 3; ++iAxis) {
+          // NOTE: Coordinates which were not decoded are zero like in `PointDataRecord`
+          if (!(pointDataColumns.fields & (PointField::X << iAxis))) {
+            statistics.minCoords[iAxis] = std::min<LLAS_LONG>(statistics.minCoords[iAxis], 0);
+            statistics.maxCoords[iAxis] = std::max<LLAS_LONG>(statistics.maxCoords[iAxis], 0);
+          }
+        }
+        if (statFields & PointField::CLASSIFICATION) {
+          for (size_t i = begin; i < end; ++i) {
+            ++statistics.classificationCounts[pointDataColumns.classification[i]];
+          }
+        }
+        if (statFields & PointField::RETURNS) {
+          for (size_t i = begin; i < end; ++i) {
+            ++statistics.returnNumberCounts[pointDataColumns.returnNumber[i] & 0x0F];
+          }
+        }
+        return;
+      }
+
+      const auto accumulate = [&](const std::array<LLAS_LONG, 3>& coords,
+                                  const LLAS_UCHAR classification,
+                                  const LLAS_UCHAR returnNumber,
+                                  const LLAS_USHORT intensity,
+                                  const LLAS_DOUBLE GPSTime) {
+        for (size_t iAxis = 0; iAxis < 3; ++iAxis) {
+          statistics.minCoords[iAxis] = std::min(statistics.minCoords[iAxis], coords[iAxis]);
+          statistics.maxCoords[iAxis] = std::max(statistics.maxCoords[iAxis], coords[iAxis]);
+        }
+        ++statistics.classificationCounts[classification];
+        ++statistics.returnNumberCounts[returnNumber & 0x0F];
+        statistics.minIntensity = std::min(statistics.minIntensity, intensity);
+        statistics.maxIntensity = std::max(statistics.maxIntensity, intensity);
+        statistics.minGPSTime = std::min(statistics.minGPSTime, GPSTime);
+        statistics.maxGPSTime = std::max(statistics.maxGPSTime, GPSTime);
+      };
+
+      if (layout == PointDataLayout::Packed) {
+        for (size_t i = begin; i < end; ++i) {
+          accumulate(packedPointData.getCoords(i), packedPointData.getClassification(i), packedPointData.getReturnNumber(i), packedPointData.getIntensity(i), packedPointData.getGPSTime(i));
+        }
+      } else {
+        for (size_t i = begin; i < end; ++i) {
+          const PointDataRecord& pointDataRecord = pointDataRecords[i];
+          accumulate({pointDataRecord.x, pointDataRecord.y, pointDataRecord.z}, pointDataRecord.classification, pointDataRecord.returnNumber, pointDataRecord.intensity, pointDataRecord.GPSTime);
+        }
+      }
+    });
+
+    PointStatistics statistics;
+    for (const PointStatistics& block : blockStatistics) {
+      statistics.merge(block);
+    }
+    statistics.fields = statFields;
+
+    if (!(statFields & PointField::CLASSIFICATION)) {
+      statistics.classificationCounts.fill(0);
+    }
+    if (!(statFields & PointField::RETURNS)) {
+      statistics.returnNumberCounts.fill(0);
+    }
+    if (!(statFields & PointField::INTENSITY) || nPoints == 0) {
+      statistics.minIntensity = statistics.maxIntensity = 0;
+    }
+    if (!(statFields & PointField::GPS_TIME) || nPoints == 0) {
+      statistics.minGPSTime = statistics.maxGPSTime = 0.0;
+    }
+
+    if (nPoints > 0) {
+      const math::vec3d_t scale = getScaleFactors();
+      const math::vec3d_t offset = getOffsets();
+      for (size_t iAxis = 0; iAxis < 3; ++iAxis) {
+        const double lower = (double)statistics.minCoords[iAxis] * scale[iAxis] + offset[iAxis];
+        const double upper = (double)statistics.maxCoords[iAxis] * scale[iAxis] + offset[iAxis];
+        statistics.minBound[iAxis] = std::min(lower, upper);
+        statistics.maxBound[iAxis] = std::max(lower, upper);
+      }
+    }
+
+    return statistics;
+  }
+
+  /// @brief Compare the statistics of the points (`getStatistics`) with the public header and log both
+  /// @param nThreads Number of threads. `0` means all hardware threads.
+  /// @return `true` if the number of points, the bounds and the numbers of points by return match the public header
+  inline bool validate(const size_t nThreads = 1) const {
+    const PointStatistics statistics = getStatistics(nThreads);
+    const math::vec3d_t& minCoords = statistics.minBound;
+    const math::vec3d_t& maxCoords = statistics.maxBound;
+
+    char logMessage[LLAS_BUFFER_SIZE];
+
+#if defined(_WIN64)
+    std::fill_n(logMessage, LLAS_BUFFER_SIZE, '\0');
+    sprintf_s(logMessage, "minCoords        = (%.5lf, %.5lf, %.5lf)", minCoords[0], minCoords[1], minCoords[2]);
+    _LLAS_logDebug(logMessage);
+
+    std::fill_n(logMessage, LLAS_BUFFER_SIZE, '\0');
+    sprintf_s(logMessage, "publicHeader.min = (%.5lf, %.5lf, %.5lf)", header.minX, header.minY, header.minZ);
+    _LLAS_logDebug(logMessage);
+
+    std::fill_n(logMessage, LLAS_BUFFER_SIZE, '\0');
+    sprintf_s(logMessage, "maxCoords        = (%.5lf, %.5lf, %.5lf)", maxCoords[0], maxCoords[1], maxCoords[2]);
+    _LLAS_logDebug(logMessage);
+
+    std::fill_n(logMessage, LLAS_BUFFER_SIZE, '\0');
+    sprintf_s(logMessage, "publicHeader.max = (%.5lf, %.5lf, %.5lf)", header.maxX, header.maxY, header.maxZ);
+    _LLAS_logDebug(logMessage);
+#else
+    std::fill_n(logMessage, LLAS_BUFFER_SIZE, '\0');
+    sprintf(logMessage, "minCoords        = (%.5lf, %.5lf, %.5lf)", minCoords[0], minCoords[1], minCoords[2]);
+    _LLAS_logDebug(logMessage);
+
+    std::fill_n(logMessage, LLAS_BUFFER_SIZE, '\0');
+    sprintf(logMessage, "publicHeader.min = (%.5lf, %.5lf, %.5lf)", header.minX, header.minY, header.minZ);
+    _LLAS_logDebug(logMessage);
+
+    std::fill_n(logMessage, LLAS_BUFFER_SIZE, '\0');
+    sprintf(logMessage, "maxCoords        = (%.5lf, %.5lf, %.5lf)", maxCoords[0], maxCoords[1], maxCoords[2]);
+    _LLAS_logDebug(logMessage);
+
+    std::fill_n(logMessage, LLAS_BUFFER_SIZE, '\0');
+    sprintf(logMessage, "publicHeader.max = (%.5lf, %.5lf, %.5lf)", header.maxX, header.maxY, header.maxZ);
+    _LLAS_logDebug(logMessage);
+#endif
+
+    if (!statistics.matchesPointCount(header)) {
+      _LLAS_logDebug("Number of points does not match the public header: " + std::to_string(statistics.nPoints));
+    }
+    if (!statistics.matchesBounds(header)) {
+      _LLAS_logDebug("Bounds do not match the public header");
+    }
+    if (!statistics.matchesReturnCounts(header)) {
+      _LLAS_logDebug("Numbers of points by return do not match the public header");
+    }
+
+    return statistics.matchesHeader(header);
+  }
+
+  /// @brief Rearrange the points of either layout so that the point at `indices[i]` moves to `i`. Points not in `indices` are removed.
+  ///        Indices to the points obtained before (e.g. from `PointIndex`) are invalidated.
+  /// @param indices Indices of the points in their new order
+  /// @param nThreads Number of threads. `0` means all hardware threads.
+  inline void reorderPoints(const std::vector<size_t>& indices,
+                            const size_t nThreads = 1) {
+    if (layout == PointDataLayout::StructOfArrays) {
+      pointDataColumns.reorder(indices, nThreads);
+      return;
+    }
+    if (layout == PointDataLayout::Packed) {
+      packedPointData.reorder(indices, nThreads);
+      return;
+    }
+
+    std::vector<PointDataRecord> reordered(indices.size());
+    parallelFor(indices.size(), nThreads, [&](const size_t begin, const size_t end) {
+      for (size_t i = begin; i < end; ++i) {
+        reordered[i] = pointDataRecords[indices[i]];
+      }
+    });
+    pointDataRecords.swap(reordered);
+  }
+
+  /// @brief Sort the points of either layout in `order` with a parallel radix sort. Points with equal keys keep their order.
+  ///        Indices to the points obtained before (e.g. from `PointIndex`) are invalidated.
+  /// @param order Order of the points
+  /// @param nThreads Number of threads. `0` means all hardware threads.
+  /// @return `true` if sorted, `false` if the points have no attribute for `order`
+  inline bool sortPoints(const PointOrder order,
+                         const size_t nThreads = 1) {
+    const size_t nPoints = getNumPoints();
+    const bool isColumnar = layout == PointDataLayout::StructOfArrays;
+    const bool isPacked = layout == PointDataLayout::Packed;
+
+    std::vector<LLAS_ULLONG> keys(nPoints);
+
+    if (order == PointOrder::GPSTime) {
+      const bool hasGPSTime = isColumnar ? pointDataColumns.hasGPSTime() : (isPacked ? packedPointData.hasGPSTime() : PointDataRecord::hasGPSTime(header.pointDataRecordFormat));
+      if (!hasGPSTime) {
+        _LLAS_logError("Points have no GPS time to sort by");
+        return false;
+      }
+
+      // NOTE: Flip the bits of IEEE 754 doubles so that unsigned integer order matches floating point order
+      parallelFor(nPoints, nThreads, [&](const size_t begin, const size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+          const LLAS_DOUBLE GPSTime = isColumnar ? pointDataColumns.GPSTime[i] : (isPacked ? packedPointData.getGPSTime(i) : pointDataRecords[i].GPSTime);
+          LLAS_ULLONG bits;
+          std::memcpy(&bits, &GPSTime, sizeof(LLAS_ULLONG));
+          keys[i] = bits >> 63 ? ~bits : bits | 0x8000000000000000ULL;
+        }
+      });
+    } else {
+      // NOTE: Coordinates which were not decoded are zero like in `PointDataRecord`
+      const bool hasX = !isColumnar || (pointDataColumns.fields & PointField::X);
+      const bool hasY = !isColumnar || (pointDataColumns.fields & PointField::Y);
+      const bool hasZ = !isColumnar || (pointDataColumns.fields & PointField::Z);
+      const auto getCoords = [&](const size_t i) -> std::array<LLAS_LONG, 3> {
+        if (isColumnar) {
+          return {hasX ? pointDataColumns.x[i] : 0, hasY ? pointDataColumns.y[i] : 0, hasZ ? pointDataColumns.z[i] : 0};
+        }
+        if (isPacked) {
+          return packedPointData.getCoords(i);
+        }
+        const PointDataRecord& pointDataRecord = pointDataRecords[i];
+        return {pointDataRecord.x, pointDataRecord.y, pointDataRecord.z};
+      };
+
+      const size_t nBlocks = getNumParallelBlocks(nPoints, nThreads);
+      std::vector<std::array<LLAS_LONG, 3>> blockMinCoords(nBlocks, {std::numeric_limits<LLAS_LONG>::max(), std::numeric_limits<LLAS_LONG>::max(), std::numeric_limits<LLAS_LONG>::max()});
+      std::vector<std::array<LLAS_LONG, 3>> blockMaxCoords(nBlocks, {std::numeric_limits<LLAS_LONG>::min(), std::numeric_limits<LLAS_LONG>::min(), std::numeric_limits<LLAS_LONG>::min()});
+      parallelForBlocks(nPoints, nThreads, [&](const size_t iBlock, const size_t begin, const size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+          const std::array<LLAS_LONG, 3> coords = getCoords(i);
+          for (size_t iAxis = 0; iAxis < 3; ++iAxis) {
+            blockMinCoords[iBlock][iAxis] = std::min(blockMinCoords[iBlock][iAxis], coords[iAxis]);
+            blockMaxCoords[iBlock][iAxis] = std::max(blockMaxCoords[iBlock][iAxis], coords[iAxis]);
+          }
+        }
+      });
+
+      std::array<LLAS_LONG, 3> minCoords = blockMinCoords[0];
+      LLAS_ULLONG maxRange = 0;
+      for (size_t iAxis = 0; iAxis < 3; ++iAxis) {
+        LLAS_LONG maxCoord = blockMaxCoords[0][iAxis];
+        for (size_t iBlock = 1; iBlock < nBlocks; ++iBlock) {
+          minCoords[iAxis] = std::min(minCoords[iAxis], blockMinCoords[iBlock][iAxis]);
+          maxCoord = std::max(maxCoord, blockMaxCoords[iBlock][iAxis]);
+        }
+        if (nPoints > 0) {
+          maxRange = std::max(maxRange, (LLAS_ULLONG)((LLAS_LLONG)maxCoord - minCoords[iAxis]));
+        }
+      }
+
+      // NOTE: All axes are shifted equally so that the cells of the curve are cubes in integer units
+      size_t shift = 0;
+      while ((maxRange >> shift) >= ((LLAS_ULLONG)1 << 21)) {
+        ++shift;
+      }
+
+      parallelFor(nPoints, nThreads, [&](const size_t begin, const size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+          const std::array<LLAS_LONG, 3> coords = getCoords(i);
+          keys[i] = getMortonCode((LLAS_ULONG)(((LLAS_LLONG)coords[0] - minCoords[0]) >> shift),
+                                  (LLAS_ULONG)(((LLAS_LLONG)coords[1] - minCoords[1]) >> shift),
+                                  (LLAS_ULONG)(((LLAS_LLONG)coords[2] - minCoords[2]) >> shift));
+        }
+      });
+    }
+
+    reorderPoints(sortIndicesByKeys(keys, nThreads), nThreads);
+    return true;
+  }
+
+  /// @brief Extend `[minValue, maxValue]` with `column[begin, end)`. Empty columns are skipped.
+  template <class T>
+  static inline void _accumulateColumnRange(const std::vector<T>& column,
+                                            const size_t begin,
+                                            const size_t end,
+                                            T& minValue,
+                                            T& maxValue) {
+    if (column.empty()) {
+      return;
+    }
+
+    T minValue_ = minValue;
+    T maxValue_ = maxValue;
+    const T* values = column.data();
+    for (size_t i = begin; i < end; ++i) {
+      minValue_ = values[i] < minValue_ ? values[i] : minValue_;
+      maxValue_ = values[i] > maxValue_ ? values[i] : maxValue_;
+    }
+    minValue = minValue_;
+    maxValue = maxValue_;
+  }
+
+  // clang-format off
+  inline static const size_t COLOR_BLOCK_SIZE                                                       = 1024;
+  // clang-format on
+
+  /// @brief Call `func(begin, nBlockPoints, red, green, blue)` with `nThreads` threads for blocks of points whose color channels are contiguous
+  template <class Func>
+  inline void _forEachColorBlock(const size_t nThreads,
+                                 Func&& func) const {
+    const size_t nPoints = getNumPoints();
+    const bool isColumnar = layout == PointDataLayout::StructOfArrays && pointDataColumns.hasRGB();
+
+    parallelFor(nPoints, nThreads, [&](const size_t begin, const size_t end) {
+      LLAS_USHORT redBlock[COLOR_BLOCK_SIZE];
+      LLAS_USHORT greenBlock[COLOR_BLOCK_SIZE];
+      LLAS_USHORT blueBlock[COLOR_BLOCK_SIZE];
+
+      // NOTE: Colors which were not decoded are zero like in `PointDataRecord`
+      if (layout == PointDataLayout::StructOfArrays && !isColumnar) {
+        std::fill_n(redBlock, COLOR_BLOCK_SIZE, 0);
+        std::fill_n(greenBlock, COLOR_BLOCK_SIZE, 0);
+        std::fill_n(blueBlock, COLOR_BLOCK_SIZE, 0);
+      }
+
+      for (size_t blockBegin = begin; blockBegin < end; blockBegin += COLOR_BLOCK_SIZE) {
+        const size_t nBlockPoints = std::min(COLOR_BLOCK_SIZE, end - blockBegin);
+
+        const LLAS_USHORT* red = redBlock;
+        const LLAS_USHORT* green = greenBlock;
+        const LLAS_USHORT* blue = blueBlock;
+
+        if (isColumnar) {
+          red = pointDataColumns.red.data() + blockBegin;
+          green = pointDataColumns.green.data() + blockBegin;
+          blue = pointDataColumns.blue.data() + blockBegin;
+        } else if (layout == PointDataLayout::Packed) {
+          for (size_t i = 0; i < nBlockPoints; ++i) {
+            const std::array<LLAS_USHORT, 3> rgb = packedPointData.getRGB(blockBegin + i);
+            redBlock[i] = rgb[0];
+            greenBlock[i] = rgb[1];
+            blueBlock[i] = rgb[2];
+          }
+        } else if (layout == PointDataLayout::ArrayOfStructs) {
+          for (size_t i = 0; i < nBlockPoints; ++i) {
+            const PointDataRecord& pointDataRecord = pointDataRecords[blockBegin + i];
+            redBlock[i] = pointDataRecord.red;
+            greenBlock[i] = pointDataRecord.green;
+            blueBlock[i] = pointDataRecord.blue;
+          }
+        }
+
+        func(blockBegin, nBlockPoints, red, green, blue);
+      }
+    });
+  }
+
+  /// @brief Convert the colors of all points into interleaved `colors` of 8-bit (`unsigned char`) or normalized (`float`) channels
+  template <class DType>
+  inline void _convertPointColors(DType* colors,
+                                  const bool hasAlpha,
+                                  const size_t strideInBytes,
+                                  const ColorDepth depth,
+                                  const size_t nThreads) const {
+    const bool is8Bit = (depth == ColorDepth::Auto ? getColorDepth(nThreads) : depth) == ColorDepth::Bits8;
+
+    const size_t nChannels = hasAlpha ? 4 : 3;
+    const size_t packedStride = nChannels * sizeof(DType);
+    const bool isPacked = strideInBytes == 0 || strideInBytes == packedStride;
+
+    _forEachColorBlock(nThreads, [&](const size_t begin, const size_t nBlockPoints, const LLAS_USHORT* red, const LLAS_USHORT* green, const LLAS_USHORT* blue) {
+      const auto convert = [&](DType* out) {
+        if constexpr (std::is_same<DType, float>::value) {
+          simd::convertColors(red, green, blue, nBlockPoints, is8Bit, out);
+        } else {
+          simd::convertColors(red, green, blue, nBlockPoints, is8Bit, hasAlpha, out);
+        }
+      };
+
+      if (isPacked) {
+        convert(colors + nChannels * begin);
+        return;
+      }
+
+      // NOTE: Strided output is converted into this block and then scattered
+      DType packedBlock[4 * COLOR_BLOCK_SIZE];
+      convert(packedBlock);
+
+      char* out = reinterpret_cast<char*>(colors) + begin * strideInBytes;
+      for (size_t i = 0; i < nBlockPoints; ++i) {
+        std::memcpy(out + i * strideInBytes, packedBlock + nChannels * i, packedStride);
+      }
+    });
+  }
+
+  /// @brief Transform all points with `v * scale + offset` into interleaved `coords`
+  template <class DType>
+  inline void _transformPointCoords(const math::vec3d_t& scale,
+                                    const math::vec3d_t& offset,
+                                    DType* coords,
+                                    const size_t strideInBytes) const {
+    // NOTE: Points are transformed in blocks whose integer coordinates are contiguous
+    const size_t BLOCK_SIZE = 1024;
+
+    const size_t nPoints = getNumPoints();
+    const bool isColumnar = layout == PointDataLayout::StructOfArrays;
+
+    const size_t packedStride = 3 * sizeof(DType);
+    const bool isPacked = strideInBytes == 0 || strideInBytes == packedStride;
+
+    // NOTE: Strided output is transformed into this block and then scattered
+    DType packedBlock[3 * BLOCK_SIZE];
+
+    LLAS_LONG xBlock[BLOCK_SIZE];
+    LLAS_LONG yBlock[BLOCK_SIZE];
+    LLAS_LONG zBlock[BLOCK_SIZE];
+    bool isBlockCleared = false;
+
+    for (size_t begin = 0; begin < nPoints; begin += BLOCK_SIZE) {
+      const size_t nBlockPoints = std::min(BLOCK_SIZE, nPoints - begin);
+
+      const LLAS_LONG* x = xBlock;
+      const LLAS_LONG* y = yBlock;
+      const LLAS_LONG* z = zBlock;
+
+      if (isColumnar) {
+        // NOTE: Coordinates which were not decoded are zero like in `PointDataRecord`
+        if (!isBlockCleared) {
+          std::fill_n(xBlock, BLOCK_SIZE, 0);
+          std::fill_n(yBlock, BLOCK_SIZE, 0);
+          std::fill_n(zBlock, BLOCK_SIZE, 0);
+          isBlockCleared = true;
+        }
+
+        if (pointDataColumns.fields & PointField::X) {
+          x = pointDataColumns.x.data() + begin;
+        }
+        if (pointDataColumns.fields & PointField::Y) {
+          y = pointDataColumns.y.data() + begin;
+        }
+        if (pointDataColumns.fields & PointField::Z) {
+          z = pointDataColumns.z.data() + begin;
+        }
+      } else if (layout == PointDataLayout::Packed) {
+        for (size_t i = 0; i < nBlockPoints; ++i) {
+          const std::array<LLAS_LONG, 3> pointCoords = packedPointData.getCoords(begin + i);
+          xBlock[i] = pointCoords[0];
+          yBlock[i] = pointCoords[1];
+          zBlock[i] = pointCoords[2];
+        }
+      } else {
+        for (size_t i = 0; i < nBlockPoints; ++i) {
+          const PointDataRecord& pointDataRecord = pointDataRecords[begin + i];
+          xBlock[i] = pointDataRecord.x;
+          yBlock[i] = pointDataRecord.y;
+          zBlock[i] = pointDataRecord.z;
+        }
+      }
+
+      if (isPacked) {
+        simd::transformCoords(x, y, z, nBlockPoints, scale, offset, coords + 3 * begin);
+      } else {
+        simd::transformCoords(x, y, z, nBlockPoints, scale, offset, packedBlock);
+
+        char* out = reinterpret_cast<char*>(coords) + begin * strideInBytes;
+        for (size_t i = 0; i < nBlockPoints; ++i) {
+          std::memcpy(out + i * strideInBytes, packedBlock + 3 * i, packedStride);
+        }
+      }
+    }
+  }
+};
+
+using LasData_ptr = std::shared_ptr<LasData>;
+
+// ==========================================================================
+// Read options
+// ==========================================================================
+/// @brief Predicate on 'Point Data Records' evaluated while decoding. Rejected points are never stored.
+struct PointFilter {
+  PointFilter()
+      : hasBoundingBox(false),
+        minBound(),
+        maxBound(),
+        hasClassifications(false),
+        classifications(),
+        hasReturnNumberRange(false),
+        minReturnNumber(),
+        maxReturnNumber(),
+        hasIntensityRange(false),
+        minIntensity(),
+        maxIntensity(),
+        hasGPSTimeRange(false),
+        minGPSTime(),
+        maxGPSTime(),
+        useHeaderBounds(false) {}
+
+  /// @brief Keep only the points inside `[minBound, maxBound]`
+  bool hasBoundingBox;
+
+  /// @brief Minimum corner of the box in world coordinates (inclusive)
+  math::vec3d_t minBound;
+
+  /// @brief Maximum corner of the box in world coordinates (inclusive)
+  math::vec3d_t maxBound;
+
+  /// @brief Keep only the points whose classification is in `classifications`
+  bool hasClassifications;
+
+  /// @brief Accepted classes. For formats 0 to 5 the class is the low five bits of the classification byte.
+  std::vector<LLAS_UCHAR> classifications;
+
+  /// @brief Keep only the points whose return number is in `[minReturnNumber, maxReturnNumber]`
+  bool hasReturnNumberRange;
+  LLAS_UCHAR minReturnNumber;
+  LLAS_UCHAR maxReturnNumber;
+
+  /// @brief Keep only the points whose intensity is in `[minIntensity, maxIntensity]`
+  bool hasIntensityRange;
+  LLAS_USHORT minIntensity;
+  LLAS_USHORT maxIntensity;
+
+  /// @brief Keep only the points whose GPS time is in `[minGPSTime, maxGPSTime]`.
+  ///        No point passes if the point data record format has no GPS time.
+  bool hasGPSTimeRange;
+  LLAS_DOUBLE minGPSTime;
+  LLAS_DOUBLE maxGPSTime;
+
+  /// @brief Skip the whole file without testing its points if the box does not overlap the bounds in the public header (padded by one scale factor).
+  ///        Only for files whose header bounds are known to be up to date, since stale bounds would drop points which are inside the box.
+  bool useHeaderBounds;
+
+  /// @brief Set an axis-aligned box in world coordinates.
+  ///        Use `-inf`/`inf` to leave an axis unbounded (e.g. a 2D query on x and y).
+  inline void setBoundingBox(const math::vec3d_t& minBound_,
+                             const math::vec3d_t& maxBound_) {
+    hasBoundingBox = true;
+    minBound = minBound_;
+    maxBound = maxBound_;
+  }
+
+  /// @brief Set the accepted classes (e.g. `{2}` for ground)
+  inline void setClassifications(const std::vector<LLAS_UCHAR>& classifications_) {
+    hasClassifications = true;
+    classifications = classifications_;
+  }
+
+  /// @brief Set the accepted range of return numbers (inclusive)
+  inline void setReturnNumberRange(const LLAS_UCHAR minReturnNumber_,
+                                   const LLAS_UCHAR maxReturnNumber_) {
+    hasReturnNumberRange = true;
+    minReturnNumber = minReturnNumber_;
+    maxReturnNumber = maxReturnNumber_;
+  }
+
+  /// @brief Set the accepted range of intensities (inclusive)
+  inline void setIntensityRange(const LLAS_USHORT minIntensity_,
+                                const LLAS_USHORT maxIntensity_) {
+    hasIntensityRange = true;
+    minIntensity = minIntensity_;
+    maxIntensity = maxIntensity_;
+  }
+
+  /// @brief Set the accepted window of GPS times (inclusive)
+  inline void setGPSTimeRange(const LLAS_DOUBLE minGPSTime_,
+                              const LLAS_DOUBLE maxGPSTime_) {
+    hasGPSTimeRange = true;
+    minGPSTime = minGPSTime_;
+    maxGPSTime = maxGPSTime_;
+  }
+
+  inline bool isEnabled() const {
+    return hasBoundingBox || hasClassifications || hasReturnNumberRange || hasIntensityRange || hasGPSTimeRange;
+  }
+};
+
+/// @brief Level-of-detail subsampling of 'Point Data Records' for `PointSubsampling`
+enum class SubsamplingMode {
+  None,
+  Stride,     // Every record whose index is a multiple of `stride`, before `PointFilter`
+  Random,     // Uniform random sample of `nSamples` points which pass `PointFilter`
+  VoxelGrid,  // First point which passes `PointFilter` in every voxel of `voxelSize`
+};
+
+/// @brief Subsample 'Point Data Records' while reading. Records which are not selected are never decoded.
+struct PointSubsampling {
+  PointSubsampling()
+      : mode(SubsamplingMode::None),
+        stride(1),
+        nSamples(),
+        seed(),
+        voxelSize() {}
+
+  SubsamplingMode mode;
+
+  /// @brief Keep one record out of `stride` (`SubsamplingMode::Stride`)
+  size_t stride;
+
+  /// @brief Number of points to keep (`SubsamplingMode::Random`)
+  size_t nSamples;
+
+  /// @brief Seed of the random sample (`SubsamplingMode::Random`). The same seed selects the same points.
+  LLAS_ULLONG seed;
+
+  /// @brief Size of the voxels in world units (`SubsamplingMode::VoxelGrid`). An axis of size `0` is not subdivided (e.g. a 2D grid).
+  math::vec3d_t voxelSize;
+
+  /// @brief Keep every record whose index is a multiple of `stride_`. Reading through a memory mapping touches only the pages of the kept records.
+  inline void setStride(const size_t stride_) {
+    mode = SubsamplingMode::Stride;
+    stride = std::max<size_t>(1, stride_);
+  }
+
+  /// @brief Keep `nSamples_` points chosen uniformly at random with reservoir sampling. The points keep their file order.
+  inline void setRandom(const size_t nSamples_,
+                        const LLAS_ULLONG seed_ = 0) {
+    mode = SubsamplingMode::Random;
+    nSamples = nSamples_;
+    seed = seed_;
+  }
+
+  /// @brief Keep the first point of every voxel of `voxelSize_` on the grid anchored at the minimum bounds of the header
+  inline void setVoxelGrid(const math::vec3d_t& voxelSize_) {
+    mode = SubsamplingMode::VoxelGrid;
+    voxelSize = voxelSize_;
+  }
+
+  inline bool isEnabled() const {
+    return mode != SubsamplingMode::None;
+  }
+};
+
+/// @brief `PointFilter` converted once into the integer domain of the records of a file,
+///        so that a record is tested on its raw bytes before it is decoded
+struct RawPointFilter {
+  RawPointFilter()
+      : isEnabled(false),
+        isEmpty(false),
+        hasBoundingBox(false),
+        minX(),
+        maxX(),
+        minY(),
+        maxY(),
+        minZ(),
+        maxZ(),
+        hasClassifications(false),
+        classificationMask(),
+        hasReturnNumberRange(false),
+        minReturnNumber(),
+        maxReturnNumber(),
+        hasIntensityRange(false),
+        minIntensity(),
+        maxIntensity(),
+        hasGPSTimeRange(false),
+        minGPSTime(),
+        maxGPSTime() {}
+
+  /// @param filter Filter in world coordinates
+  /// @param header Public header which provides the scale factors, the offsets and the bounds of the file
+  RawPointFilter(const PointFilter& filter, const PublicHeader& header)
+      : RawPointFilter() {
+    isEnabled = filter.isEnabled();
+
+    if (filter.hasBoundingBox) {
+      hasBoundingBox = true;
+
+      // NOTE: The bounds in the header are often stale, so they reject the whole file only on request
+      const double padX = std::abs(header.xScaleFactor), padY = std::abs(header.yScaleFactor), padZ = std::abs(header.zScaleFactor);
+      const bool isDisjoint = filter.useHeaderBounds &&
+                              (filter.maxBound[0] < header.minX - padX || header.maxX + padX < filter.minBound[0] ||
+                               filter.maxBound[1] < header.minY - padY || header.maxY + padY < filter.minBound[1] ||
+                               filter.maxBound[2] < header.minZ - padZ || header.maxZ + padZ < filter.minBound[2]);
+
+      isEmpty = isDisjoint ||
+                !_toRawRange(filter.minBound[0], filter.maxBound[0], header.xScaleFactor, header.xOffset, minX, maxX) ||
+                !_toRawRange(filter.minBound[1], filter.maxBound[1], header.yScaleFactor, header.yOffset, minY, maxY) ||
+                !_toRawRange(filter.minBound[2], filter.maxBound[2], header.zScaleFactor, header.zOffset, minZ, maxZ);
+    }
+
+    if (filter.hasClassifications) {
+      hasClassifications = true;
+      for (const LLAS_UCHAR classification : filter.classifications) {
+        classificationMask[classification >> 6] |= (LLAS_ULLONG)1 << (classification & 63);
+      }
+      isEmpty = isEmpty || filter.classifications.empty();
+    }
+
+    if (filter.hasReturnNumberRange) {
+      hasReturnNumberRange = true;
+      minReturnNumber = filter.minReturnNumber;
+      maxReturnNumber = filter.maxReturnNumber;
+      isEmpty = isEmpty || minReturnNumber > maxReturnNumber;
+    }
+
+    if (filter.hasIntensityRange) {
+      hasIntensityRange = true;
+      minIntensity = filter.minIntensity;
+      maxIntensity = filter.maxIntensity;
+      isEmpty = isEmpty || minIntensity > maxIntensity;
+    }
+
+    if (filter.hasGPSTimeRange) {
+      hasGPSTimeRange = true;
+      minGPSTime = filter.minGPSTime;
+      maxGPSTime = filter.maxGPSTime;
+      isEmpty = isEmpty || !(minGPSTime <= maxGPSTime) || !PointDataRecord::hasGPSTime(header.pointDataRecordFormat);
+    }
+  }
+
+  /// @brief Any predicate is set
+  bool isEnabled;
+
+  /// @brief No record of the file can pass the filter
+  bool isEmpty;
+
+  // clang-format off
+  bool                       hasBoundingBox;
+  LLAS_LLONG                 minX;
+  LLAS_LLONG                 maxX;
+  LLAS_LLONG                 minY;
+  LLAS_LLONG                 maxY;
+  LLAS_LLONG                 minZ;
+  LLAS_LLONG                 maxZ;
+
+  bool                       hasClassifications;
+  std::array<LLAS_ULLONG, 4> classificationMask;  // Bit `c` is set if the class `c` is accepted
+
+  bool                       hasReturnNumberRange;
+  LLAS_UCHAR                 minReturnNumber;
+  LLAS_UCHAR                 maxReturnNumber;
+
+  bool                       hasIntensityRange;
+  LLAS_USHORT                minIntensity;
+  LLAS_USHORT                maxIntensity;
+
+  bool                       hasGPSTimeRange;
+  LLAS_DOUBLE                minGPSTime;
+  LLAS_DOUBLE                maxGPSTime;
+  // clang-format on
+
+  /// @brief Test a raw record of the point data record format `FORMAT`
+  /// @param record Bytes starting at the beginning of the record
+  /// @return `true` if the record passes the filter
+  template <int FORMAT>
+  inline bool accept(const char* record) const {
+    using Format = PointDataRecordFormat<FORMAT>;
+
+    if (hasBoundingBox) {
+      LLAS_LONG x, y, z;
+      std::memcpy(&x, record + Format::OFFSET_X, PointDataRecord::NUM_BYTES_X);
+      std::memcpy(&y, record + Format::OFFSET_Y, PointDataRecord::NUM_BYTES_Y);
+      std::memcpy(&z, record + Format::OFFSET_Z, PointDataRecord::NUM_BYTES_Z);
+
+      if (x < minX || maxX < x || y < minY || maxY < y || z < minZ || maxZ < z) {
+        return false;
+      }
+    }
+
+    if (hasClassifications) {
+      LLAS_UCHAR classification = (LLAS_UCHAR)record[Format::OFFSET_CLASSIFICATION];
+      if constexpr (!Format::IS_EXTENDED) {
+        classification &= 0x1F;
+      }
+
+      if (!((classificationMask[classification >> 6] >> (classification & 63)) & 1)) {
+        return false;
+      }
+    }
+
+    if (hasReturnNumberRange) {
+      const LLAS_UCHAR returnNumber = (LLAS_UCHAR)record[Format::OFFSET_SENSOR_DATA] & (Format::IS_EXTENDED ? 0x0F : 0x07);
+
+      if (returnNumber < minReturnNumber || maxReturnNumber < returnNumber) {
+        return false;
+      }
+    }
+
+    if (hasIntensityRange) {
+      LLAS_USHORT intensity;
+      std::memcpy(&intensity, record + Format::OFFSET_INTENSITY, PointDataRecord::NUM_BYTES_INTENSITY);
+
+      if (intensity < minIntensity || maxIntensity < intensity) {
+        return false;
+      }
+    }
+
+    if constexpr (Format::HAS_GPS_TIME) {
+      if (hasGPSTimeRange) {
+        LLAS_DOUBLE GPSTime;
+        std::memcpy(&GPSTime, record + Format::OFFSET_GPS_TIME, PointDataRecord::NUM_BYTES_GPS_TIME);
+
+        if (!(minGPSTime <= GPSTime && GPSTime <= maxGPSTime)) {
+          return false;
+        }
+      }
+    }
+
+    return true;
+  }
+
+ private:
+  /// @brief Convert `[minValue, maxValue]` in world coordinates into the range of raw integers `value * scale + offset` falls in
+  /// @return `false` if no integer falls in the range
+  static inline bool _toRawRange(const double minValue,
+                                 const double maxValue,
+                                 const double scale,
+                                 const double offset,
+                                 LLAS_LLONG& rawMin,
+                                 LLAS_LLONG& rawMax) {
+    // NOTE: Raw values are 32-bit. Clamping keeps infinite bounds representable.
+    const double lowest = (double)std::numeric_limits<LLAS_LONG>::min() - 1.0;
+    const double highest = (double)std::numeric_limits<LLAS_LONG>::max() + 1.0;
+
+    if (!(minValue <= maxValue)) {
+      return false;
+    }
+
+    if (scale == 0.0) {
+      // NOTE: Every record maps to `offset`
+      rawMin = (LLAS_LLONG)lowest;
+      rawMax = (LLAS_LLONG)highest;
+      return minValue <= offset && offset <= maxValue;
+    }
+
+    double lower = (minValue - offset) / scale;
+    double upper = (maxValue - offset) / scale;
+    if (scale < 0.0) {
+      std::swap(lower, upper);
+    }
+
+    rawMin = (LLAS_LLONG)std::ceil(std::min(std::max(lower, lowest), highest));
+    rawMax = (LLAS_LLONG)std::floor(std::min(std::max(upper, lowest), highest));
+
+    // NOTE: Correct the rounding of the division so that the range agrees exactly with `raw * scale + offset`
+    const auto isInside = [&](const LLAS_LLONG raw) {
+      const double value = (double)raw * scale + offset;
+      return minValue <= value && value <= maxValue;
+    };
+
+    for (int i = 0; i < 2 && isInside(rawMin - 1); ++i) {
+      --rawMin;
+    }
+    for (int i = 0; i < 2 && rawMin <= rawMax && !isInside(rawMin); ++i) {
+      ++rawMin;
+    }
+    for (int i = 0; i < 2 && isInside(rawMax + 1); ++i) {
+      ++rawMax;
+    }
+    for (int i = 0; i < 2 && rawMin <= rawMax && !isInside(rawMax); ++i) {
+      --rawMax;
+    }
+
+    return rawMin <= rawMax;
+  }
+};
+
+/// @brief Range of 'Point Data Record' indices `[begin, end)`
+struct RecordRange {
+  LLAS_ULLONG begin;
+  LLAS_ULLONG end;
+};
+
+/// @brief Sidecar index file mapping the cells of a regular x/y grid to the ranges of 'Point Data Records' which fall in them.
+///        It is stored next to the las file (`getPath`) and lets bounding box queries seek directly to the relevant records.
+///        Every cell keeps the actual integer bounds of its points, so a stale grid layout never drops points.
+///        The file is stored little-endian with fixed-width fields, so it can be shared between platforms.
+struct SidecarIndex {
+  // clang-format off
+  inline static const char           MAGIC[4]                                                       = {'L', 'L', 'X', 'I'};
+  inline static const LLAS_ULONG     VERSION                                                        = 2;
+  inline static const size_t         DEFAULT_POINTS_PER_CELL                                        = 10000;
+  inline static const size_t         MAX_CELLS_PER_SIDE                                             = 1024;
+  // NOTE: Records closer than this are merged into one range since reading them is cheaper than an extra seek
+  inline static const LLAS_ULLONG    MAX_RANGE_GAP                                                  = 256;
+  // NOTE: Records sampled evenly from the first to the last one by `hashPointData`
+  inline static const LLAS_ULLONG    NUM_HASHED_RECORDS                                             = 64;
+  // clang-format on
+
+  /// @brief Read the `pointDataRecordLength` bytes of the record `iRecord` into `recordData`
+  /// @return `true` if the record is read
+  using ReadRecordFunction = std::function<bool(const LLAS_ULLONG iRecord, char* recordData)>;
+
+  struct Cell {
+    std::array<LLAS_LONG, 3> minBound;  // Integer bounds of the points in the cell
+    std::array<LLAS_LONG, 3> maxBound;
+    LLAS_ULLONG nPoints;
+    LLAS_ULLONG firstRange;  // Index of the first range of the cell in `ranges`
+    LLAS_ULLONG nRanges;
+  };
+
+  SidecarIndex()
+      : fileSize(),
+        modificationTime(),
+        pointDataHash(),
+        nPointRecords(),
+        offsetToPointData(),
+        pointDataRecordLength(),
+        pointDataRecordFormat(),
+        scaleFactors(),
+        offsets(),
+        gridMinX(),
+        gridMinY(),
+        cellSizeX(),
+        cellSizeY(),
+        nCellsX(),
+        nCellsY(),
+        cells(),
+        ranges(),
+        _cellRanges() {}
+
+  // clang-format off
+  // NOTE: Identity of the indexed file
+  LLAS_ULLONG               fileSize;
+  LLAS_LLONG                modificationTime;  // `io::FileStamp::modificationTime` of the file, `0` if unknown
+  LLAS_ULLONG               pointDataHash;     // `hashPointData` of the records, which changes when the records are rewritten in place
+  LLAS_ULLONG               nPointRecords;
+  LLAS_ULONG                offsetToPointData;
+  LLAS_USHORT               pointDataRecordLength;
+  LLAS_UCHAR                pointDataRecordFormat;
+  math::vec3d_t             scaleFactors;
+  math::vec3d_t             offsets;
+
+  // NOTE: Grid in the integer domain of the records
+  LLAS_LLONG                gridMinX;
+  LLAS_LLONG                gridMinY;
+  LLAS_LLONG                cellSizeX;
+  LLAS_LLONG                cellSizeY;
+  LLAS_ULONG                nCellsX;
+  LLAS_ULONG                nCellsY;
+
+  std::vector<Cell>         cells;   // `nCellsX * nCellsY` cells, row-major in y
+  std::vector<RecordRange>  ranges;  // Ranges of all cells, grouped by cell
+  // clang-format on
+
+  /// @brief Get the path of the sidecar index of a las file (the extension is replaced by `.llx`)
+  static inline std::string getPath(const std::string& lasPath) {
+    const size_t iDot = lasPath.find_last_of('.');
+    const size_t iSeparator = lasPath.find_last_of("/\\");
+    if (iDot == std::string::npos || (iSeparator != std::string::npos && iDot < iSeparator)) {
+      return lasPath + ".llx";
+    }
+    return lasPath.substr(0, iDot) + ".llx";
+  }
+
+  /// @brief Hash the records sampled evenly from the first to the last one (FNV-1a)
+  /// @param readRecord Reads the bytes of a record
+  /// @param hash Output hash
+  /// @return `true` if all the sampled records are read
+  static inline bool hashPointData(const PublicHeader& header,
+                                   const ReadRecordFunction& readRecord,
+                                   LLAS_ULLONG& hash) {
+    hash = 14695981039346656037ULL;
+
+    const LLAS_ULLONG nRecords = header.getNumPointRecords();
+    const LLAS_ULLONG nSamples = std::min(nRecords, NUM_HASHED_RECORDS);
+    std::vector<char> recordData(header.pointDataRecordLength);
+    for (LLAS_ULLONG iSample = 0; iSample < nSamples; ++iSample) {
+      const LLAS_ULLONG iRecord = iSample + 1 == nSamples ? nRecords - 1 : iSample * ((nRecords - 1) / (nSamples - 1));
+      if (!readRecord(iRecord, recordData.data())) {
+        return false;
+      }
+
+      for (const char byte : recordData) {
+        hash = (hash ^ (LLAS_UCHAR)byte) * 1099511628211ULL;
+      }
+    }
+
+    return true;
+  }
+
+  /// @brief Check whether the index was built for the file described by `header` and `fileSize_`
+  /// @param readRecord Reads the records of the file, which are compared with `pointDataHash`
+  /// @param modificationTime_ Modification time of the file (`io::FileStamp`), which is compared unless it is `0` (e.g. a byte source)
+  /// @return `false` if the file has changed or can not be checked, in which case all records have to be scanned
+  inline bool isValidFor(const PublicHeader& header,
+                         const LLAS_ULLONG fileSize_,
+                         const ReadRecordFunction& readRecord,
+                         const LLAS_LLONG modificationTime_ = 0) const {
+    if (modificationTime_ != 0 && modificationTime != modificationTime_) {
+      return false;
+    }
+
+    LLAS_ULLONG hash = 0;
+    return fileSize == fileSize_ &&
+           nPointRecords == header.getNumPointRecords() &&
+           offsetToPointData == header.offsetToPointData &&
+           pointDataRecordLength == header.pointDataRecordLength &&
+           pointDataRecordFormat == header.pointDataRecordFormat &&
+           scaleFactors == math::vec3d_t({header.xScaleFactor, header.yScaleFactor, header.zScaleFactor}) &&
+           offsets == math::vec3d_t({header.xOffset, header.yOffset, header.zOffset}) &&
+           hashPointData(header, readRecord, hash) && hash == pointDataHash;
+  }
+
+  // ======================================================================================================================
+  // Build
+  // ======================================================================================================================
+
+  /// @brief Start building an index. Add every record with `addPoint` in increasing order, then call `finalize`.
+  ///        `modificationTime` and `pointDataHash` are left to the caller.
+  /// @param header Public header of the las file
+  /// @param fileSize_ Size of the las file in bytes
+  /// @param cellsPerSide Number of cells along the longer side of the grid. `0` chooses about `DEFAULT_POINTS_PER_CELL` points per cell.
+  inline void reset(const PublicHeader& header,
+                    const LLAS_ULLONG fileSize_,
+                    size_t cellsPerSide = 0) {
+    *this = SidecarIndex();
+
+    fileSize = fileSize_;
+    nPointRecords = header.getNumPointRecords();
+    offsetToPointData = header.offsetToPointData;
+    pointDataRecordLength = header.pointDataRecordLength;
+    pointDataRecordFormat = header.pointDataRecordFormat;
+    scaleFactors = {header.xScaleFactor, header.yScaleFactor, header.zScaleFactor};
+    offsets = {header.xOffset, header.yOffset, header.zOffset};
+
+    // NOTE: The grid covers the bounds in the header. Points outside them are clamped into the border cells.
+    const double lowest = (double)std::numeric_limits<LLAS_LONG>::min();
+    const double highest = (double)std::numeric_limits<LLAS_LONG>::max();
+    const auto toRaw = [&](const double value, const double scale, const double offset) {
+      return scale == 0.0 ? 0.0 : std::min(std::max((value - offset) / scale, lowest), highest);
+    };
+
+    const double rawX0 = toRaw(header.minX, header.xScaleFactor, header.xOffset);
+    const double rawX1 = toRaw(header.maxX, header.xScaleFactor, header.xOffset);
+    const double rawY0 = toRaw(header.minY, header.yScaleFactor, header.yOffset);
+    const double rawY1 = toRaw(header.maxY, header.yScaleFactor, header.yOffset);
+
+    gridMinX = (LLAS_LLONG)std::floor(std::min(rawX0, rawX1));
+    gridMinY = (LLAS_LLONG)std::floor(std::min(rawY0, rawY1));
+    const LLAS_LLONG extentX = (LLAS_LLONG)std::ceil(std::max(rawX0, rawX1)) - gridMinX + 1;
+    const LLAS_LLONG extentY = (LLAS_LLONG)std::ceil(std::max(rawY0, rawY1)) - gridMinY + 1;
+
+    if (cellsPerSide == 0) {
+      cellsPerSide = (size_t)std::ceil(std::sqrt((double)nPointRecords / (double)DEFAULT_POINTS_PER_CELL));
+    }
+    cellsPerSide = std::min(std::max<size_t>(1, cellsPerSide), MAX_CELLS_PER_SIDE);
+
+    // NOTE: Square cells in the integer domain
+    const LLAS_LLONG cellSize = std::max<LLAS_LLONG>(1, (std::max(extentX, extentY) + (LLAS_LLONG)cellsPerSide - 1) / (LLAS_LLONG)cellsPerSide);
+    cellSizeX = cellSize;
+    cellSizeY = cellSize;
+    nCellsX = (LLAS_ULONG)std::max<LLAS_LLONG>(1, (extentX + cellSize - 1) / cellSize);
+    nCellsY = (LLAS_ULONG)std::max<LLAS_LLONG>(1, (extentY + cellSize - 1) / cellSize);
+
+    Cell emptyCell;
+    emptyCell.minBound = {std::numeric_limits<LLAS_LONG>::max(), std::numeric_limits<LLAS_LONG>::max(), std::numeric_limits<LLAS_LONG>::max()};
+    emptyCell.maxBound = {std::numeric_limits<LLAS_LONG>::min(), std::numeric_limits<LLAS_LONG>::min(), std::numeric_limits<LLAS_LONG>::min()};
+    emptyCell.nPoints = 0;
+    emptyCell.firstRange = 0;
+    emptyCell.nRanges = 0;
+
+    cells.assign((size_t)nCellsX * nCellsY, emptyCell);
+    _cellRanges.assign(cells.size(), std::vector<RecordRange>());
+  }
+
+  /// @brief Add the record `iRecord` with integer coordinates `x`, `y`, `z`
+  inline void addPoint(const LLAS_ULLONG iRecord,
+                       const LLAS_LONG x,
+                       const LLAS_LONG y,
+                       const LLAS_LONG z) {
+    const size_t iCell = getCellIndex(x, y);
+    Cell& cell = cells[iCell];
+
+    cell.minBound = {std::min(cell.minBound[0], x), std::min(cell.minBound[1], y), std::min(cell.minBound[2], z)};
+    cell.maxBound = {std::max(cell.maxBound[0], x), std::max(cell.maxBound[1], y), std::max(cell.maxBound[2], z)};
+    ++cell.nPoints;
+
+    std::vector<RecordRange>& cellRanges = _cellRanges[iCell];
+    if (!cellRanges.empty() && iRecord <= cellRanges.back().end + MAX_RANGE_GAP) {
+      cellRanges.back().end = iRecord + 1;
+    } else {
+      cellRanges.push_back({iRecord, iRecord + 1});
+    }
+  }
+
+  /// @brief Flatten the ranges of all cells into `ranges`
+  inline void finalize() {
+    ranges.clear();
+
+    for (size_t iCell = 0; iCell < cells.size(); ++iCell) {
+      cells[iCell].firstRange = ranges.size();
+      cells[iCell].nRanges = _cellRanges[iCell].size();
+      ranges.insert(ranges.end(), _cellRanges[iCell].begin(), _cellRanges[iCell].end());
+    }
+
+    _cellRanges.clear();
+    _cellRanges.shrink_to_fit();
+  }
+
+  /// @brief Get the cell containing the integer coordinates. Coordinates outside the grid are clamped into the border cells.
+  inline size_t getCellIndex(const LLAS_LONG x, const LLAS_LONG y) const {
+    const LLAS_LLONG iCellX = std::min<LLAS_LLONG>(std::max<LLAS_LLONG>(0, ((LLAS_LLONG)x - gridMinX) / cellSizeX), (LLAS_LLONG)nCellsX - 1);
+    const LLAS_LLONG iCellY = std::min<LLAS_LLONG>(std::max<LLAS_LLONG>(0, ((LLAS_LLONG)y - gridMinY) / cellSizeY), (LLAS_LLONG)nCellsY - 1);
+    return (size_t)iCellY * nCellsX + (size_t)iCellX;
+  }
+
+  // ======================================================================================================================
+  // Query
+  // ======================================================================================================================
+
+  /// @brief Get the sorted, disjoint ranges of records which may pass the bounding box of `filter`
+  /// @param filter Filter converted with the header of the indexed file
+  /// @return `ranges` (`std::vector<RecordRange>`): all records if the filter has no bounding box
+  inline std::vector<RecordRange> getRecordRanges(const RawPointFilter& filter) const {
+    std::vector<RecordRange> selectedRanges;
+
+    if (filter.isEmpty) {
+      return selectedRanges;
+    }
+
+    if (!filter.hasBoundingBox) {
+      selectedRanges.push_back({0, nPointRecords});
+      return selectedRanges;
+    }
+
+    for (const Cell& cell : cells) {
+      if (cell.nPoints == 0 ||
+          cell.maxBound[0] < filter.minX || filter.maxX < cell.minBound[0] ||
+          cell.maxBound[1] < filter.minY || filter.maxY < cell.minBound[1] ||
+          cell.maxBound[2] < filter.minZ || filter.maxZ < cell.minBound[2]) {
+        continue;
+      }
+
+      selectedRanges.insert(selectedRanges.end(), ranges.begin() + cell.firstRange, ranges.begin() + cell.firstRange + cell.nRanges);
+    }
+
+    std::sort(selectedRanges.begin(), selectedRanges.end(), [](const RecordRange& a, const RecordRange& b) { return a.begin < b.begin; });
+
+    // NOTE: Merge overlapping and nearby ranges of different cells
+    size_t nMerged = 0;
+    for (const RecordRange& range : selectedRanges) {
+      if (nMerged > 0 && range.begin <= selectedRanges[nMerged - 1].end + MAX_RANGE_GAP) {
+        selectedRanges[nMerged - 1].end = std::max(selectedRanges[nMerged - 1].end, range.end);
+      } else {
+        selectedRanges[nMerged++] = range;
+      }
+    }
+    selectedRanges.resize(nMerged);
+
+    return selectedRanges;
+  }
+
+  // ======================================================================================================================
+  // Serialization
+  // ======================================================================================================================
+
+  /// @brief Write the index
+  /// @param indexPath Path to the index file (`getPath`)
+  /// @return `true` if the file is written
+  inline bool write(const std::string& indexPath) const {
+    std::vector<char> bytes;
+    const auto append = [&bytes](const auto& value) { _appendLittleEndian(value, bytes); };
+
+    bytes.insert(bytes.end(), MAGIC, MAGIC + sizeof(MAGIC));
+    append(VERSION);
+    append(fileSize);
+    append(modificationTime);
+    append(pointDataHash);
+    append(nPointRecords);
+    append(offsetToPointData);
+    append(pointDataRecordLength);
+    append(pointDataRecordFormat);
+    append(scaleFactors);
+    append(offsets);
+    append(gridMinX);
+    append(gridMinY);
+    append(cellSizeX);
+    append(cellSizeY);
+    append(nCellsX);
+    append(nCellsY);
+    append((LLAS_ULLONG)ranges.size());
+
+    for (const Cell& cell : cells) {
+      append(cell.minBound);
+      append(cell.maxBound);
+      append(cell.nPoints);
+      append(cell.firstRange);
+      append(cell.nRanges);
+    }
+
+    for (const RecordRange& range : ranges) {
+      append(range.begin);
+      append(range.end);
+    }
+
+    std::ofstream file(indexPath, std::ios::binary);
+    if (!file) {
+      _LLAS_logError("Failed to open file: " + indexPath);
+      return false;
+    }
+
+    file.write(bytes.data(), (std::streamsize)bytes.size());
+    return (bool)file;
+  }
+
+  /// @brief Read an index
+  /// @param indexPath Path to the index file (`getPath`)
+  /// @return `true` if a well-formed index is read
+  inline bool read(const std::string& indexPath) {
+    *this = SidecarIndex();
+
+    std::vector<char> bytes;
+    if (!io::readFileBytes(indexPath, bytes)) {
+      return false;
+    }
+
+    return _parse(bytes, indexPath);
+  }
+
+  /// @brief Read an index from any byte source (e.g. stored next to the las file in object storage)
+  /// @param source Bytes of the index file
+  /// @return `true` if a well-formed index is read
+  inline bool read(const io::ByteSource& source) {
+    *this = SidecarIndex();
+
+    std::vector<char> bytes;
+    if (!source.readBytes(0, (size_t)source.size(), bytes)) {
+      _LLAS_logError("Failed to read sidecar index");
+      return false;
+    }
+
+    return _parse(bytes, "byte source");
+  }
+
+ private:
+  /// @brief Parse the bytes of an index file
+  /// @param indexPath Name of the index for messages
+  inline bool _parse(const std::vector<char>& bytes,
+                     const std::string& indexPath) {
+    size_t offset = 0;
+    bool isOK = true;
+    const auto extract = [&](auto& value) { isOK = _extractLittleEndian(bytes, offset, value) && isOK; };
+
+    LLAS_ULONG version = 0;
+    LLAS_ULLONG nRanges = 0;
+
+    if (bytes.size() < sizeof(MAGIC) || std::memcmp(bytes.data(), MAGIC, sizeof(MAGIC)) != 0) {
+      _LLAS_logError("Not a sidecar index: " + indexPath);
+      return false;
+    }
+    offset += sizeof(MAGIC);
+
+    extract(version);
+    if (!isOK || version != VERSION) {
+      _LLAS_logError("Unsupported sidecar index version: " + indexPath);
+      return false;
+    }
+
+    extract(fileSize);
+    extract(modificationTime);
+    extract(pointDataHash);
+    extract(nPointRecords);
+    extract(offsetToPointData);
+    extract(pointDataRecordLength);
+    extract(pointDataRecordFormat);
+    extract(scaleFactors);
+    extract(offsets);
+    extract(gridMinX);
+    extract(gridMinY);
+    extract(cellSizeX);
+    extract(cellSizeY);
+    extract(nCellsX);
+    extract(nCellsY);
+    extract(nRanges);
+
+    // NOTE: Reject sizes which do not fit in the file before allocating
+    const LLAS_ULLONG nCells = (LLAS_ULLONG)nCellsX * nCellsY;
+    const LLAS_ULLONG nBytesCell = 6 * sizeof(LLAS_LONG) + 3 * sizeof(LLAS_ULLONG);
+    const LLAS_ULLONG nBytesRange = 2 * sizeof(LLAS_ULLONG);
+    if (!isOK || cellSizeX <= 0 || cellSizeY <= 0 || nCellsX > MAX_CELLS_PER_SIDE || nCellsY > MAX_CELLS_PER_SIDE ||
+        nCells * nBytesCell + nRanges * nBytesRange != bytes.size() - offset) {
+      _LLAS_logError("Broken sidecar index: " + indexPath);
+      *this = SidecarIndex();
+      return false;
+    }
+
+    cells.resize((size_t)nCells);
+    for (Cell& cell : cells) {
+      extract(cell.minBound);
+      extract(cell.maxBound);
+      extract(cell.nPoints);
+      extract(cell.firstRange);
+      extract(cell.nRanges);
+      isOK = isOK && cell.firstRange <= nRanges && cell.nRanges <= nRanges - cell.firstRange;
+    }
+
+    ranges.resize((size_t)nRanges);
+    for (RecordRange& range : ranges) {
+      extract(range.begin);
+      extract(range.end);
+      isOK = isOK && range.begin <= range.end && range.end <= nPointRecords;
+    }
+
+    if (!isOK) {
+      _LLAS_logError("Broken sidecar index: " + indexPath);
+      *this = SidecarIndex();
+      return false;
+    }
+
+    return true;
+  }
+
+  /// @brief Append an integer or a floating point number in little-endian byte order
+  template <typename T>
+  static inline void _appendLittleEndian(const T& value,
+                                         std::vector<char>& bytes) {
+    static_assert(std::is_integral<T>::value || (std::is_floating_point<T>::value && sizeof(T) == sizeof(LLAS_ULLONG)), "Unsupported field type");
+
+    LLAS_ULLONG bits = 0;
+    if constexpr (std::is_floating_point<T>::value) {
+      std::memcpy(&bits, &value, sizeof(bits));
+    } else {
+      bits = (LLAS_ULLONG)value;
+    }
+
+    for (size_t iByte = 0; iByte < sizeof(T); ++iByte) {
+      bytes.push_back((char)((bits >> (8 * iByte)) & 0xFF));
+    }
+  }
+
+  template <typename T, size_t N>
+  static inline void _appendLittleEndian(const std::array<T, N>& values,
+                                         std::vector<char>& bytes) {
+    for (const T& value : values) {
+      _appendLittleEndian(value, bytes);
+    }
+  }
+
+  /// @brief Extract a number stored by `_appendLittleEndian` at `offset`, which is advanced
+  /// @return `false` if the bytes end before the number
+  template <typename T>
+  static inline bool _extractLittleEndian(const std::vector<char>& bytes,
+                                          size_t& offset,
+                                          T& value) {
+    if (offset + sizeof(T) > bytes.size()) {
+      return false;
+    }
+
+    LLAS_ULLONG bits = 0;
+    for (size_t iByte = 0; iByte < sizeof(T); ++iByte) {
+      bits |= (LLAS_ULLONG)(LLAS_UCHAR)bytes[offset + iByte] << (8 * iByte);
+    }
+    offset += sizeof(T);
+
+    if constexpr (std::is_floating_point<T>::value) {
+      std::memcpy(&value, &bits, sizeof(bits));
+    } else {
+      value = (T)(typename std::make_unsigned<T>::type)bits;
+    }
+    return true;
+  }
+
+  template <typename T, size_t N>
+  static inline bool _extractLittleEndian(const std::vector<char>& bytes,
+                                          size_t& offset,
+                                          std::array<T, N>& values) {
+    for (T& value : values) {
+      if (!_extractLittleEndian(bytes, offset, value)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  std::vector<std::vector<RecordRange>> _cellRanges;  // Ranges of each cell while building
+};
+
+/// @brief Flag which cancels the reads it was given to. Copies share the same flag.
+class CancellationToken {
+ public:
+  CancellationToken()
+      : _isCancelled(std::make_shared<std::atomic<bool>>(false)) {}
+
+  /// @brief Cancel the reads. Safe to call from any thread.
+  inline void cancel() const {
+    _isCancelled->store(true);
+  }
+
+  inline bool isCancelled() const {
+    return _isCancelled->load(std::memory_order_relaxed);
+  }
+
+  /// @brief Check whether the flag has other copies, through which a read may be cancelled while it decodes
+  inline bool isShared() const {
+    return _isCancelled.use_count() > 1;
+  }
+
+ private:
+  std::shared_ptr<std::atomic<bool>> _isCancelled;
+};
+
+/// @brief Called with the number of decoded records out of `nRecords` records to decode
+using ReadProgressCallback = std::function<void(const LLAS_ULLONG nDecodedRecords, const LLAS_ULLONG nRecords)>;
+
+/// @brief Durations of the phases of `llas::read` in seconds and the amount of data read
+struct ReadStats {
+  ReadStats()
+      : openTime(),
+        readBytesTime(),
+        headerTime(),
+        variableLengthRecordsTime(),
+        pointDataRecordsTime(),
+        extendedVariableLengthRecordsTime(),
+        assembleTime(),
+        totalTime(),
+        nBytesRead(),
+        nDecodedRecords(),
+        nPoints() {}
+
+  // clang-format off
+  double      openTime;                           // Open or map the file
+  double      readBytesTime;                      // Copy the file to the heap (not memory-mapped files only)
+  double      headerTime;                         // Public header
+  double      variableLengthRecordsTime;          // VLRs
+  double      pointDataRecordsTime;               // Decompress (LAZ only), filter and decode points
+  double      extendedVariableLengthRecordsTime;  // EVLRs
+  double      assembleTime;                       // Finish the output object
+  double      totalTime;
+  LLAS_ULLONG nBytesRead;                         // Size of the file read or mapped
+  LLAS_ULLONG nDecodedRecords;                    // Records tested against the filter
+  LLAS_ULLONG nPoints;                            // Points stored
+  // clang-format on
+};
+
+struct ReadOptions {
+  ReadOptions()
+      : pointDataOnly(true),
+        useMemoryMap(true),
+        numThreads(1),
+        numConcurrentRequests(8),
+        layout(PointDataLayout::ArrayOfStructs),
+        fields(PointField::ALL),
+        filter(),
+        useSidecarIndex(true),
+        subsampling(),
+        progressCallback(),
+        cancellationToken() {}
+
+  /// @brief Read only "PointDataRecords"
+  bool pointDataOnly;
+
+  /// @brief Parse the file through a read-only memory mapping instead of copying it to the heap.
+  ///        Falls back to a buffered read when the file cannot be mapped.
+  bool useMemoryMap;
+
+  /// @brief Number of threads used to decode 'Point Data Records'. `0` means all hardware threads.
+  size_t numThreads;
+
+  /// @brief Maximum number of concurrent reads of an `io::ByteSource` whose bytes are not in memory (e.g. HTTP range requests)
+  size_t numConcurrentRequests;
+
+  /// @brief Memory layout of decoded points: `LasData::pointDataRecords`, `LasData::pointDataColumns` or `LasData::packedPointData`.
+  ///        `PointDataLayout::Packed` keeps every field of the format and ignores `fields`.
+  PointDataLayout layout;
+
+  /// @brief Attributes of 'Point Data Records' to decode (`PointField`).
+  ///        Other attributes are left zero in `PointDataRecord` and are not allocated in `PointDataColumns`.
+  LLAS_ULONG fields;
+
+  /// @brief Points to keep (`PointFilter`). Rejected points are skipped before they are decoded.
+  PointFilter filter;
+
+  /// @brief Use the sidecar index next to the file (`SidecarIndex::getPath`), if any and up to date,
+  ///        to read only the records near the bounding box of `filter`
+  bool useSidecarIndex;
+
+  /// @brief Level-of-detail subsampling (`PointSubsampling`) of the points which pass `filter`
+  PointSubsampling subsampling;
+
+  /// @brief Called on the calling thread while 'Point Data Records' are decoded (or decompressed), if set
+  ReadProgressCallback progressCallback;
+
+  /// @brief Stop reading and return `nullptr` once cancelled. Checked between phases, and between steps of decoding
+  ///        if a copy of the token is kept (e.g. by `readAsync` or to cancel from another thread).
+  CancellationToken cancellationToken;
+};
+
+// ==========================================================================
+// Write options
+// ==========================================================================
+
+struct WriteOptions {
+  WriteOptions()
+      : numThreads(1),
+        bufferSize(DEFAULT_BUFFER_SIZE),
+        updateBounds(true),
+        allowMissingFields(false) {}
+
+  // clang-format off
+  inline static const size_t DEFAULT_BUFFER_SIZE                                                    = (size_t)64 << 20;
+  // clang-format on
+
+  /// @brief Number of threads used to encode 'Point Data Records'. `0` means all hardware threads.
+  size_t numThreads;
+
+  /// @brief Number of bytes of 'Point Data Records' encoded and written at once.
+  ///        Two buffers of this size are used so that encoding the next buffer overlaps writing the previous one.
+  size_t bufferSize;
+
+  /// @brief Recompute the bounding box in the public header from the points.
+  ///        The point counts and the offsets are always recomputed.
+  bool updateBounds;
+
+  /// @brief Write the attributes of the point data record format which the points do not hold as zero,
+  ///        e.g. of points read with `ReadOptions::fields` or of columns left out. Otherwise such data is not written.
+  bool allowMissingFields;
+};
+
+// ==========================================================================
+// Merge options
+// ==========================================================================
+
+struct MergeOptions {
+  MergeOptions()
+      : numThreads(1),
+        layout(PointDataLayout::ArrayOfStructs),
+        pointDataRecordFormat(-1),
+        hasQuantization(false),
+        scaleFactors(),
+        offsets() {}
+
+  // clang-format off
+  inline static const size_t NUM_POINTS_PER_CHUNK                                                   = (size_t)1 << 20;
+  // clang-format on
+
+  /// @brief Number of threads used to copy, re-quantize and encode points. `0` means all hardware threads.
+  size_t numThreads;
+
+  /// @brief Layout of the points merged by `merge`
+  PointDataLayout layout;
+
+  /// @brief Point data record format of the merged points. `-1` uses the format of the tiles, which then must be the same.
+  int pointDataRecordFormat;
+
+  /// @brief Quantize the merged coordinates with `scaleFactors` and `offsets` instead of choosing them from the tiles
+  bool hasQuantization;
+  math::vec3d_t scaleFactors;
+  math::vec3d_t offsets;
+
+  /// @brief Quantize the merged coordinates with given scale factors and offsets
+  inline void setQuantization(const math::vec3d_t& scaleFactors_,
+                              const math::vec3d_t& offsets_) {
+    hasQuantization = true;
+    scaleFactors = scaleFactors_;
+    offsets = offsets_;
+  }
+};
+
+// ==========================================================================
+// Record readers
+// ==========================================================================
+
+/// @brief Progress shared by the threads decoding 'Point Data Records'
+struct DecodeProgress {
+  // clang-format off
+  inline static const size_t NUM_RECORDS_PER_STEP                                                   = 65536;
+  // clang-format on
+
+  DecodeProgress()
+      : nDecodedRecords(0),
+        callback(),
+        cancellationToken() {}
+
+  std::atomic<size_t> nDecodedRecords;
+
+  /// @brief Called with `nDecodedRecords` after every step of the first thread, which is the calling thread
+  std::function<void(const size_t nDecodedRecords)> callback;
+
+  /// @brief Remaining steps are skipped once cancelled
+  CancellationToken cancellationToken;
+
+  inline bool isCancelled() const {
+    return cancellationToken.isCancelled();
+  }
+
+  /// @brief Count `nRecords` decoded records and report them if `isReporting`
+  inline void add(const size_t nRecords, const bool isReporting) {
+    const size_t nDecodedRecords_ = nDecodedRecords.fetch_add(nRecords) + nRecords;
+    if (isReporting && callback) {
+      callback(nDecodedRecords_);
+    }
+  }
+};
+
+/// @brief Call `func(firstRecord, nRecords)` on steps of `DecodeProgress::NUM_RECORDS_PER_STEP` records of
+///        `[firstRecord, firstRecord + nRecords)` and count them in `progress`, or once if `progress` is `nullptr`.
+///        Steps after the cancellation of `progress` are skipped.
+template <class Func>
+inline void _forEachProgressStep(const size_t firstRecord,
+                                 const size_t nRecords,
+                                 DecodeProgress* progress,
+                                 const bool isReporting,
+                                 Func&& func) {
+  if (progress == nullptr) {
+    func(firstRecord, nRecords);
+    return;
+  }
+
+  for (size_t offset = 0; offset < nRecords && !progress->isCancelled(); offset += DecodeProgress::NUM_RECORDS_PER_STEP) {
+    const size_t nStepRecords = std::min(DecodeProgress::NUM_RECORDS_PER_STEP, nRecords - offset);
+    func(firstRecord + offset, nStepRecords);
+    progress->add(nStepRecords, isReporting);
+  }
+}
+
+/// @brief Read 'Variable Length Records' which follow the public header
+/// @param data Bytes starting at the beginning of the file
+/// @param dataSize Number of bytes in `data`
+/// @param publicHeader Public header of the file
+/// @param variableLengthRecords Output records
+/// @return `true` if all records were read
+LLAS_FUNC_DECL_PREFIX bool readVariableLengthRecords(const char* data,
+                                                     const size_t dataSize,
+                                                     const PublicHeader& publicHeader,
+                                                     std::vector<VariableLengthRecord>& variableLengthRecords) {
+  const LLAS_ULONG nVariableLengthRecords = publicHeader.numOfVariableLengthRecords;
+  _LLAS_logInfo("nVariableLengthRecords: " + std::to_string(nVariableLengthRecords));
+
+  // NOTE: The records are bounded by the offset to point data, which has to be checked first since it comes from the file
+  if ((size_t)publicHeader.offsetToPointData > dataSize) {
+    _LLAS_logError("Variable Length Records exceed the end of file!");
+    return false;
+  }
+
+  variableLengthRecords.resize(nVariableLengthRecords);  // allocate
+
+  // NOTE: Move to the starting point of VLR
+  std::streamsize offset = publicHeader.headerSize;
+
+  // NOTE: The payloads refer to one copy of the whole VLR region instead of allocating one vector each
+  RecordBytes::Arena arena = nullptr;
+  if (nVariableLengthRecords > 0 && offset < (std::streamsize)publicHeader.offsetToPointData) {
+    arena = std::make_shared<const std::vector<char>>(data + offset, data + publicHeader.offsetToPointData);
+  }
+  const std::streamsize arenaOffset = offset;
+
+  for (LLAS_ULONG iRecord = 0; iRecord < nVariableLengthRecords; ++iRecord) {
+    if (offset + VariableLengthRecord::NUM_BYTES_HEADER > (std::streamsize)publicHeader.offsetToPointData) {
+      _LLAS_logError("The total size of VLRs exceeds the start of Point Data records!");
+      return false;
+    }
+
+    // NOTE: Check the payload size before reading it
+    LLAS_USHORT recordLengthAfterHeader;
+    std::memcpy(&recordLengthAfterHeader, data + offset + 20, sizeof(LLAS_USHORT));
+    if (offset + VariableLengthRecord::NUM_BYTES_HEADER + recordLengthAfterHeader > (std::streamsize)publicHeader.offsetToPointData) {
+      _LLAS_logError("The total size of VLRs exceeds the start of Point Data records!");
+      return false;
+    }
+
+    variableLengthRecords[iRecord] = VariableLengthRecord::readVariableLengthRecord(data, offset, arena, arenaOffset);
+  }
+
+  return true;
+}
+
+/// @brief Read 'Extended Variable Length Records'
+/// @param data Bytes containing the records
+/// @param dataSize Number of bytes in `data`
+/// @param offset Offset to the first record in `data`
+/// @param publicHeader Public header of the file
+/// @param extendedVariableLengthRecords Output records
+/// @return `true` if all records were read
+LLAS_FUNC_DECL_PREFIX bool readExtendedVariableLengthRecords(const char* data,
+                                                             const size_t dataSize,
+                                                             std::streamsize offset,
+                                                             const PublicHeader& publicHeader,
+                                                             std::vector<ExtendedVariableLengthRecord>& extendedVariableLengthRecords) {
+  const LLAS_ULONG nExtendedVariableLengthRecords = publicHeader.numOfExtendedVariableLengthRecords;
+  _LLAS_logInfo("nExtendedVariableLengthRecords: " + std::to_string(nExtendedVariableLengthRecords));
+
+  // NOTE: Check the sizes of all the records before reading them
+  size_t endOffset = (size_t)offset;
+  for (LLAS_ULONG iRecord = 0; iRecord < nExtendedVariableLengthRecords; ++iRecord) {
+    if (endOffset + ExtendedVariableLengthRecord::NUM_BYTES_HEADER > dataSize) {
+      _LLAS_logError("Extended Variable Length Records exceed the end of file!");
+      return false;
+    }
+
+    LLAS_ULLONG recordLengthAfterHeader;
+    std::memcpy(&recordLengthAfterHeader, data + endOffset + 20, sizeof(LLAS_ULLONG));
+    if (recordLengthAfterHeader > dataSize - endOffset - ExtendedVariableLengthRecord::NUM_BYTES_HEADER) {
+      _LLAS_logError("Extended Variable Length Records exceed the end of file!");
+      return false;
+    }
+
+    endOffset += ExtendedVariableLengthRecord::NUM_BYTES_HEADER + (size_t)recordLengthAfterHeader;
+  }
+
+  // Allocate
+  extendedVariableLengthRecords.resize(nExtendedVariableLengthRecords);
+
+  // NOTE: The payloads refer to one copy of all the records instead of allocating one vector each
+  RecordBytes::Arena arena = nullptr;
+  if (endOffset > (size_t)offset) {
+    arena = std::make_shared<const std::vector<char>>(data + offset, data + endOffset);
+  }
+  const std::streamsize arenaOffset = offset;
+
+  // Read
+  for (LLAS_ULONG iRecord = 0; iRecord < nExtendedVariableLengthRecords; ++iRecord) {
+    extendedVariableLengthRecords[iRecord] = ExtendedVariableLengthRecord::readExtendedVariableLengthRecord(data, offset, arena, arenaOffset);
+  }
+
+  return true;
+}
+
+/// @brief Read the public header and, if `withRecords`, the VLRs and EVLRs without reading 'Point Data Records'
+/// @param source Bytes of the file. Only the regions of the header and the records are read.
+/// @param withRecords Also read VLRs and EVLRs
+/// @param publicHeader Output public header
+/// @param variableLengthRecords Output VLRs
+/// @param extendedVariableLengthRecords Output EVLRs
+/// @return `true` if all the requested parts were read
+LLAS_FUNC_DECL_PREFIX bool readFileHeader(const io::ByteSource& source,
+                                          const bool withRecords,
+                                          PublicHeader& publicHeader,
+                                          std::vector<VariableLengthRecord>& variableLengthRecords,
+                                          std::vector<ExtendedVariableLengthRecord>& extendedVariableLengthRecords) {
+  const LLAS_ULLONG fileSize = source.size();
+
+  // Read 'Public Header'
+  {
+    // NOTE: 375 bytes is the size of the largest public header (v1.4)
+    std::vector<char> headerBytes(PublicHeader::HEADER_SIZE_V14, 0);
+    if (!source.read(0, (size_t)std::min<LLAS_ULLONG>(fileSize, headerBytes.size()), headerBytes.data())) {
+      _LLAS_logError("Failed to read the public header");
+      return false;
+    }
+
+    publicHeader = PublicHeader::readPublicHeader(headerBytes);
+  }
+
+  if (!withRecords) {
+    return true;
+  }
+
+  // Read 'Variable Length Records'
+  // NOTE: The records lie between the public header and the point data, only this region is read
+  std::vector<char> bytes;
+  if (!source.readBytes(0, publicHeader.offsetToPointData, bytes)) {
+    _LLAS_logError("Variable Length Records exceed the end of file!");
+    return false;
+  }
+
+  if (!readVariableLengthRecords(bytes.data(), bytes.size(), publicHeader, variableLengthRecords)) {
+    return false;
+  }
+
+  // Read 'Extended Variable Length Records' (version >= 1.4)
+  if (publicHeader.hasStartOfFirstExtendedVariableLengthRecord && publicHeader.hasNumOfExtendedVariableLengthRecords &&
+      publicHeader.numOfExtendedVariableLengthRecords > 0 && publicHeader.startOfFirstExtendedVariableLengthRecord < fileSize) {
+    // NOTE: The records run to the end of file
+    const LLAS_ULLONG offset = publicHeader.startOfFirstExtendedVariableLengthRecord;
+    if (!source.readBytes(offset, (size_t)(fileSize - offset), bytes)) {
+      _LLAS_logError("Failed to read Extended Variable Length Records");
+      return false;
+    }
+
+    if (!readExtendedVariableLengthRecords(bytes.data(), bytes.size(), 0, publicHeader, extendedVariableLengthRecords)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+template <int FORMAT, bool IS_FILTERED>
+inline size_t _readPointDataRecords(const char* byteData,
+                                    const size_t nRecords,
+                                    const LLAS_USHORT recordLength,
+                                    const LLAS_ULONG fields,
+                                    const RawPointFilter& filter,
+                                    PointDataRecord* pointDataRecords) {
+  size_t iPoint = 0;
+
+  for (size_t iRecord = 0; iRecord < nRecords; ++iRecord) {
+    const char* record = byteData + iRecord * recordLength;
+
+    if constexpr (IS_FILTERED) {
+      if (!filter.template accept<FORMAT>(record)) {
+        continue;
+      }
+    }
+
+    PointDataRecord::decodePointDataRecord<FORMAT>(record, fields, pointDataRecords[iPoint++]);
+  }
+
+  return iPoint;
+}
+
+/// @brief Decode `nRecords` consecutive 'Point Data Records'. The format is resolved once for the whole range.
+/// @param byteData Bytes starting at the beginning of the first record
+/// @param nRecords Number of records
+/// @param recordLength Point data record length
+/// @param format Point data record format
+/// @param fields Attributes to decode (`PointField`). Other attributes are left untouched.
+/// @param pointDataRecords Output records (`nRecords` elements)
+/// @return `true` if the format is supported
+LLAS_FUNC_DECL_PREFIX bool readPointDataRecords(const char* byteData,
+                                                const size_t nRecords,
+                                                const LLAS_USHORT recordLength,
+                                                const LLAS_UCHAR format,
+                                                const LLAS_ULONG fields,
+                                                PointDataRecord* pointDataRecords) {
+  return visitPointDataRecordFormat(format, [&](auto formatTag) {
+    constexpr int FORMAT = decltype(formatTag)::value;
+    _readPointDataRecords<FORMAT, false>(byteData, nRecords, recordLength, fields, RawPointFilter(), pointDataRecords);
+  });
+}
+
+/// @brief Decode the records among `nRecords` consecutive 'Point Data Records' which pass the filter and store them contiguously
+/// @param byteData Bytes starting at the beginning of the first record
+/// @param nRecords Number of records
+/// @param recordLength Point data record length
+/// @param format Point data record format
+/// @param fields Attributes to decode (`PointField`). Other attributes are left untouched.
+/// @param filter Filter tested on the raw bytes of each record
+/// @param pointDataRecords Output records (at least `countPointDataRecords` elements)
+/// @return `nPoints` (`size_t`): number of stored records
+LLAS_FUNC_DECL_PREFIX size_t readPointDataRecords(const char* byteData,
+                                                  const size_t nRecords,
+                                                  const LLAS_USHORT recordLength,
+                                                  const LLAS_UCHAR format,
+                                                  const LLAS_ULONG fields,
+                                                  const RawPointFilter& filter,
+                                                  PointDataRecord* pointDataRecords) {
+  size_t nPoints = 0;
+
+  if (filter.isEmpty) {
+    return nPoints;
+  }
+
+  visitPointDataRecordFormat(format, [&](auto formatTag) {
+    constexpr int FORMAT = decltype(formatTag)::value;
+    if (filter.isEnabled) {
+      nPoints = _readPointDataRecords<FORMAT, true>(byteData, nRecords, recordLength, fields, filter, pointDataRecords);
+    } else {
+      nPoints = _readPointDataRecords<FORMAT, false>(byteData, nRecords, recordLength, fields, filter, pointDataRecords);
+    }
+  });
+
+  return nPoints;
+}
+
+/// @brief Count the records among `nRecords` consecutive 'Point Data Records' which pass the filter
+/// @param byteData Bytes starting at the beginning of the first record
+/// @param nRecords Number of records
+/// @param recordLength Point data record length
+/// @param format Point data record format
+/// @param filter Filter tested on the raw bytes of each record
+/// @return `nPoints` (`size_t`): number of records which pass the filter
+LLAS_FUNC_DECL_PREFIX size_t countPointDataRecords(const char* byteData,
+                                                   const size_t nRecords,
+                                                   const LLAS_USHORT recordLength,
+                                                   const LLAS_UCHAR format,
+                                                   const RawPointFilter& filter) {
+  if (filter.isEmpty) {
+    return 0;
+  }
+
+  if (!filter.isEnabled) {
+    return nRecords;
+  }
+
+  size_t nPoints = 0;
+
+  visitPointDataRecordFormat(format, [&](auto formatTag) {
+    constexpr int FORMAT = decltype(formatTag)::value;
+
+    for (size_t iRecord = 0; iRecord < nRecords; ++iRecord) {
+      nPoints += filter.template accept<FORMAT>(byteData + iRecord * recordLength);
+    }
+  });
+
+  return nPoints;
+}
+
+template <class T>
+inline T* _columnData(std::vector<T>& column, const size_t firstIndex) {
+  return column.empty() ? nullptr : column.data() + firstIndex;
+}
+
+template <int FORMAT, bool IS_FILTERED>
+inline size_t _readPointDataColumns(const char* byteData,
+                                    const size_t nRecords,
+                                    const LLAS_USHORT recordLength,
+                                    const RawPointFilter& filter,
+                                    PointDataColumns& pointDataColumns,
+                                    const size_t firstIndex) {
+  using Format = PointDataRecordFormat<FORMAT>;
+
+  // NOTE: Columns which are not stored are null
+  LLAS_LONG* x = _columnData(pointDataColumns.x, firstIndex);
+  LLAS_LONG* y = _columnData(pointDataColumns.y, firstIndex);
+  LLAS_LONG* z = _columnData(pointDataColumns.z, firstIndex);
+  LLAS_USHORT* intensity = _columnData(pointDataColumns.intensity, firstIndex);
+  LLAS_UCHAR* returnNumber = _columnData(pointDataColumns.returnNumber, firstIndex);
+  LLAS_UCHAR* numberOfReturns = _columnData(pointDataColumns.numberOfReturns, firstIndex);
+  LLAS_UCHAR* classification = _columnData(pointDataColumns.classification, firstIndex);
+  LLAS_UCHAR* classificationFlags = _columnData(pointDataColumns.classificationFlags, firstIndex);
+  LLAS_UCHAR* scannerChannel = _columnData(pointDataColumns.scannerChannel, firstIndex);
+  LLAS_UCHAR* scanDirectionFlag = _columnData(pointDataColumns.scanDirectionFlag, firstIndex);
+  LLAS_UCHAR* edgeOfFlightLine = _columnData(pointDataColumns.edgeOfFlightLine, firstIndex);
+  LLAS_SCHAR* scanAngleRank = _columnData(pointDataColumns.scanAngleRank, firstIndex);
+  LLAS_SHORT* scanAngle = _columnData(pointDataColumns.scanAngle, firstIndex);
+  LLAS_UCHAR* userData = _columnData(pointDataColumns.userData, firstIndex);
+  LLAS_USHORT* pointSourceID = _columnData(pointDataColumns.pointSourceID, firstIndex);
+  LLAS_DOUBLE* GPSTime = Format::HAS_GPS_TIME ? _columnData(pointDataColumns.GPSTime, firstIndex) : nullptr;
+  LLAS_USHORT* red = Format::HAS_RGB ? _columnData(pointDataColumns.red, firstIndex) : nullptr;
+  LLAS_USHORT* green = Format::HAS_RGB ? _columnData(pointDataColumns.green, firstIndex) : nullptr;
+  LLAS_USHORT* blue = Format::HAS_RGB ? _columnData(pointDataColumns.blue, firstIndex) : nullptr;
+  LLAS_USHORT* NIR = Format::HAS_NIR ? _columnData(pointDataColumns.NIR, firstIndex) : nullptr;
+  LLAS_UCHAR* wavePacketDescriptorIndex = Format::HAS_WAVE_PACKET ? _columnData(pointDataColumns.wavePacketDescriptorIndex, firstIndex) : nullptr;
+  LLAS_ULLONG* byteOffsetToWaveformData = Format::HAS_WAVE_PACKET ? _columnData(pointDataColumns.byteOffsetToWaveformData, firstIndex) : nullptr;
+  LLAS_ULONG* waveformPacketSize = Format::HAS_WAVE_PACKET ? _columnData(pointDataColumns.waveformPacketSize, firstIndex) : nullptr;
+  LLAS_FLOAT* returnPointWaveformLocation = Format::HAS_WAVE_PACKET ? _columnData(pointDataColumns.returnPointWaveformLocation, firstIndex) : nullptr;
+  LLAS_FLOAT* Xt = Format::HAS_WAVE_PACKET ? _columnData(pointDataColumns.Xt, firstIndex) : nullptr;
+  LLAS_FLOAT* Yt = Format::HAS_WAVE_PACKET ? _columnData(pointDataColumns.Yt, firstIndex) : nullptr;
+  LLAS_FLOAT* Zt = Format::HAS_WAVE_PACKET ? _columnData(pointDataColumns.Zt, firstIndex) : nullptr;
+
+  // NOTE: Every attribute is copied from its fixed offset straight into its column, and bit fields are unpacked in place
+  size_t iPoint = 0;
+
+  for (size_t iRecord = 0; iRecord < nRecords; ++iRecord) {
+    const char* record = byteData + iRecord * recordLength;
+
+    if constexpr (IS_FILTERED) {
+      if (!filter.template accept<FORMAT>(record)) {
+        continue;
+      }
+    }
+
+    if (x) {
+      std::memcpy(x + iPoint, record + Format::OFFSET_X, PointDataRecord::NUM_BYTES_X);
+    }
+    if (y) {
+      std::memcpy(y + iPoint, record + Format::OFFSET_Y, PointDataRecord::NUM_BYTES_Y);
+    }
+    if (z) {
+      std::memcpy(z + iPoint, record + Format::OFFSET_Z, PointDataRecord::NUM_BYTES_Z);
+    }
+    if (intensity) {
+      std::memcpy(intensity + iPoint, record + Format::OFFSET_INTENSITY, PointDataRecord::NUM_BYTES_INTENSITY);
+    }
+    if (returnNumber) {
+      const LLAS_UCHAR returns = (LLAS_UCHAR)record[Format::OFFSET_SENSOR_DATA];
+      if constexpr (Format::IS_EXTENDED) {
+        returnNumber[iPoint] = returns & 0x0F;
+        numberOfReturns[iPoint] = returns >> 4;
+      } else {
+        returnNumber[iPoint] = returns & 0x07;
+        numberOfReturns[iPoint] = (returns >> 3) & 0x07;
+      }
+    }
+    if (classification) {
+      const LLAS_UCHAR value = (LLAS_UCHAR)record[Format::OFFSET_CLASSIFICATION];
+      if constexpr (Format::IS_EXTENDED) {
+        classification[iPoint] = value;
+        classificationFlags[iPoint] = (LLAS_UCHAR)record[Format::OFFSET_SCAN_FLAGS] & 0x0F;
+      } else {
+        classification[iPoint] = value & 0x1F;
+        classificationFlags[iPoint] = value >> 5;
+      }
+    }
+    if (scanDirectionFlag) {
+      const LLAS_UCHAR scanFlags = (LLAS_UCHAR)record[Format::OFFSET_SCAN_FLAGS];
+      if constexpr (Format::IS_EXTENDED) {
+        if (scannerChannel) {
+          scannerChannel[iPoint] = (scanFlags >> 4) & 0x03;
+        }
+      }
+      scanDirectionFlag[iPoint] = (scanFlags >> 6) & 0x01;
+      edgeOfFlightLine[iPoint] = scanFlags >> 7;
+    }
+    if constexpr (Format::IS_EXTENDED) {
+      if (scanAngle) {
+        std::memcpy(scanAngle + iPoint, record + Format::OFFSET_SCAN_ANGLE, PointDataRecord::NUM_BYTES_SCAN_ANGLE);
+      }
+    } else {
+      if (scanAngleRank) {
+        std::memcpy(scanAngleRank + iPoint, record + Format::OFFSET_SCAN_ANGLE, PointDataRecord::NUM_BYTES_SCAN_ANGLE_RANK);
+      }
+    }
+    if (userData) {
+      std::memcpy(userData + iPoint, record + Format::OFFSET_USER_DATA, PointDataRecord::NUM_BYTES_USER_DATA);
+    }
+    if (pointSourceID) {
+      std::memcpy(pointSourceID + iPoint, record + Format::OFFSET_POINT_SOURCE_ID, PointDataRecord::NUM_BYTES_POINT_SOURCE_ID);
+    }
+    if (GPSTime) {
+      std::memcpy(GPSTime + iPoint, record + Format::OFFSET_GPS_TIME, PointDataRecord::NUM_BYTES_GPS_TIME);
+    }
+    if (red) {
+      std::memcpy(red + iPoint, record + Format::OFFSET_RGB, PointDataRecord::NUM_BYTES_RED);
+      std::memcpy(green + iPoint, record + Format::OFFSET_RGB + PointDataRecord::NUM_BYTES_RED, PointDataRecord::NUM_BYTES_GREEN);
+      std::memcpy(blue + iPoint, record + Format::OFFSET_RGB + PointDataRecord::NUM_BYTES_RED + PointDataRecord::NUM_BYTES_GREEN, PointDataRecord::NUM_BYTES_BLUE);
+    }
+    if (NIR) {
+      std::memcpy(NIR + iPoint, record + Format::OFFSET_NIR, PointDataRecord::NUM_BYTES_NIR);
+    }
+    if (wavePacketDescriptorIndex) {
+      const char* wavePacket = record + Format::OFFSET_WAVE_PACKET;
+      std::memcpy(wavePacketDescriptorIndex + iPoint, wavePacket, PointDataRecord::NUM_BYTES_WAVE_PACKET_DESCRIPTOR_INDEX);
+      wavePacket += PointDataRecord::NUM_BYTES_WAVE_PACKET_DESCRIPTOR_INDEX;
+      std::memcpy(byteOffsetToWaveformData + iPoint, wavePacket, PointDataRecord::NUM_BYTES_BYTE_OFFSET_TO_WAVEFORM_DATA);
+      wavePacket += PointDataRecord::NUM_BYTES_BYTE_OFFSET_TO_WAVEFORM_DATA;
+      std::memcpy(waveformPacketSize + iPoint, wavePacket, PointDataRecord::NUM_BYTES_WAVEFORM_PACKET_SIZE);
+      wavePacket += PointDataRecord::NUM_BYTES_WAVEFORM_PACKET_SIZE;
+      std::memcpy(returnPointWaveformLocation + iPoint, wavePacket, PointDataRecord::NUM_BYTES_RETURN_POINT_WAVEFORM_LOCATION);
+      wavePacket += PointDataRecord::NUM_BYTES_RETURN_POINT_WAVEFORM_LOCATION;
+      std::memcpy(Xt + iPoint, wavePacket, PointDataRecord::NUM_BYTES_X_T);
+      wavePacket += PointDataRecord::NUM_BYTES_X_T;
+      std::memcpy(Yt + iPoint, wavePacket, PointDataRecord::NUM_BYTES_Y_T);
+      wavePacket += PointDataRecord::NUM_BYTES_Y_T;
+      std::memcpy(Zt + iPoint, wavePacket, PointDataRecord::NUM_BYTES_Z_T);
+    }
+
+    ++iPoint;
+  }
+
+  return iPoint;
+}
+
+/// @brief Decode `nRecords` consecutive 'Point Data Records' into the columns. The format is resolved once for the whole range.
+/// @param byteData Bytes starting at the beginning of the first record
+/// @param nRecords Number of records
+/// @param recordLength Point data record length
+/// @param format Point data record format
+/// @param pointDataColumns Output columns, already allocated by `PointDataColumns::resize`
+/// @param firstIndex Index in the columns of the first record
+/// @return `true` if the format is supported
+LLAS_FUNC_DECL_PREFIX bool readPointDataRecords(const char* byteData,
+                                                const size_t nRecords,
+                                                const LLAS_USHORT recordLength,
+                                                const LLAS_UCHAR format,
+                                                PointDataColumns& pointDataColumns,
+                                                const size_t firstIndex) {
+  return visitPointDataRecordFormat(format, [&](auto formatTag) {
+    constexpr int FORMAT = decltype(formatTag)::value;
+    _readPointDataColumns<FORMAT, false>(byteData, nRecords, recordLength, RawPointFilter(), pointDataColumns, firstIndex);
+  });
+}
+
+/// @brief Decode the records among `nRecords` consecutive 'Point Data Records' which pass the filter and store them contiguously into the columns
+/// @param byteData Bytes starting at the beginning of the first record
+/// @param nRecords Number of records
+/// @param recordLength Point data record length
+/// @param format Point data record format
+/// @param filter Filter tested on the raw bytes of each record
+/// @param pointDataColumns Output columns, already allocated by `PointDataColumns::resize`
+/// @param firstIndex Index in the columns of the first stored record
+/// @return `nPoints` (`size_t`): number of stored records
+LLAS_FUNC_DECL_PREFIX size_t readPointDataRecords(const char* byteData,
+                                                  const size_t nRecords,
+                                                  const LLAS_USHORT recordLength,
+                                                  const LLAS_UCHAR format,
+                                                  const RawPointFilter& filter,
+                                                  PointDataColumns& pointDataColumns,
+                                                  const size_t firstIndex) {
+  size_t nPoints = 0;
+
+  if (filter.isEmpty) {
+    return nPoints;
+  }
+
+  visitPointDataRecordFormat(format, [&](auto formatTag) {
+    constexpr int FORMAT = decltype(formatTag)::value;
+    if (filter.isEnabled) {
+      nPoints = _readPointDataColumns<FORMAT, true>(byteData, nRecords, recordLength, filter, pointDataColumns, firstIndex);
+    } else {
+      nPoints = _readPointDataColumns<FORMAT, false>(byteData, nRecords, recordLength, filter, pointDataColumns, firstIndex);
+    }
+  });
+
+  return nPoints;
+}
+
+template <int FORMAT, bool IS_FILTERED>
+inline size_t _readPackedPointData(const char* byteData,
+                                   const size_t nRecords,
+                                   const LLAS_USHORT recordLength,
+                                   const RawPointFilter& filter,
+                                   char* packedData) {
+  constexpr std::streamsize FORMAT_SIZE = PointDataRecordFormat<FORMAT>::SIZE;
+
+  // NOTE: Without extra bytes and filter, the records are already packed
+  if constexpr (!IS_FILTERED) {
+    if (recordLength == FORMAT_SIZE) {
+      std::memcpy(packedData, byteData, nRecords * FORMAT_SIZE);
+      return nRecords;
+    }
+  }
+
+  size_t iPoint = 0;
+
+  for (size_t iRecord = 0; iRecord < nRecords; ++iRecord) {
+    const char* record = byteData + iRecord * recordLength;
+
+    if constexpr (IS_FILTERED) {
+      if (!filter.template accept<FORMAT>(record)) {
+        continue;
+      }
+    }
+
+    std::memcpy(packedData + (iPoint++) * FORMAT_SIZE, record, FORMAT_SIZE);
+  }
+
+  return iPoint;
+}
+
+/// @brief Copy the records among `nRecords` consecutive 'Point Data Records' which pass the filter into packed records without their extra bytes
+/// @param byteData Bytes starting at the beginning of the first record
+/// @param nRecords Number of records
+/// @param recordLength Point data record length
+/// @param format Point data record format
+/// @param filter Filter tested on the raw bytes of each record
+/// @param packedPointData Output records, already allocated by `PackedPointData::resize`
+/// @param firstIndex Index in `packedPointData` of the first stored record
+/// @return `nPoints` (`size_t`): number of stored records
+LLAS_FUNC_DECL_PREFIX size_t readPointDataRecords(const char* byteData,
+                                                  const size_t nRecords,
+                                                  const LLAS_USHORT recordLength,
+                                                  const LLAS_UCHAR format,
+                                                  const RawPointFilter& filter,
+                                                  PackedPointData& packedPointData,
+                                                  const size_t firstIndex) {
+  size_t nPoints = 0;
+
+  if (filter.isEmpty) {
+    return nPoints;
+  }
+
+  visitPointDataRecordFormat(format, [&](auto formatTag) {
+    constexpr int FORMAT = decltype(formatTag)::value;
+    if (filter.isEnabled) {
+      nPoints = _readPackedPointData<FORMAT, true>(byteData, nRecords, recordLength, filter, packedPointData.getRecord(firstIndex));
+    } else {
+      nPoints = _readPackedPointData<FORMAT, false>(byteData, nRecords, recordLength, filter, packedPointData.getRecord(firstIndex));
+    }
+  });
+
+  return nPoints;
+}
+
+/// @brief Call `func(firstRecord, nRecords)` for the pieces of `ranges` covering the positions `[begin, end)` of their concatenation
+/// @param rangeFirsts Position of the first record of every range in the concatenation
+template <class Func>
+inline void _forEachRangePiece(const std::vector<RecordRange>& ranges,
+                               const std::vector<size_t>& rangeFirsts,
+                               const size_t begin,
+                               const size_t end,
+                               Func&& func) {
+  size_t iRange = (size_t)(std::upper_bound(rangeFirsts.begin(), rangeFirsts.end(), begin) - rangeFirsts.begin()) - 1;
+
+  for (size_t position = begin; position < end; ++iRange) {
+    const size_t pieceEnd = std::min(end, rangeFirsts[iRange] + (size_t)(ranges[iRange].end - ranges[iRange].begin));
+    if (position < pieceEnd) {
+      func((size_t)ranges[iRange].begin + (position - rangeFirsts[iRange]), pieceEnd - position);
+      position = pieceEnd;
+    }
+  }
+}
+
+/// @brief Get the index of the first stored point of every block of `parallelForBlocks(nRecords, nThreads, ...)`
+///        over the concatenation of `ranges`
+/// @return `firstIndices` (`std::vector<size_t>`): `nBlocks + 1` elements, the last one is the total number of stored points
+LLAS_FUNC_DECL_PREFIX std::vector<size_t> _getBlockFirstIndices(const char* byteData,
+                                                                const std::vector<RecordRange>& ranges,
+                                                                const std::vector<size_t>& rangeFirsts,
+                                                                const size_t nRecords,
+                                                                const LLAS_USHORT recordLength,
+                                                                const LLAS_UCHAR format,
+                                                                const RawPointFilter& filter,
+                                                                const size_t nThreads) {
+  const size_t nBlocks = getNumParallelBlocks(nRecords, nThreads);
+  std::vector<size_t> firstIndices(nBlocks + 1, 0);
+
+  if (filter.isEmpty) {
+    return firstIndices;
+  }
+
+  if (!filter.isEnabled) {
+    // NOTE: Same partition as `parallelForBlocks`
+    const size_t blockSize = (nRecords + nBlocks - 1) / nBlocks;
+    for (size_t iBlock = 0; iBlock <= nBlocks; ++iBlock) {
+      firstIndices[iBlock] = std::min(nRecords, iBlock * blockSize);
+    }
+    return firstIndices;
+  }
+
+  // NOTE: Count the accepted records of every block first so that each block writes its points to their final position
+  parallelForBlocks(nRecords, nThreads, [&](const size_t iBlock, const size_t begin, const size_t end) {
+    _forEachRangePiece(ranges, rangeFirsts, begin, end, [&](const size_t firstRecord, const size_t nPieceRecords) {
+      firstIndices[iBlock + 1] += countPointDataRecords(byteData + firstRecord * recordLength, nPieceRecords, recordLength, format, filter);
+    });
+  });
+
+  for (size_t iBlock = 0; iBlock < nBlocks; ++iBlock) {
+    firstIndices[iBlock + 1] += firstIndices[iBlock];
+  }
+
+  return firstIndices;
+}
+
+/// @brief Check that records of `recordLength` bytes hold every field of `format`, which the decoders read at fixed offsets
+LLAS_FUNC_DECL_PREFIX bool _isValidRecordLength(const LLAS_USHORT recordLength,
+                                                const LLAS_UCHAR format) {
+  const std::streamsize formatSize = PointDataRecord::getFormatSize(format);
+  if (formatSize == 0) {
+    _LLAS_logError("Unsupported point data record format: " + std::to_string((int)format));
+    return false;
+  }
+  if (recordLength < formatSize) {
+    _LLAS_logError("Point data record length is shorter than the point data record format: " + std::to_string(recordLength));
+    return false;
+  }
+  return true;
+}
+
+/// @brief Get the position of the first record of every range in the concatenation of `ranges`
+/// @return `rangeFirsts` (`std::vector<size_t>`): `ranges.size() + 1` elements, the last one is the total number of records
+LLAS_FUNC_DECL_PREFIX std::vector<size_t> _getRangeFirsts(const std::vector<RecordRange>& ranges) {
+  std::vector<size_t> rangeFirsts(ranges.size() + 1, 0);
+  for (size_t iRange = 0; iRange < ranges.size(); ++iRange) {
+    rangeFirsts[iRange + 1] = rangeFirsts[iRange] + (size_t)(ranges[iRange].end - ranges[iRange].begin);
+  }
+  return rangeFirsts;
+}
+
+/// @brief Convert sorted record indices into ranges of consecutive records
+LLAS_FUNC_DECL_PREFIX std::vector<RecordRange> _getRecordRanges(const std::vector<LLAS_ULLONG>& records) {
+  std::vector<RecordRange> ranges;
+  for (const LLAS_ULLONG record : records) {
+    if (!ranges.empty() && ranges.back().end == record) {
+      ++ranges.back().end;
+    } else {
+      ranges.push_back({record, record + 1});
+    }
+  }
+  return ranges;
+}
+
+/// @brief Select the records of `ranges` whose index is a multiple of `stride`
+LLAS_FUNC_DECL_PREFIX std::vector<RecordRange> _subsampleByStride(const std::vector<RecordRange>& ranges,
+                                                                  const size_t stride) {
+  if (stride <= 1) {
+    return ranges;
+  }
+
+  std::vector<LLAS_ULLONG> records;
+  for (const RecordRange& range : ranges) {
+    for (LLAS_ULLONG record = range.begin + (stride - range.begin % stride) % stride; record < range.end; record += stride) {
+      records.push_back(record);
+    }
+  }
+  return _getRecordRanges(records);
+}
+
+/// @brief Select the records of `ranges` whose index is a multiple of `stride` as ranges of virtual records of `stride` records.
+///        The virtual record `i` starts at the record `i * stride`, so decoding `stridedRanges` with `stridedRecordLength` reads only the selected records.
+/// @param stridedRanges Output ranges of virtual records
+/// @param stridedRecordLength Output length of the virtual records
+/// @return `isOK` (`bool`): `false` if the virtual records are longer than a record length can be, then use `_subsampleByStride`
+LLAS_FUNC_DECL_PREFIX bool _getStridedRanges(const std::vector<RecordRange>& ranges,
+                                             const size_t stride,
+                                             const LLAS_USHORT recordLength,
+                                             std::vector<RecordRange>& stridedRanges,
+                                             LLAS_USHORT& stridedRecordLength) {
+  // NOTE: A stride of `0` set without `PointSubsampling::setStride` keeps every record like `1`
+  const size_t step = std::max<size_t>(1, stride);
+  if (step > std::numeric_limits<LLAS_USHORT>::max() / std::max<size_t>(1, recordLength)) {
+    return false;
+  }
+
+  std::vector<RecordRange> virtualRanges;
+  virtualRanges.reserve(ranges.size());
+  for (const RecordRange& range : ranges) {
+    const RecordRange virtualRange = {(range.begin + step - 1) / step, (range.end + step - 1) / step};
+    if (virtualRange.begin < virtualRange.end) {
+      virtualRanges.push_back(virtualRange);
+    }
+  }
+
+  stridedRanges = std::move(virtualRanges);
+  stridedRecordLength = (LLAS_USHORT)(step * recordLength);
+  return true;
+}
+
+/// @brief Select `nSamples` records which pass the filter uniformly at random with reservoir sampling (Algorithm L).
+///        Candidates are skipped in geometric jumps, so only the filter is evaluated on the skipped records.
+LLAS_FUNC_DECL_PREFIX std::vector<RecordRange> _subsampleByRandom(const char* byteData,
+                                                                  const std::vector<RecordRange>& ranges,
+                                                                  const LLAS_USHORT recordLength,
+                                                                  const LLAS_UCHAR format,
+                                                                  const RawPointFilter& filter,
+                                                                  const size_t nSamples,
+                                                                  const LLAS_ULLONG seed) {
+  if (nSamples == 0 || filter.isEmpty) {
+    return {};
+  }
+
+  std::mt19937_64 random(seed);
+  std::uniform_real_distribution<double> uniform(0.0, 1.0);
+  const auto nextUniform = [&]() { return 1.0 - uniform(random); };  // `(0, 1]` so that its logarithm is finite
+  const auto nextSkip = [&](const double weight) { return (LLAS_ULLONG)std::floor(std::log(nextUniform()) / std::log(1.0 - weight)); };
+
+  std::vector<LLAS_ULLONG> reservoir;
+  reservoir.reserve(nSamples);
+  double weight = std::exp(std::log(nextUniform()) / (double)nSamples);
+  LLAS_ULLONG iCandidate = 0;
+  LLAS_ULLONG iNextCandidate = (LLAS_ULLONG)nSamples + nextSkip(weight);
+
+  const auto addCandidate = [&](const LLAS_ULLONG record) {
+    if (iCandidate < nSamples) {
+      reservoir.push_back(record);
+    } else if (iCandidate == iNextCandidate) {
+      reservoir[(size_t)(random() % nSamples)] = record;
+      weight *= std::exp(std::log(nextUniform()) / (double)nSamples);
+      iNextCandidate += nextSkip(weight) + 1;
+    }
+    ++iCandidate;
+  };
+
+  if (!filter.isEnabled) {
+    // NOTE: Every record is a candidate, so the skipped records are never touched
+    for (const RecordRange& range : ranges) {
+      LLAS_ULLONG record = range.begin;
+      while (record < range.end) {
+        addCandidate(record);
+        if (iCandidate >= nSamples && iNextCandidate > iCandidate) {
+          const LLAS_ULLONG nSkipped = std::min(iNextCandidate - iCandidate, range.end - record - 1);
+          record += nSkipped;
+          iCandidate += nSkipped;
+        }
+        ++record;
+      }
+    }
+  } else {
+    visitPointDataRecordFormat(format, [&](auto formatTag) {
+      constexpr int FORMAT = decltype(formatTag)::value;
+      for (const RecordRange& range : ranges) {
+        for (LLAS_ULLONG record = range.begin; record < range.end; ++record) {
+          if (filter.template accept<FORMAT>(byteData + record * recordLength)) {
+            addCandidate(record);
+          }
+        }
+      }
+    });
+  }
+
+  std::sort(reservoir.begin(), reservoir.end());
+  return _getRecordRanges(reservoir);
+}
+
+/// @brief Integer indices of a voxel along x, y and z
+using _VoxelIndex = std::array<LLAS_LLONG, 3>;
+
+/// @brief Hash of `_VoxelIndex` which mixes every axis into all the bits (splitmix64 finalizer)
+struct _VoxelIndexHash {
+  inline size_t operator()(const _VoxelIndex& voxel) const {
+    LLAS_ULLONG hash = 0;
+    for (const LLAS_LLONG index : voxel) {
+      hash += 0x9E3779B97F4A7C15ULL + (LLAS_ULLONG)index;
+      hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9ULL;
+      hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EBULL;
+      hash ^= hash >> 31;
+    }
+    return (size_t)hash;
+  }
+};
+
+/// @brief Select the first record which passes the filter in every voxel with `nThreads` threads
+LLAS_FUNC_DECL_PREFIX std::vector<RecordRange> _subsampleByVoxelGrid(const char* byteData,
+                                                                     const std::vector<RecordRange>& ranges,
+                                                                     const LLAS_USHORT recordLength,
+                                                                     const LLAS_UCHAR format,
+                                                                     const RawPointFilter& filter,
+                                                                     const math::vec3d_t& voxelSize,
+                                                                     const PublicHeader& header,
+                                                                     const size_t nThreads) {
+  if (filter.isEmpty) {
+    return {};
+  }
+
+  // NOTE: The grid is in the integer domain of the records, anchored at the minimum bounds of the header
+  const math::vec3d_t scales = {header.xScaleFactor, header.yScaleFactor, header.zScaleFactor};
+  const math::vec3d_t origin = {(header.minX - header.xOffset) / header.xScaleFactor,
+                                (header.minY - header.yOffset) / header.yScaleFactor,
+                                (header.minZ - header.zOffset) / header.zScaleFactor};
+  math::vec3d_t invCellSizes;
+  for (size_t iAxis = 0; iAxis < 3; ++iAxis) {
+    invCellSizes[iAxis] = voxelSize[iAxis] > 0.0 ? std::abs(scales[iAxis]) / voxelSize[iAxis] : 0.0;
+  }
+
+  // NOTE: Voxels are keyed by their exact indices, which may be negative for points outside the header bounds
+  const auto getVoxelIndex = [&](const char* record) {
+    LLAS_LONG coords[3];
+    std::memcpy(coords, record, PointDataRecord::NUM_BYTES_X + PointDataRecord::NUM_BYTES_Y + PointDataRecord::NUM_BYTES_Z);
+    _VoxelIndex voxel;
+    for (size_t iAxis = 0; iAxis < 3; ++iAxis) {
+      voxel[iAxis] = (LLAS_LLONG)std::floor(((double)coords[iAxis] - origin[iAxis]) * invCellSizes[iAxis]);
+    }
+    return voxel;
+  };
+
+  using VoxelMap = std::unordered_map<_VoxelIndex, LLAS_ULLONG, _VoxelIndexHash>;
+
+  const std::vector<size_t> rangeFirsts = _getRangeFirsts(ranges);
+  const size_t nRecords = rangeFirsts.back();
+  std::vector<VoxelMap> blockVoxels(getNumParallelBlocks(nRecords, nThreads));
+
+  parallelForBlocks(nRecords, nThreads, [&](const size_t iBlock, const size_t begin, const size_t end) {
+    VoxelMap& voxels = blockVoxels[iBlock];
+    visitPointDataRecordFormat(format, [&](auto formatTag) {
+      constexpr int FORMAT = decltype(formatTag)::value;
+      _forEachRangePiece(ranges, rangeFirsts, begin, end, [&](const size_t firstRecord, const size_t nPieceRecords) {
+        for (size_t record = firstRecord; record < firstRecord + nPieceRecords; ++record) {
+          const char* recordData = byteData + record * recordLength;
+          if (!filter.isEnabled || filter.template accept<FORMAT>(recordData)) {
+            voxels.emplace(getVoxelIndex(recordData), (LLAS_ULLONG)record);
+          }
+        }
+      });
+    });
+  });
+
+  // NOTE: Blocks are merged in file order so that the first point of a voxel wins regardless of the number of threads
+  VoxelMap& voxels = blockVoxels[0];
+  for (size_t iBlock = 1; iBlock < blockVoxels.size(); ++iBlock) {
+    for (const auto& voxel : blockVoxels[iBlock]) {
+      voxels.emplace(voxel);
+    }
+    VoxelMap().swap(blockVoxels[iBlock]);
+  }
+
+  std::vector<LLAS_ULLONG> records;
+  records.reserve(voxels.size());
+  for (const auto& voxel : voxels) {
+    records.push_back(voxel.second);
+  }
+  std::sort(records.begin(), records.end());
+  return _getRecordRanges(records);
+}
+
+/// @brief Select the records of `ranges` to decode for `subsampling`
+/// @param byteData Bytes starting at the beginning of the record `0`
+/// @param ranges Sorted, disjoint ranges of records to read
+/// @param recordLength Point data record length
+/// @param format Point data record format
+/// @param filter Filter tested on the raw bytes of each record
+/// @param subsampling Subsampling
+/// @param header Public header which provides the scale factors, the offsets and the bounds of the file
+/// @param nThreads Number of threads. `0` means all hardware threads.
+/// @return `Ranges` (`std::vector<RecordRange>`): sorted, disjoint ranges of the selected records
+LLAS_FUNC_DECL_PREFIX std::vector<RecordRange> subsamplePointDataRecords(const char* byteData,
+                                                                         const std::vector<RecordRange>& ranges,
+                                                                         const LLAS_USHORT recordLength,
+                                                                         const LLAS_UCHAR format,
+                                                                         const RawPointFilter& filter,
+                                                                         const PointSubsampling& subsampling,
+                                                                         const PublicHeader& header,
+                                                                         const size_t nThreads) {
+  if (subsampling.mode != SubsamplingMode::None && subsampling.mode != SubsamplingMode::Stride && !_isValidRecordLength(recordLength, format)) {
+    return {};
+  }
+
+  switch (subsampling.mode) {
+    case SubsamplingMode::Stride:
+      return _subsampleByStride(ranges, subsampling.stride);
+    case SubsamplingMode::Random:
+      return _subsampleByRandom(byteData, ranges, recordLength, format, filter, subsampling.nSamples, subsampling.seed);
+    case SubsamplingMode::VoxelGrid:
+      return _subsampleByVoxelGrid(byteData, ranges, recordLength, format, filter, subsampling.voxelSize, header, nThreads);
+    default:
+      return ranges;
+  }
+}
+
+/// @brief Decode the records in `ranges` which pass the filter with `nThreads` threads
+/// @param byteData Bytes starting at the beginning of the record `0`
+/// @param ranges Sorted, disjoint ranges of records to read
+/// @param recordLength Point data record length
+/// @param format Point data record format
+/// @param fields Attributes to decode (`PointField`). Other attributes are zero.
+/// @param filter Filter tested on the raw bytes of each record
+/// @param nThreads Number of threads. `0` means all hardware threads.
+/// @param pointDataRecords Output records which are resized to the number of stored points
+/// @param progress Counts the decoded records, if not `nullptr`. Stops decoding once cancelled.
+/// @return `nPoints` (`size_t`): number of stored points
+LLAS_FUNC_DECL_PREFIX size_t decodePointDataRecords(const char* byteData,
+                                                    const std::vector<RecordRange>& ranges,
+                                                    const LLAS_USHORT recordLength,
+                                                    const LLAS_UCHAR format,
+                                                    const LLAS_ULONG fields,
+                                                    const RawPointFilter& filter,
+                                                    const size_t nThreads,
+                                                    std::vector<PointDataRecord>& pointDataRecords,
+                                                    DecodeProgress* progress = nullptr) {
+  if (!_isValidRecordLength(recordLength, format)) {
+    pointDataRecords.clear();
+    return 0;
+  }
+
+  const std::vector<size_t> rangeFirsts = _getRangeFirsts(ranges);
+  const size_t nRecords = rangeFirsts.back();
+  const std::vector<size_t> firstIndices = _getBlockFirstIndices(byteData, ranges, rangeFirsts, nRecords, recordLength, format, filter, nThreads);
+  const size_t nPoints = firstIndices.back();
+
+  // NOTE: Records reused from a previous call have to be reset since attributes outside `fields` are not written
+  const size_t nReused = std::min(pointDataRecords.size(), nPoints);
+  pointDataRecords.resize(nPoints);
+
+  if (nPoints == 0) {
+    return nPoints;
+  }
+
+  parallelForBlocks(nRecords, nThreads, [&](const size_t iBlock, const size_t begin, const size_t end) {
+    const size_t firstIndex = firstIndices[iBlock];
+    const size_t lastIndex = firstIndices[iBlock + 1];
+
+    if (firstIndex < nReused) {
+      std::fill(pointDataRecords.begin() + firstIndex, pointDataRecords.begin() + std::min(lastIndex, nReused), PointDataRecord());
+    }
+
+    size_t iPoint = firstIndex;
+    _forEachRangePiece(ranges, rangeFirsts, begin, end, [&](const size_t firstRecord, const size_t nPieceRecords) {
+      _forEachProgressStep(firstRecord, nPieceRecords, progress, iBlock == 0, [&](const size_t firstStepRecord, const size_t nStepRecords) {
+        iPoint += readPointDataRecords(byteData + firstStepRecord * recordLength, nStepRecords, recordLength, format, fields, filter, pointDataRecords.data() + iPoint);
+      });
+    });
+  });
+
+  return nPoints;
+}
+
+/// @brief Decode the records in `ranges` which pass the filter into columns with `nThreads` threads
+/// @param byteData Bytes starting at the beginning of the record `0`
+/// @param ranges Sorted, disjoint ranges of records to read
+/// @param recordLength Point data record length
+/// @param format Point data record format
+/// @param fields Attributes to store (`PointField`)
+/// @param filter Filter tested on the raw bytes of each record
+/// @param nThreads Number of threads. `0` means all hardware threads.
+/// @param pointDataColumns Output columns which are resized to the number of stored points
+/// @param progress Counts the decoded records, if not `nullptr`. Stops decoding once cancelled.
+/// @return `nPoints` (`size_t`): number of stored points
+LLAS_FUNC_DECL_PREFIX size_t decodePointDataRecords(const char* byteData,
+                                                    const std::vector<RecordRange>& ranges,
+                                                    const LLAS_USHORT recordLength,
+                                                    const LLAS_UCHAR format,
+                                                    const LLAS_ULONG fields,
+                                                    const RawPointFilter& filter,
+                                                    const size_t nThreads,
+                                                    PointDataColumns& pointDataColumns,
+                                                    DecodeProgress* progress = nullptr) {
+  if (!_isValidRecordLength(recordLength, format)) {
+    pointDataColumns.clear();
+    return 0;
+  }
+
+  const std::vector<size_t> rangeFirsts = _getRangeFirsts(ranges);
+  const size_t nRecords = rangeFirsts.back();
+  const std::vector<size_t> firstIndices = _getBlockFirstIndices(byteData, ranges, rangeFirsts, nRecords, recordLength, format, filter, nThreads);
+  const size_t nPoints = firstIndices.back();
+
+  pointDataColumns.resize(nPoints, format, fields);
+
+  if (nPoints == 0) {
+    return nPoints;
+  }
+
+  parallelForBlocks(nRecords, nThreads, [&](const size_t iBlock, const size_t begin, const size_t end) {
+    size_t iPoint = firstIndices[iBlock];
+    _forEachRangePiece(ranges, rangeFirsts, begin, end, [&](const size_t firstRecord, const size_t nPieceRecords) {
+      _forEachProgressStep(firstRecord, nPieceRecords, progress, iBlock == 0, [&](const size_t firstStepRecord, const size_t nStepRecords) {
+        iPoint += readPointDataRecords(byteData + firstStepRecord * recordLength, nStepRecords, recordLength, format, filter, pointDataColumns, iPoint);
+      });
+    });
+  });
+
+  return nPoints;
+}
+
+/// @brief Copy the records in `ranges` which pass the filter into packed records with `nThreads` threads.
+///        Every field defined by the format is kept, so there is no `fields` argument.
+/// @param byteData Bytes starting at the beginning of the record `0`
+/// @param ranges Sorted, disjoint ranges of records to read
+/// @param recordLength Point data record length
+/// @param format Point data record format
+/// @param filter Filter tested on the raw bytes of each record
+/// @param nThreads Number of threads. `0` means all hardware threads.
+/// @param packedPointData Output records which are resized to the number of stored points
+/// @param progress Counts the copied records, if not `nullptr`. Stops copying once cancelled.
+/// @return `nPoints` (`size_t`): number of stored points
+LLAS_FUNC_DECL_PREFIX size_t decodePointDataRecords(const char* byteData,
+                                                    const std::vector<RecordRange>& ranges,
+                                                    const LLAS_USHORT recordLength,
+                                                    const LLAS_UCHAR format,
+                                                    const RawPointFilter& filter,
+                                                    const size_t nThreads,
+                                                    PackedPointData& packedPointData,
+                                                    DecodeProgress* progress = nullptr) {
+  if (!_isValidRecordLength(recordLength, format)) {
+    packedPointData.clear();
+    return 0;
+  }
+
+  const std::vector<size_t> rangeFirsts = _getRangeFirsts(ranges);
+  const size_t nRecords = rangeFirsts.back();
+  const std::vector<size_t> firstIndices = _getBlockFirstIndices(byteData, ranges, rangeFirsts, nRecords, recordLength, format, filter, nThreads);
+  const size_t nPoints = firstIndices.back();
+
+  if (!packedPointData.resize(nPoints, format) || nPoints == 0) {
+    return 0;
+  }
+
+  parallelForBlocks(nRecords, nThreads, [&](const size_t iBlock, const size_t begin, const size_t end) {
+    size_t iPoint = firstIndices[iBlock];
+    _forEachRangePiece(ranges, rangeFirsts, begin, end, [&](const size_t firstRecord, const size_t nPieceRecords) {
+      _forEachProgressStep(firstRecord, nPieceRecords, progress, iBlock == 0, [&](const size_t firstStepRecord, const size_t nStepRecords) {
+        iPoint += readPointDataRecords(byteData + firstStepRecord * recordLength, nStepRecords, recordLength, format, filter, packedPointData, iPoint);
+      });
+    });
+  });
+
+  return nPoints;
+}
+
+/// @brief Decode the records among `nRecords` consecutive 'Point Data Records' which pass the filter with `nThreads` threads
+/// @return `nPoints` (`size_t`): number of stored points
+LLAS_FUNC_DECL_PREFIX size_t decodePointDataRecords(const char* byteData,
+                                                    const size_t nRecords,
+                                                    const LLAS_USHORT recordLength,
+                                                    const LLAS_UCHAR format,
+                                                    const LLAS_ULONG fields,
+                                                    const RawPointFilter& filter,
+                                                    const size_t nThreads,
+                                                    std::vector<PointDataRecord>& pointDataRecords) {
+  return decodePointDataRecords(byteData, std::vector<RecordRange>({{0, nRecords}}), recordLength, format, fields, filter, nThreads, pointDataRecords);
+}
+
+/// @brief Decode the records among `nRecords` consecutive 'Point Data Records' which pass the filter into columns with `nThreads` threads
+/// @return `nPoints` (`size_t`): number of stored points
+LLAS_FUNC_DECL_PREFIX size_t decodePointDataRecords(const char* byteData,
+                                                    const size_t nRecords,
+                                                    const LLAS_USHORT recordLength,
+                                                    const LLAS_UCHAR format,
+                                                    const LLAS_ULONG fields,
+                                                    const RawPointFilter& filter,
+                                                    const size_t nThreads,
+                                                    PointDataColumns& pointDataColumns) {
+  return decodePointDataRecords(byteData, std::vector<RecordRange>({{0, nRecords}}), recordLength, format, fields, filter, nThreads, pointDataColumns);
+}
+
+/// @brief Copy the records among `nRecords` consecutive 'Point Data Records' which pass the filter into packed records with `nThreads` threads
+/// @return `nPoints` (`size_t`): number of stored points
+LLAS_FUNC_DECL_PREFIX size_t decodePointDataRecords(const char* byteData,
+                                                    const size_t nRecords,
+                                                    const LLAS_USHORT recordLength,
+                                                    const LLAS_UCHAR format,
+                                                    const RawPointFilter& filter,
+                                                    const size_t nThreads,
+                                                    PackedPointData& packedPointData) {
+  return decodePointDataRecords(byteData, std::vector<RecordRange>({{0, nRecords}}), recordLength, format, filter, nThreads, packedPointData);
+}
+
+// ==========================================================================
+// LAZ decompression
+// ==========================================================================
+
+/// @brief Decoder of LASzip compressed point data (LAZ).
+///        Point data compressed with the pointwise chunked compressor and the version 2 items
+///        (`POINT10`, `GPSTIME11`, `RGB12` and `BYTE`) is supported, which covers the formats 0 to 3 with extra bytes.
+///        Every chunk starts with a raw record and resets the models, so chunks are decoded independently on several threads.
+namespace laz {
+
+// clang-format off
+constexpr LLAS_ULONG AC_MIN_LENGTH                                                                 = 0x01000000U;  // threshold for renormalization
+constexpr LLAS_ULONG AC_MAX_LENGTH                                                                 = 0xFFFFFFFFU;  // maximum interval length
+constexpr LLAS_ULONG BM_LENGTH_SHIFT                                                               = 13;           // length bits discarded before multiplication
+constexpr LLAS_ULONG BM_MAX_COUNT                                                                  = 1U << BM_LENGTH_SHIFT;
+constexpr LLAS_ULONG DM_LENGTH_SHIFT                                                               = 15;
+constexpr LLAS_ULONG DM_MAX_COUNT                                                                  = 1U << DM_LENGTH_SHIFT;
+
+constexpr LLAS_USHORT VLR_RECORD_ID                                                                = 22204;
+constexpr const char* VLR_USER_ID                                                                  = "laszip encoded";
+
+constexpr LLAS_USHORT COMPRESSOR_POINTWISE_CHUNKED                                                 = 2;
+constexpr LLAS_USHORT COMPRESSOR_LAYERED_CHUNKED                                                   = 3;
+constexpr LLAS_ULONG VARIABLE_CHUNK_SIZE                                                           = 0xFFFFFFFFU;
+
+constexpr LLAS_USHORT ITEM_BYTE                                                                    = 0;
+constexpr LLAS_USHORT ITEM_POINT10                                                                 = 6;
+constexpr LLAS_USHORT ITEM_GPSTIME11                                                               = 7;
+constexpr LLAS_USHORT ITEM_RGB12                                                                   = 8;
+
+constexpr LLAS_ULONG POINT10_SIZE                                                                  = 20;
+constexpr LLAS_ULONG GPSTIME11_SIZE                                                                = 8;
+constexpr LLAS_ULONG RGB12_SIZE                                                                    = 6;
+
+constexpr LLAS_LONG GPSTIME_MULTI                                                                  = 500;
+constexpr LLAS_LONG GPSTIME_MULTI_MINUS                                                            = -10;
+constexpr LLAS_LONG GPSTIME_MULTI_UNCHANGED                                                        = GPSTIME_MULTI - GPSTIME_MULTI_MINUS + 1;
+constexpr LLAS_LONG GPSTIME_MULTI_CODE_FULL                                                        = GPSTIME_MULTI - GPSTIME_MULTI_MINUS + 2;
+constexpr LLAS_LONG GPSTIME_MULTI_TOTAL                                                            = GPSTIME_MULTI - GPSTIME_MULTI_MINUS + 6;
+
+// NOTE: Context of the return number `r` of a point with `n` returns, indexed by `[n][r]`
+constexpr LLAS_UCHAR NUMBER_RETURN_MAP[8][8] = {
+    {15, 14, 13, 12, 11, 10,  9,  8},
+    {14,  0,  1,  3,  6, 10, 10,  9},
+    {13,  1,  2,  4,  7, 11, 11, 10},
+    {12,  3,  4,  5,  8, 12, 12, 11},
+    {11,  6,  7,  8,  9, 13, 13, 12},
+    {10, 10, 11, 12, 13, 14, 14, 13},
+    { 9, 10, 11, 12, 13, 14, 15, 14},
+    { 8,  9, 10, 11, 12, 13, 14, 15},
+};
+
+constexpr LLAS_UCHAR NUMBER_RETURN_LEVEL[8][8] = {
+    {0, 1, 2, 3, 4, 5, 6, 7},
+    {1, 0, 1, 2, 3, 4, 5, 6},
+    {2, 1, 0, 1, 2, 3, 4, 5},
+    {3, 2, 1, 0, 1, 2, 3, 4},
+    {4, 3, 2, 1, 0, 1, 2, 3},
+    {5, 4, 3, 2, 1, 0, 1, 2},
+    {6, 5, 4, 3, 2, 1, 0, 1},
+    {7, 6, 5, 4, 3, 2, 1, 0},
+};
+// clang-format on
+
+inline LLAS_UCHAR foldByte(const LLAS_LONG value) {
+  return (LLAS_UCHAR)(value < 0 ? value + 256 : (value > 255 ? value - 256 : value));
+}
+
+inline LLAS_LONG clampByte(const LLAS_LONG value) {
+  return value < 0 ? 0 : (value > 255 ? 255 : value);
+}
+
+/// @brief Adaptive binary model
+struct BitModel {
+  BitModel()
+      : bit0Prob(1U << (BM_LENGTH_SHIFT - 1)),
+        bit0Count(1),
+        bitCount(2),
+        updateCycle(4),
+        bitsUntilUpdate(4) {}
+
+  LLAS_ULONG bit0Prob;
+  LLAS_ULONG bit0Count;
+  LLAS_ULONG bitCount;
+  LLAS_ULONG updateCycle;
+  LLAS_ULONG bitsUntilUpdate;
+
+  inline void update() {
+    // NOTE: Halve the counts when the threshold is reached
+    if ((bitCount += updateCycle) > BM_MAX_COUNT) {
+      bitCount = (bitCount + 1) >> 1;
+      bit0Count = (bit0Count + 1) >> 1;
+      if (bit0Count == bitCount) {
+        ++bitCount;
+      }
+    }
+
+    const LLAS_ULONG scale = 0x80000000U / bitCount;
+    bit0Prob = (bit0Count * scale) >> (31 - BM_LENGTH_SHIFT);
+
+    updateCycle = std::min<LLAS_ULONG>((5 * updateCycle) >> 2, 64);
+    bitsUntilUpdate = updateCycle;
+  }
+};
+
+/// @brief Adaptive model of `nSymbols` symbols
+struct SymbolModel {
+  explicit SymbolModel(const LLAS_ULONG nSymbols)
+      : symbols(nSymbols),
+        lastSymbol(nSymbols - 1),
+        tableShift(),
+        totalCount(),
+        updateCycle(nSymbols),
+        symbolsUntilUpdate(),
+        distribution(nSymbols),
+        symbolCount(nSymbols, 1),
+        decoderTable() {
+    // NOTE: Larger alphabets use a lookup table to find the first candidate symbol
+    if (symbols > 16) {
+      LLAS_ULONG tableBits = 3;
+      while (symbols > (1U << (tableBits + 2))) {
+        ++tableBits;
+      }
+      tableShift = DM_LENGTH_SHIFT - tableBits;
+      decoderTable.resize(((size_t)1 << tableBits) + 2);
+    }
+
+    update();
+    symbolsUntilUpdate = updateCycle = (symbols + 6) >> 1;
+  }
+
+  LLAS_ULONG symbols;
+  LLAS_ULONG lastSymbol;
+  LLAS_ULONG tableShift;
+  LLAS_ULONG totalCount;
+  LLAS_ULONG updateCycle;
+  LLAS_ULONG symbolsUntilUpdate;
+  std::vector<LLAS_ULONG> distribution;
+  std::vector<LLAS_ULONG> symbolCount;
+  std::vector<LLAS_ULONG> decoderTable;
+
+  inline void update() {
+    // NOTE: Halve the counts when the threshold is reached
+    if ((totalCount += updateCycle) > DM_MAX_COUNT) {
+      totalCount = 0;
+      for (LLAS_ULONG iSymbol = 0; iSymbol < symbols; ++iSymbol) {
+        totalCount += (symbolCount[iSymbol] = (symbolCount[iSymbol] + 1) >> 1);
+      }
+    }
+
+    const LLAS_ULONG scale = 0x80000000U / totalCount;
+    LLAS_ULONG sum = 0;
+
+    if (decoderTable.empty()) {
+      for (LLAS_ULONG iSymbol = 0; iSymbol < symbols; ++iSymbol) {
+        distribution[iSymbol] = (scale * sum) >> (31 - DM_LENGTH_SHIFT);
+        sum += symbolCount[iSymbol];
+      }
+    } else {
+      const LLAS_ULONG tableSize = (LLAS_ULONG)decoderTable.size() - 2;
+      LLAS_ULONG iTable = 0;
+      for (LLAS_ULONG iSymbol = 0; iSymbol < symbols; ++iSymbol) {
+        distribution[iSymbol] = (scale * sum) >> (31 - DM_LENGTH_SHIFT);
+        sum += symbolCount[iSymbol];
+        const LLAS_ULONG w = distribution[iSymbol] >> tableShift;
+        while (iTable < w) {
+          decoderTable[++iTable] = iSymbol - 1;
+        }
+      }
+      decoderTable[0] = 0;
+      while (iTable <= tableSize) {
+        decoderTable[++iTable] = symbols - 1;
+      }
+    }
+
+    updateCycle = std::min((5 * updateCycle) >> 2, (symbols + 6) << 3);
+    symbolsUntilUpdate = updateCycle;
+  }
+};
+
+/// @brief Arithmetic decoder over the bytes of a chunk. Reads past the end return zero.
+class ArithmeticDecoder {
+ public:
+  ArithmeticDecoder()
+      : _data(),
+        _size(),
+        _position(),
+        _value(),
+        _length() {}
+
+  /// @brief Start decoding `data`
+  inline void init(const char* data, const size_t size) {
+    _data = reinterpret_cast<const LLAS_UCHAR*>(data);
+    _size = size;
+    _position = 0;
+    _length = AC_MAX_LENGTH;
+    _value = ((LLAS_ULONG)_getByte() << 24);
+    _value |= ((LLAS_ULONG)_getByte() << 16);
+    _value |= ((LLAS_ULONG)_getByte() << 8);
+    _value |= (LLAS_ULONG)_getByte();
+  }
+
+  inline LLAS_ULONG decodeBit(BitModel& model) {
+    const LLAS_ULONG x = model.bit0Prob * (_length >> BM_LENGTH_SHIFT);
+    const LLAS_ULONG symbol = _value >= x;
+
+    if (symbol == 0) {
+      _length = x;
+      ++model.bit0Count;
+    } else {
+      _value -= x;
+      _length -= x;
+    }
+
+    if (_length < AC_MIN_LENGTH) {
+      _renormalize();
+    }
+
+    if (--model.bitsUntilUpdate == 0) {
+      model.update();
+    }
+
+    return symbol;
+  }
+
+  inline LLAS_ULONG decodeSymbol(SymbolModel& model) {
+    LLAS_ULONG symbol;
+    LLAS_ULONG x;
+    LLAS_ULONG y = _length;
+
+    if (!model.decoderTable.empty()) {
+      const LLAS_ULONG dv = _value / (_length >>= DM_LENGTH_SHIFT);
+      const LLAS_ULONG t = dv >> model.tableShift;
+
+      // NOTE: Bisect between the candidates of the lookup table
+      symbol = model.decoderTable[t];
+      LLAS_ULONG n = model.decoderTable[t + 1] + 1;
+      while (n > symbol + 1) {
+        const LLAS_ULONG k = (symbol + n) >> 1;
+        if (model.distribution[k] > dv) {
+          n = k;
+        } else {
+          symbol = k;
+        }
+      }
+
+      x = model.distribution[symbol] * _length;
+      if (symbol != model.lastSymbol) {
+        y = model.distribution[symbol + 1] * _length;
+      }
+    } else {
+      x = symbol = 0;
+      _length >>= DM_LENGTH_SHIFT;
+      LLAS_ULONG n = model.symbols;
+      LLAS_ULONG k = n >> 1;
+
+      do {
+        const LLAS_ULONG z = _length * model.distribution[k];
+        if (z > _value) {
+          n = k;
+          y = z;
+        } else {
+          symbol = k;
+          x = z;
+        }
+      } while ((k = (symbol + n) >> 1) != symbol);
+    }
+
+    _value -= x;
+    _length = y - x;
+
+    if (_length < AC_MIN_LENGTH) {
+      _renormalize();
+    }
+
+    ++model.symbolCount[symbol];
+    if (--model.symbolsUntilUpdate == 0) {
+      model.update();
+    }
+
+    return symbol;
+  }
+
+  inline LLAS_ULONG readBits(LLAS_ULONG nBits) {
+    if (nBits > 19) {
+      const LLAS_ULONG lower = readShort();
+      nBits -= 16;
+      const LLAS_ULONG upper = readBits(nBits) << 16;
+      return upper | lower;
+    }
+
+    const LLAS_ULONG symbol = _value / (_length >>= nBits);
+    _value -= _length * symbol;
+
+    if (_length < AC_MIN_LENGTH) {
+      _renormalize();
+    }
+
+    return symbol;
+  }
+
+  inline LLAS_USHORT readShort() {
+    const LLAS_ULONG symbol = _value / (_length >>= 16);
+    _value -= _length * symbol;
+
+    if (_length < AC_MIN_LENGTH) {
+      _renormalize();
+    }
+
+    return (LLAS_USHORT)symbol;
+  }
+
+  inline LLAS_ULONG readInt() {
+    const LLAS_ULONG lower = readShort();
+    const LLAS_ULONG upper = readShort();
+    return (upper << 16) | lower;
+  }
+
+ private:
+  const LLAS_UCHAR* _data;
+  size_t _size;
+  size_t _position;
+  LLAS_ULONG _value;
+  LLAS_ULONG _length;
+
+  inline LLAS_UCHAR _getByte() {
+    return _position < _size ? _data[_position++] : 0;
+  }
+
+  inline void _renormalize() {
+    do {
+      _value = (_value << 8) | _getByte();
+    } while ((_length <<= 8) < AC_MIN_LENGTH);
+  }
+};
+
+/// @brief Decoder of integers predicted from a previous value. The correction is coded by its bit length `k` and its bits.
+class IntegerDecompressor {
+ public:
+  /// @param bits Number of bits of the values. `32` means the full range of `LLAS_LONG`.
+  /// @param contexts Number of contexts of the bit length model
+  /// @param bitsHigh Number of high bits of the correction coded with a symbol model. Lower bits are raw.
+  IntegerDecompressor(const LLAS_ULONG bits = 16,
+                      const LLAS_ULONG contexts = 1,
+                      const LLAS_ULONG bitsHigh = 8)
+      : _k(),
+        _corrBits(bits > 0 && bits < 32 ? bits : 32),
+        _corrRange(bits > 0 && bits < 32 ? 1U << bits : 0),
+        _corrMin(bits > 0 && bits < 32 ? -(LLAS_LONG)(_corrRange / 2) : std::numeric_limits<LLAS_LONG>::min()),
+        _bitsHigh(bitsHigh),
+        _bitModels(contexts, SymbolModel(_corrBits + 1)),
+        _corrector0(),
+        _correctors() {
+    _correctors.reserve(_corrBits);
+    for (LLAS_ULONG iBit = 1; iBit <= _corrBits; ++iBit) {
+      _correctors.emplace_back(1U << std::min(iBit, _bitsHigh));
+    }
+  }
+
+  /// @brief Decode the value predicted by `prediction`
+  inline LLAS_LONG decompress(ArithmeticDecoder& decoder,
+                              const LLAS_LONG prediction,
+                              const LLAS_ULONG context = 0) {
+    // NOTE: Wrap around in unsigned arithmetic like the encoder
+    LLAS_LONG real = (LLAS_LONG)((LLAS_ULONG)prediction + (LLAS_ULONG)_readCorrector(decoder, _bitModels[context]));
+
+    if (_corrRange != 0) {
+      if (real < 0) {
+        real += (LLAS_LONG)_corrRange;
+      } else if ((LLAS_ULONG)real >= _corrRange) {
+        real -= (LLAS_LONG)_corrRange;
+      }
+    }
+
+    return real;
+  }
+
+  /// @brief Get the bit length of the last correction
+  inline LLAS_ULONG getK() const {
+    return _k;
+  }
+
+ private:
+  LLAS_ULONG _k;
+  LLAS_ULONG _corrBits;
+  LLAS_ULONG _corrRange;
+  LLAS_LONG _corrMin;
+  LLAS_ULONG _bitsHigh;
+  std::vector<SymbolModel> _bitModels;
+  BitModel _corrector0;
+  std::vector<SymbolModel> _correctors;  // `_correctors[k - 1]` codes corrections of `k` bits
+
+  inline LLAS_LONG _readCorrector(ArithmeticDecoder& decoder, SymbolModel& bitModel) {
+    _k = decoder.decodeSymbol(bitModel);
+
+    if (_k == 0) {
+      return (LLAS_LONG)decoder.decodeBit(_corrector0);
+    }
+
+    if (_k >= 32) {
+      return _corrMin;
+    }
+
+    LLAS_LONG corrector;
+    if (_k <= _bitsHigh) {
+      corrector = (LLAS_LONG)decoder.decodeSymbol(_correctors[_k - 1]);
+    } else {
+      const LLAS_ULONG nLowBits = _k - _bitsHigh;
+      const LLAS_ULONG upper = decoder.decodeSymbol(_correctors[_k - 1]);
+      const LLAS_ULONG lower = decoder.readBits(nLowBits);
+      corrector = (LLAS_LONG)((upper << nLowBits) | lower);
+    }
+
+    // NOTE: `[0, 2^(k-1))` maps to `[-(2^k - 1), -2^(k-1)]` and `[2^(k-1), 2^k)` to `[2^(k-1) + 1, 2^k]`
+    if (corrector >= (LLAS_LONG)(1U << (_k - 1))) {
+      return corrector + 1;
+    }
+    return (LLAS_LONG)((LLAS_ULONG)corrector - ((1U << _k) - 1));
+  }
+};
+
+/// @brief Median of the last 5 values
+class StreamingMedian5 {
+ public:
+  StreamingMedian5()
+      : _values(),
+        _isHigh(true) {}
+
+  inline void add(const LLAS_LONG value) {
+    LLAS_LONG* v = _values.data();
+
+    if (_isHigh) {
+      if (value < v[2]) {
+        v[4] = v[3];
+        v[3] = v[2];
+        if (value < v[0]) {
+          v[2] = v[1];
+          v[1] = v[0];
+          v[0] = value;
+        } else if (value < v[1]) {
+          v[2] = v[1];
+          v[1] = value;
+        } else {
+          v[2] = value;
+        }
+      } else {
+        if (value < v[3]) {
+          v[4] = v[3];
+          v[3] = value;
+        } else {
+          v[4] = value;
+        }
+        _isHigh = false;
+      }
+    } else {
+      if (v[2] < value) {
+        v[0] = v[1];
+        v[1] = v[2];
+        if (v[4] < value) {
+          v[2] = v[3];
+          v[3] = v[4];
+          v[4] = value;
+        } else if (v[3] < value) {
+          v[2] = v[3];
+          v[3] = value;
+        } else {
+          v[2] = value;
+        }
+      } else {
+        if (v[1] < value) {
+          v[0] = v[1];
+          v[1] = value;
+        } else {
+          v[0] = value;
+        }
+        _isHigh = true;
+      }
+    }
+  }
+
+  inline LLAS_LONG get() const {
+    return _values[2];
+  }
+
+ private:
+  std::array<LLAS_LONG, 5> _values;
+  bool _isHigh;
+};
+
+/// @brief Decoder of the `POINT10` item (version 2): the first 20 bytes of formats 0 to 5
+class Point10Decompressor {
+ public:
+  Point10Decompressor()
+      : _lastItem(),
+        _lastIntensity(),
+        _lastXDiffMedian5(),
+        _lastYDiffMedian5(),
+        _lastHeight(),
+        _changedValues(64),
+        _intensity(16, 4),
+        _scanAngleRank{SymbolModel(256), SymbolModel(256)},
+        _pointSourceID(16),
+        _bitByte(),
+        _classification(),
+        _userData(),
+        _dx(32, 2),
+        _dy(32, 22),
+        _z(32, 20) {}
+
+  /// @brief Start a chunk with its raw first item
+  inline void init(const char* item) {
+    std::memcpy(_lastItem, item, POINT10_SIZE);
+
+    // NOTE: The intensity of the first item is not used as a prediction
+    _lastItem[12] = 0;
+    _lastItem[13] = 0;
+  }
+
+  inline void decompress(ArithmeticDecoder& decoder, char* item) {
+    const LLAS_ULONG changedValues = decoder.decodeSymbol(_changedValues);
+
+    if (changedValues & 32) {
+      _lastItem[14] = (LLAS_UCHAR)decoder.decodeSymbol(_getModel(_bitByte, _lastItem[14]));
+    }
+
+    const LLAS_UCHAR returnNumber = _lastItem[14] & 0x07;
+    const LLAS_UCHAR numberOfReturns = (_lastItem[14] >> 3) & 0x07;
+    const LLAS_UCHAR m = NUMBER_RETURN_MAP[numberOfReturns][returnNumber];
+    const LLAS_UCHAR l = NUMBER_RETURN_LEVEL[numberOfReturns][returnNumber];
+
+    if (changedValues & 16) {
+      _lastIntensity[m] = (LLAS_USHORT)_intensity.decompress(decoder, _lastIntensity[m], m < 3 ? m : 3);
+    }
+    std::memcpy(_lastItem + 12, &_lastIntensity[m], sizeof(LLAS_USHORT));
+
+    if (changedValues & 8) {
+      _lastItem[15] = (LLAS_UCHAR)decoder.decodeSymbol(_getModel(_classification, _lastItem[15]));
+    }
+
+    if (changedValues & 4) {
+      const LLAS_ULONG scanDirectionFlag = (_lastItem[14] >> 6) & 0x01;
+      _lastItem[16] = foldByte((LLAS_LONG)decoder.decodeSymbol(_scanAngleRank[scanDirectionFlag]) + _lastItem[16]);
+    }
+
+    if (changedValues & 2) {
+      _lastItem[17] = (LLAS_UCHAR)decoder.decodeSymbol(_getModel(_userData, _lastItem[17]));
+    }
+
+    if (changedValues & 1) {
+      LLAS_USHORT pointSourceID;
+      std::memcpy(&pointSourceID, _lastItem + 18, sizeof(LLAS_USHORT));
+      pointSourceID = (LLAS_USHORT)_pointSourceID.decompress(decoder, pointSourceID);
+      std::memcpy(_lastItem + 18, &pointSourceID, sizeof(LLAS_USHORT));
+    }
+
+    LLAS_LONG x, y;
+    std::memcpy(&x, _lastItem + 0, sizeof(LLAS_LONG));
+    std::memcpy(&y, _lastItem + 4, sizeof(LLAS_LONG));
+
+    const LLAS_ULONG isSingleReturn = numberOfReturns == 1;
+
+    const LLAS_LONG dx = _dx.decompress(decoder, _lastXDiffMedian5[m].get(), isSingleReturn);
+    x = (LLAS_LONG)((LLAS_ULONG)x + (LLAS_ULONG)dx);
+    _lastXDiffMedian5[m].add(dx);
+
+    LLAS_ULONG kBits = _dx.getK();
+    const LLAS_LONG dy = _dy.decompress(decoder, _lastYDiffMedian5[m].get(), isSingleReturn + (kBits < 20 ? (kBits & ~1U) : 20));
+    y = (LLAS_LONG)((LLAS_ULONG)y + (LLAS_ULONG)dy);
+    _lastYDiffMedian5[m].add(dy);
+
+    kBits = (_dx.getK() + _dy.getK()) / 2;
+    _lastHeight[l] = _z.decompress(decoder, _lastHeight[l], isSingleReturn + (kBits < 18 ? (kBits & ~1U) : 18));
+
+    std::memcpy(_lastItem + 0, &x, sizeof(LLAS_LONG));
+    std::memcpy(_lastItem + 4, &y, sizeof(LLAS_LONG));
+    std::memcpy(_lastItem + 8, &_lastHeight[l], sizeof(LLAS_LONG));
+
+    std::memcpy(item, _lastItem, POINT10_SIZE);
+  }
+
+ private:
+  LLAS_UCHAR _lastItem[POINT10_SIZE];
+  LLAS_USHORT _lastIntensity[16];
+  StreamingMedian5 _lastXDiffMedian5[16];
+  StreamingMedian5 _lastYDiffMedian5[16];
+  LLAS_LONG _lastHeight[8];
+
+  SymbolModel _changedValues;
+  IntegerDecompressor _intensity;
+  SymbolModel _scanAngleRank[2];
+  IntegerDecompressor _pointSourceID;
+  std::unique_ptr<SymbolModel> _bitByte[256];
+  std::unique_ptr<SymbolModel> _classification[256];
+  std::unique_ptr<SymbolModel> _userData[256];
+  IntegerDecompressor _dx;
+  IntegerDecompressor _dy;
+  IntegerDecompressor _z;
+
+  // NOTE: Models conditioned on the previous byte are created on first use
+  static inline SymbolModel& _getModel(std::unique_ptr<SymbolModel> (&models)[256], const LLAS_UCHAR previous) {
+    if (!models[previous]) {
+      models[previous] = std::make_unique<SymbolModel>(256);
+    }
+    return *models[previous];
+  }
+};
+
+/// @brief Decoder of the `GPSTIME11` item (version 2). Up to 4 interleaved sequences of GPS times are tracked.
+class GPSTime11Decompressor {
+ public:
+  GPSTime11Decompressor()
+      : _last(),
+        _next(),
+        _lastGPSTime(),
+        _lastGPSTimeDiff(),
+        _multiExtremeCounter(),
+        _multi((LLAS_ULONG)GPSTIME_MULTI_TOTAL),
+        _zeroDiff(6),
+        _gpsTime(32, 9) {}
+
+  /// @brief Start a chunk with its raw first item
+  inline void init(const char* item) {
+    std::memcpy(&_lastGPSTime[0], item, GPSTIME11_SIZE);
+  }
+
+  inline void decompress(ArithmeticDecoder& decoder, char* item) {
+    // NOTE: Switching to another sequence decodes the next symbol again
+    while (!_decompress(decoder)) {
+    }
+    std::memcpy(item, &_lastGPSTime[_last], GPSTIME11_SIZE);
+  }
+
+ private:
+  LLAS_ULONG _last;
+  LLAS_ULONG _next;
+  LLAS_LLONG _lastGPSTime[4];  // bits of the doubles
+  LLAS_LONG _lastGPSTimeDiff[4];
+  LLAS_LONG _multiExtremeCounter[4];
+  SymbolModel _multi;
+  SymbolModel _zeroDiff;
+  IntegerDecompressor _gpsTime;
+
+  /// @return `false` if the current sequence was switched and the time is still to be decoded
+  inline bool _decompress(ArithmeticDecoder& decoder) {
+    if (_lastGPSTimeDiff[_last] == 0) {
+      const LLAS_LONG multi = (LLAS_LONG)decoder.decodeSymbol(_zeroDiff);
+
+      if (multi == 1) {
+        // NOTE: The difference fits in 32 bits
+        _lastGPSTimeDiff[_last] = _gpsTime.decompress(decoder, 0, 0);
+        _lastGPSTime[_last] += _lastGPSTimeDiff[_last];
+        _multiExtremeCounter[_last] = 0;
+      } else if (multi == 2) {
+        _readFullGPSTime(decoder);
+      } else if (multi > 2) {
+        _last = (_last + multi - 2) & 3;
+        return false;
+      }
+
+      return true;
+    }
+
+    LLAS_LONG multi = (LLAS_LONG)decoder.decodeSymbol(_multi);
+    const LLAS_LONG lastDiff = _lastGPSTimeDiff[_last];
+
+    if (multi == 1) {
+      _lastGPSTime[_last] += _gpsTime.decompress(decoder, lastDiff, 1);
+      _multiExtremeCounter[_last] = 0;
+    } else if (multi < GPSTIME_MULTI_UNCHANGED) {
+      LLAS_LONG gpsTimeDiff;
+      bool isExtreme = false;
+
+      if (multi == 0) {
+        gpsTimeDiff = _gpsTime.decompress(decoder, 0, 7);
+        isExtreme = true;
+      } else if (multi < GPSTIME_MULTI) {
+        gpsTimeDiff = _gpsTime.decompress(decoder, _multiply(multi, lastDiff), multi < 10 ? 2 : 3);
+      } else if (multi == GPSTIME_MULTI) {
+        gpsTimeDiff = _gpsTime.decompress(decoder, _multiply(GPSTIME_MULTI, lastDiff), 4);
+        isExtreme = true;
+      } else {
+        multi = GPSTIME_MULTI - multi;
+        if (multi > GPSTIME_MULTI_MINUS) {
+          gpsTimeDiff = _gpsTime.decompress(decoder, _multiply(multi, lastDiff), 5);
+        } else {
+          gpsTimeDiff = _gpsTime.decompress(decoder, _multiply(GPSTIME_MULTI_MINUS, lastDiff), 6);
+          isExtreme = true;
+        }
+      }
+
+      // NOTE: The difference is adopted as the new reference after repeated extreme multipliers
+      if (isExtreme && ++_multiExtremeCounter[_last] > 3) {
+        _lastGPSTimeDiff[_last] = gpsTimeDiff;
+        _multiExtremeCounter[_last] = 0;
+      }
+
+      _lastGPSTime[_last] += gpsTimeDiff;
+    } else if (multi == GPSTIME_MULTI_CODE_FULL) {
+      _readFullGPSTime(decoder);
+    } else if (multi > GPSTIME_MULTI_CODE_FULL) {
+      _last = (_last + multi - GPSTIME_MULTI_CODE_FULL) & 3;
+      return false;
+    }
+
+    return true;
+  }
+
+  inline void _readFullGPSTime(ArithmeticDecoder& decoder) {
+    _next = (_next + 1) & 3;
+    const LLAS_ULLONG upper = (LLAS_ULONG)_gpsTime.decompress(decoder, (LLAS_LONG)((LLAS_ULLONG)_lastGPSTime[_last] >> 32), 8);
+    const LLAS_ULLONG lower = decoder.readInt();
+    _lastGPSTime[_next] = (LLAS_LLONG)((upper << 32) | lower);
+    _last = _next;
+    _lastGPSTimeDiff[_last] = 0;
+    _multiExtremeCounter[_last] = 0;
+  }
+
+  static inline LLAS_LONG _multiply(const LLAS_LONG multi, const LLAS_LONG diff) {
+    return (LLAS_LONG)((LLAS_ULONG)multi * (LLAS_ULONG)diff);
+  }
+};
+
+/// @brief Decoder of the `RGB12` item (version 2)
+class RGB12Decompressor {
+ public:
+  RGB12Decompressor()
+      : _lastItem(),
+        _byteUsed(128),
+        _diffs{SymbolModel(256), SymbolModel(256), SymbolModel(256), SymbolModel(256), SymbolModel(256), SymbolModel(256)} {}
+
+  /// @brief Start a chunk with its raw first item
+  inline void init(const char* item) {
+    std::memcpy(_lastItem, item, RGB12_SIZE);
+  }
+
+  inline void decompress(ArithmeticDecoder& decoder, char* item) {
+    const LLAS_ULONG byteUsed = decoder.decodeSymbol(_byteUsed);
+    const LLAS_USHORT* last = _lastItem;
+    LLAS_USHORT rgb[3];
+
+    rgb[0] = _decodeByte(decoder, byteUsed & (1 << 0), 0, last[0] & 0xFF, last[0] & 0xFF);
+    rgb[0] |= _decodeByte(decoder, byteUsed & (1 << 1), 1, last[0] >> 8, last[0] >> 8) << 8;
+
+    if (byteUsed & (1 << 6)) {
+      // NOTE: Green and blue are predicted from the change of red
+      LLAS_LONG diff = (rgb[0] & 0xFF) - (last[0] & 0xFF);
+      rgb[1] = _decodeByte(decoder, byteUsed & (1 << 2), 2, clampByte(diff + (last[1] & 0xFF)), last[1] & 0xFF);
+      diff = (diff + ((rgb[1] & 0xFF) - (last[1] & 0xFF))) / 2;
+      rgb[2] = _decodeByte(decoder, byteUsed & (1 << 4), 4, clampByte(diff + (last[2] & 0xFF)), last[2] & 0xFF);
+
+      diff = (rgb[0] >> 8) - (last[0] >> 8);
+      rgb[1] |= _decodeByte(decoder, byteUsed & (1 << 3), 3, clampByte(diff + (last[1] >> 8)), last[1] >> 8) << 8;
+      diff = (diff + ((rgb[1] >> 8) - (last[1] >> 8))) / 2;
+      rgb[2] |= _decodeByte(decoder, byteUsed & (1 << 5), 5, clampByte(diff + (last[2] >> 8)), last[2] >> 8) << 8;
+    } else {
+      rgb[1] = rgb[0];
+      rgb[2] = rgb[0];
+    }
+
+    std::memcpy(_lastItem, rgb, RGB12_SIZE);
+    std::memcpy(item, rgb, RGB12_SIZE);
+  }
+
+ private:
+  LLAS_USHORT _lastItem[3];
+  SymbolModel _byteUsed;
+  SymbolModel _diffs[6];
+
+  /// @brief Decode a byte as a difference to `prediction`, or keep `previous` if it is unchanged
+  inline LLAS_USHORT _decodeByte(ArithmeticDecoder& decoder,
+                                 const LLAS_ULONG isChanged,
+                                 const int iDiff,
+                                 const LLAS_LONG prediction,
+                                 const LLAS_LONG previous) {
+    if (!isChanged) {
+      return (LLAS_USHORT)previous;
+    }
+    return foldByte((LLAS_LONG)decoder.decodeSymbol(_diffs[iDiff]) + prediction);
+  }
+};
+
+/// @brief Decoder of the `BYTE` item (version 2): extra bytes coded as differences to the previous record
+class ByteDecompressor {
+ public:
+  explicit ByteDecompressor(const size_t nBytes)
+      : _lastItem(nBytes),
+        _models(nBytes, SymbolModel(256)) {}
+
+  /// @brief Start a chunk with its raw first item
+  inline void init(const char* item) {
+    std::memcpy(_lastItem.data(), item, _lastItem.size());
+  }
+
+  inline void decompress(ArithmeticDecoder& decoder, char* item) {
+    for (size_t iByte = 0; iByte < _lastItem.size(); ++iByte) {
+      _lastItem[iByte] = foldByte((LLAS_LONG)_lastItem[iByte] + (LLAS_LONG)decoder.decodeSymbol(_models[iByte]));
+    }
+    std::memcpy(item, _lastItem.data(), _lastItem.size());
+  }
+
+ private:
+  std::vector<LLAS_UCHAR> _lastItem;
+  std::vector<SymbolModel> _models;
+};
+
+/// @brief Item of a compressed record
+struct LasZipItem {
+  LLAS_USHORT type;
+  LLAS_USHORT size;
+  LLAS_USHORT version;
+};
+
+/// @brief Contents of the 'laszip encoded' VLR
+struct LasZip {
+  LasZip()
+      : compressor(),
+        coder(),
+        versionMajor(),
+        versionMinor(),
+        versionRevision(),
+        options(),
+        chunkSize(),
+        items() {}
+
+  // clang-format off
+  inline static const std::streamsize NUM_BYTES_HEADER                                             = 34;
+  inline static const std::streamsize NUM_BYTES_ITEM                                               = 6;
+  // clang-format on
+
+  LLAS_USHORT compressor;
+  LLAS_USHORT coder;
+  LLAS_UCHAR versionMajor;
+  LLAS_UCHAR versionMinor;
+  LLAS_USHORT versionRevision;
+  LLAS_ULONG options;
+  LLAS_ULONG chunkSize;
+  std::vector<LasZipItem> items;
+
+  /// @brief Check whether `vlr` is the 'laszip encoded' VLR
+  static inline bool isLasZipVLR(const VariableLengthRecord& vlr) {
+    return vlr.recordID == VLR_RECORD_ID && std::strncmp(vlr.userID, VLR_USER_ID, VariableLengthRecord::NUM_BYTES_USER_ID) == 0;
+  }
+
+  /// @brief Parse the payload of the 'laszip encoded' VLR
+  /// @return `true` if the payload is complete
+  inline bool read(const RecordBytes& record) {
+    if ((std::streamsize)record.size() < NUM_BYTES_HEADER) {
+      return false;
+    }
+
+    const char* data = record.data();
+    LLAS_USHORT nItems;
+    std::memcpy(&compressor, data + 0, sizeof(LLAS_USHORT));
+    std::memcpy(&coder, data + 2, sizeof(LLAS_USHORT));
+    std::memcpy(&versionMajor, data + 4, sizeof(LLAS_UCHAR));
+    std::memcpy(&versionMinor, data + 5, sizeof(LLAS_UCHAR));
+    std::memcpy(&versionRevision, data + 6, sizeof(LLAS_USHORT));
+    std::memcpy(&options, data + 8, sizeof(LLAS_ULONG));
+    std::memcpy(&chunkSize, data + 12, sizeof(LLAS_ULONG));
+    // NOTE: 16 bytes of the special EVLRs are unused
+    std::memcpy(&nItems, data + 32, sizeof(LLAS_USHORT));
+
+    if ((std::streamsize)record.size() < NUM_BYTES_HEADER + nItems * NUM_BYTES_ITEM) {
+      return false;
+    }
+
+    items.resize(nItems);
+    for (LLAS_USHORT iItem = 0; iItem < nItems; ++iItem) {
+      const char* item = data + NUM_BYTES_HEADER + iItem * NUM_BYTES_ITEM;
+      std::memcpy(&items[iItem].type, item + 0, sizeof(LLAS_USHORT));
+      std::memcpy(&items[iItem].size, item + 2, sizeof(LLAS_USHORT));
+      std::memcpy(&items[iItem].version, item + 4, sizeof(LLAS_USHORT));
+    }
+
+    return true;
+  }
+
+  /// @brief Check whether the items can be decoded and fill a record of `recordLength` bytes
+  inline bool isSupported(const LLAS_USHORT recordLength) const {
+    if (compressor != COMPRESSOR_POINTWISE_CHUNKED || items.empty()) {
+      return false;
+    }
+
+    size_t size = 0;
+    for (size_t iItem = 0; iItem < items.size(); ++iItem) {
+      const LasZipItem& item = items[iItem];
+      const bool isSupportedItem = item.version == 2 &&
+                                   ((item.type == ITEM_POINT10 && item.size == POINT10_SIZE && iItem == 0) ||
+                                    (item.type == ITEM_GPSTIME11 && item.size == GPSTIME11_SIZE) ||
+                                    (item.type == ITEM_RGB12 && item.size == RGB12_SIZE) ||
+                                    (item.type == ITEM_BYTE && item.size > 0));
+      if (!isSupportedItem) {
+        return false;
+      }
+      size += item.size;
+    }
+
+    return size == recordLength;
+  }
+};
+
+/// @brief Compressed bytes and number of points of a chunk
+struct Chunk {
+  LLAS_ULLONG offset;  // from the beginning of the file
+  LLAS_ULLONG nBytes;
+  LLAS_ULLONG nPoints;
+};
+
+/// @brief Read the chunk table which follows the compressed point data
+/// @param data Bytes of the whole file
+/// @param dataSize Number of bytes in `data`
+/// @param publicHeader Public header of the file
+/// @param lasZip Contents of the 'laszip encoded' VLR
+/// @param chunks Output chunks
+/// @return `true` if the table is consistent with the header and the file size
+LLAS_FUNC_DECL_PREFIX bool readChunkTable(const char* data,
+                                          const size_t dataSize,
+                                          const PublicHeader& publicHeader,
+                                          const LasZip& lasZip,
+                                          std::vector<Chunk>& chunks) {
+  const LLAS_ULLONG pointDataOffset = publicHeader.offsetToPointData;
+  if (pointDataOffset + sizeof(LLAS_LLONG) > dataSize) {
+    return false;
+  }
+
+  // NOTE: Writers which could not seek back store `-1` and append the offset at the end of the file
+  LLAS_LLONG chunkTableOffset;
+  std::memcpy(&chunkTableOffset, data + pointDataOffset, sizeof(LLAS_LLONG));
+  if (chunkTableOffset == -1) {
+    std::memcpy(&chunkTableOffset, data + dataSize - sizeof(LLAS_LLONG), sizeof(LLAS_LLONG));
+  }
+
+  const LLAS_ULLONG chunksBegin = pointDataOffset + sizeof(LLAS_LLONG);
+  if (chunkTableOffset < (LLAS_LLONG)chunksBegin || (LLAS_ULLONG)chunkTableOffset + 2 * sizeof(LLAS_ULONG) > dataSize) {
+    return false;
+  }
+
+  LLAS_ULONG version, nChunks;
+  std::memcpy(&version, data + chunkTableOffset, sizeof(LLAS_ULONG));
+  std::memcpy(&nChunks, data + chunkTableOffset + sizeof(LLAS_ULONG), sizeof(LLAS_ULONG));
+
+  const size_t tableBegin = (size_t)chunkTableOffset + 2 * sizeof(LLAS_ULONG);
+  ArithmeticDecoder decoder;
+  decoder.init(data + tableBegin, dataSize - tableBegin);
+  IntegerDecompressor integerDecompressor(32, 2);
+
+  const bool isVariable = lasZip.chunkSize == VARIABLE_CHUNK_SIZE;
+  const LLAS_ULLONG nPointRecords = publicHeader.getNumPointRecords();
+
+  chunks.resize(nChunks);
+  LLAS_ULLONG offset = chunksBegin;
+  LLAS_ULLONG nPoints = 0;
+  for (LLAS_ULONG iChunk = 0; iChunk < nChunks; ++iChunk) {
+    Chunk& chunk = chunks[iChunk];
+
+    if (isVariable) {
+      chunk.nPoints = (LLAS_ULONG)integerDecompressor.decompress(decoder, iChunk > 0 ? (LLAS_LONG)chunks[iChunk - 1].nPoints : 0, 0);
+    } else {
+      chunk.nPoints = std::min<LLAS_ULLONG>(lasZip.chunkSize, nPointRecords - std::min(nPoints, nPointRecords));
+    }
+    chunk.nBytes = (LLAS_ULONG)integerDecompressor.decompress(decoder, iChunk > 0 ? (LLAS_LONG)chunks[iChunk - 1].nBytes : 0, 1);
+    chunk.offset = offset;
+
+    offset += chunk.nBytes;
+    nPoints += chunk.nPoints;
+  }
+
+  if (offset > (LLAS_ULLONG)chunkTableOffset) {
+    _LLAS_logError("LAZ chunks exceed the chunk table");
+    return false;
+  }
+
+  if (nPoints != nPointRecords) {
+    _LLAS_logError("LAZ chunk table does not match the number of points: " + std::to_string(nPoints));
+    return false;
+  }
+
+  return true;
+}
+
+/// @brief Decode the records of a chunk
+/// @param chunkData Compressed bytes of the chunk
+/// @param chunk Chunk to decode
+/// @param lasZip Contents of the 'laszip encoded' VLR
+/// @param recordLength Size of a record in bytes
+/// @param byteData Output records of `chunk.nPoints * recordLength` bytes
+/// @return `false` if the chunk is too small to hold its first record
+LLAS_FUNC_DECL_PREFIX bool decompressChunk(const char* chunkData,
+                                           const Chunk& chunk,
+                                           const LasZip& lasZip,
+                                           const LLAS_USHORT recordLength,
+                                           char* byteData) {
+  if (chunk.nPoints == 0) {
+    return true;
+  }
+
+  if (chunk.nBytes < recordLength) {
+    return false;
+  }
+
+  std::unique_ptr<Point10Decompressor> point10;
+  std::unique_ptr<GPSTime11Decompressor> gpsTime11;
+  std::unique_ptr<RGB12Decompressor> rgb12;
+  std::vector<std::unique_ptr<ByteDecompressor>> bytes;
+
+  // NOTE: The first record of a chunk is stored raw
+  std::memcpy(byteData, chunkData, recordLength);
+
+  size_t itemOffset = 0;
+  for (const LasZipItem& item : lasZip.items) {
+    const char* firstItem = byteData + itemOffset;
+    if (item.type == ITEM_POINT10) {
+      point10 = std::make_unique<Point10Decompressor>();
+      point10->init(firstItem);
+    } else if (item.type == ITEM_GPSTIME11) {
+      gpsTime11 = std::make_unique<GPSTime11Decompressor>();
+      gpsTime11->init(firstItem);
+    } else if (item.type == ITEM_RGB12) {
+      rgb12 = std::make_unique<RGB12Decompressor>();
+      rgb12->init(firstItem);
+    } else {
+      bytes.push_back(std::make_unique<ByteDecompressor>(item.size));
+      bytes.back()->init(firstItem);
+    }
+    itemOffset += item.size;
+  }
+
+  ArithmeticDecoder decoder;
+  decoder.init(chunkData + recordLength, chunk.nBytes - recordLength);
+
+  for (LLAS_ULLONG iPoint = 1; iPoint < chunk.nPoints; ++iPoint) {
+    char* record = byteData + iPoint * recordLength;
+    size_t iBytes = 0;
+
+    itemOffset = 0;
+    for (const LasZipItem& item : lasZip.items) {
+      if (item.type == ITEM_POINT10) {
+        point10->decompress(decoder, record + itemOffset);
+      } else if (item.type == ITEM_GPSTIME11) {
+        gpsTime11->decompress(decoder, record + itemOffset);
+      } else if (item.type == ITEM_RGB12) {
+        rgb12->decompress(decoder, record + itemOffset);
+      } else {
+        bytes[iBytes++]->decompress(decoder, record + itemOffset);
+      }
+      itemOffset += item.size;
+    }
+  }
+
+  return true;
+}
+
+/// @brief Decode all compressed 'Point Data Records' of a LAZ file. Chunks are distributed over the threads.
+/// @param data Bytes of the whole file
+/// @param dataSize Number of bytes in `data`
+/// @param publicHeader Public header of the file
+/// @param variableLengthRecords VLRs of the file, one of which is the 'laszip encoded' VLR
+/// @param nThreads Number of threads. `0` means all hardware threads.
+/// @param byteData Output uncompressed records
+/// @param progress Counts the decompressed records, if not `nullptr`. Stops decompressing once cancelled.
+/// @return `true` if the point data was decoded
+LLAS_FUNC_DECL_PREFIX bool decompressPointDataRecords(const char* data,
+                                                      const size_t dataSize,
+                                                      const PublicHeader& publicHeader,
+                                                      const std::vector<VariableLengthRecord>& variableLengthRecords,
+                                                      const size_t nThreads,
+                                                      std::vector<char>& byteData,
+                                                      DecodeProgress* progress = nullptr) {
+  LasZip lasZip;
+  const auto lasZipVLR = std::find_if(variableLengthRecords.begin(), variableLengthRecords.end(), LasZip::isLasZipVLR);
+  if (lasZipVLR == variableLengthRecords.end() || !lasZip.read(lasZipVLR->record)) {
+    _LLAS_logError("LAZ file without a valid 'laszip encoded' VLR");
+    return false;
+  }
+
+  const LLAS_USHORT recordLength = publicHeader.pointDataRecordLength;
+  if (!lasZip.isSupported(recordLength)) {
+    _LLAS_logError("Unsupported LAZ compression (compressor " + std::to_string(lasZip.compressor) + "). Only pointwise chunked point data of formats 0 to 3 is supported.");
+    return false;
+  }
+
+  std::vector<Chunk> chunks;
+  if (!readChunkTable(data, dataSize, publicHeader, lasZip, chunks)) {
+    _LLAS_logError("Broken LAZ chunk table");
+    return false;
+  }
+  _LLAS_logInfo("nChunks: " + std::to_string(chunks.size()));
+
+  std::vector<LLAS_ULLONG> firstIndices(chunks.size(), 0);
+  for (size_t iChunk = 1; iChunk < chunks.size(); ++iChunk) {
+    firstIndices[iChunk] = firstIndices[iChunk - 1] + chunks[iChunk - 1].nPoints;
+  }
+
+  byteData.resize((size_t)publicHeader.getNumPointRecords() * recordLength);
+
+  // NOTE: Every chunk is an independent arithmetic coded stream
+  std::vector<char> isChunkOK(chunks.size(), 0);
+  parallelForBlocks(
+      chunks.size(), nThreads, [&](const size_t iBlock, const size_t begin, const size_t end) {
+        for (size_t iChunk = begin; iChunk < end && !(progress != nullptr && progress->isCancelled()); ++iChunk) {
+          isChunkOK[iChunk] = decompressChunk(data + chunks[iChunk].offset, chunks[iChunk], lasZip, recordLength, byteData.data() + firstIndices[iChunk] * recordLength);
+          if (progress != nullptr) {
+            progress->add(chunks[iChunk].nPoints, iBlock == 0);
+          }
+        }
+      },
+      1);
+
+  if (progress != nullptr && progress->isCancelled()) {
+    return false;
+  }
+
+  if (std::find(isChunkOK.begin(), isChunkOK.end(), 0) != isChunkOK.end()) {
+    _LLAS_logError("Broken LAZ chunk");
+    return false;
+  }
+
+  return true;
+}
+
+};  // namespace laz
+
+// ==========================================================================
+// Record writers
+// ==========================================================================
+
+template <int FORMAT>
+inline void _writePointDataRecords(const LasData& lasData,
+                                   const size_t firstIndex,
+                                   const size_t nRecords,
+                                   const LLAS_USHORT recordLength,
+                                   char* byteData) {
+  constexpr std::streamsize FORMAT_SIZE = PointDataRecordFormat<FORMAT>::SIZE;
+  const bool isColumnar = lasData.layout == PointDataLayout::StructOfArrays;
+  const bool isPacked = lasData.layout == PointDataLayout::Packed;
+  const PackedPointData& packedPointData = lasData.packedPointData;
+
+  for (size_t iRecord = 0; iRecord < nRecords; ++iRecord) {
+    char* record = byteData + iRecord * recordLength;
+
+    if (isColumnar) {
+      PointDataRecord::encodePointDataRecord<FORMAT>(lasData.pointDataColumns.get(firstIndex + iRecord), record);
+    } else if (isPacked && packedPointData.format == FORMAT) {
+      std::memcpy(record, packedPointData.getRecord(firstIndex + iRecord), FORMAT_SIZE);
+    } else if (isPacked) {
+      PointDataRecord::encodePointDataRecord<FORMAT>(packedPointData.get(firstIndex + iRecord), record);
+    } else {
+      PointDataRecord::encodePointDataRecord<FORMAT>(lasData.pointDataRecords[firstIndex + iRecord], record);
+    }
+
+    // NOTE: Extra bytes are not kept by the reader and are written as zero
+    if (recordLength > FORMAT_SIZE) {
+      std::fill(record + FORMAT_SIZE, record + recordLength, (char)0);
+    }
+  }
+}
+
+/// @brief Encode points of `lasData` into 'Point Data Records' in parallel
+/// @param lasData Points in either layout
+/// @param firstIndex Index of the first point to encode
+/// @param nRecords Number of points to encode
+/// @param recordLength Size of a record in bytes. Must not be shorter than the size of `format`.
+/// @param format Point data record format
+/// @param nThreads Number of threads. `0` means all hardware threads.
+/// @param byteData Output bytes of `nRecords * recordLength`
+/// @return `true` if the format is supported
+LLAS_FUNC_DECL_PREFIX bool writePointDataRecords(const LasData& lasData,
+                                                 const size_t firstIndex,
+                                                 const size_t nRecords,
+                                                 const LLAS_USHORT recordLength,
+                                                 const LLAS_UCHAR format,
+                                                 const size_t nThreads,
+                                                 char* byteData) {
+  const bool isSupported = visitPointDataRecordFormat(format, [&](auto formatTag) {
+    constexpr int FORMAT = decltype(formatTag)::value;
+
+    parallelFor(nRecords, nThreads, [&](const size_t begin, const size_t end) {
+      _writePointDataRecords<FORMAT>(lasData, firstIndex + begin, end - begin, recordLength, byteData + begin * recordLength);
+    });
+  });
+
+  if (!isSupported) {
+    _LLAS_logError("Unsupported point data record format: " + std::to_string((int)format));
+  }
+
+  return isSupported;
+}
+
+// ==========================================================================
+// Streaming reader
+// ==========================================================================
+
+/// @brief Incremental reader which decodes 'Point Data Records' chunk by chunk.
+///        Only the header, VLRs/EVLRs and one chunk of raw records are held in memory at a time.
+class LasReader {
+ public:
+  inline static const size_t DEFAULT_CHUNK_SIZE = 1 << 20;
+
+  LasReader()
+      : _file(),
+        _header(),
+        _variableLengthRecords(),
+        _extendedVariableLengthRecords(),
+        _chunkBytes(),
+        _nPointRecords(),
+        _iNextRecord(),
+        _numThreads(1),
+        _fields(PointField::ALL),
+        _filter(),
+        _fileSize(),
+        _hasRanges(false),
+        _ranges(),
+        _iRange() {}
+
+  LasReader(const std::string& filePath, const ReadOptions& options = ReadOptions())
+      : LasReader() {
+    open(filePath, options);
+  }
+
+  /// @brief Open file and read the public header and (E)VLRs
+  /// @param filePath Path to the las file
+  /// @param options Read options (`pointDataOnly` skips VLRs and EVLRs, `numThreads`, `fields` and `filter` are used to decode chunks)
+  /// @return `true` if the file is ready to read points
+  inline bool open(const std::string& filePath, const ReadOptions& options = ReadOptions()) {
+    close();
+
+    _file.open(filePath, std::ios::binary);
+    if (!_file) {
+      _LLAS_logError("Failed to open file: " + filePath);
+      return false;
+    }
+
+    _file.seekg(0, std::ios::end);
+    const LLAS_ULLONG fileSize = (LLAS_ULLONG)_file.tellg();
+    _file.seekg(0, std::ios::beg);
+
+    if (fileSize < (LLAS_ULLONG)PublicHeader::MIN_HEADER_SIZE) {
+      _LLAS_logError("File is too small to contain a public header: " + filePath);
+      close();
+      return false;
+    }
+
+    // Read 'Public Header', 'Variable Length Records' and 'Extended Variable Length Records'
+    if (!readFileHeader(io::FileByteSource(filePath), !options.pointDataOnly, _header, _variableLengthRecords, _extendedVariableLengthRecords)) {
+      close();
+      return false;
+    }
+
+    if (_header.isCompressed()) {
+      _LLAS_logError("LAZ files can not be streamed, use `llas::read` instead: " + filePath);
+      close();
+      return false;
+    }
+
+    const LLAS_UCHAR format = _header.pointDataRecordFormat;
+    if (10 < format) {
+      // NOTE: Format is defined from 0 to 10
+      _LLAS_logError("Invalid point data record format:  " + std::to_string(format));
+      close();
+      return false;
+    }
+
+    if (_header.pointDataRecordLength < PointDataRecord::getFormatSize(format)) {
+      _LLAS_logError("Point data record length is shorter than the point data record format: " + std::to_string(_header.pointDataRecordLength));
+      close();
+      return false;
+    }
+
+    _nPointRecords = _header.getNumPointRecords();
+    _LLAS_logInfo("nPointRecords: " + std::to_string(_nPointRecords));
+
+    if ((LLAS_ULLONG)_header.offsetToPointData + _nPointRecords * _header.pointDataRecordLength > fileSize) {
+      _LLAS_logError("Point Data Records exceed the end of file: " + filePath);
+      close();
+      return false;
+    }
+
+    _numThreads = options.numThreads;
+    _fields = options.fields;
+    _filter = RawPointFilter(options.filter, _header);
+    _fileSize = fileSize;
+
+    if (options.useSidecarIndex && _filter.hasBoundingBox && !_filter.isEmpty) {
+      const auto readRecord = [this](const LLAS_ULLONG iRecord, char* recordData) {
+        _file.seekg((std::streamoff)(_header.offsetToPointData + iRecord * _header.pointDataRecordLength), std::ios::beg);
+        _file.read(recordData, _header.pointDataRecordLength);
+        const bool isRead = _file.gcount() == (std::streamsize)_header.pointDataRecordLength;
+        _file.clear();
+        return isRead;
+      };
+
+      SidecarIndex sidecarIndex;
+      io::FileStamp fileStamp;
+      if (sidecarIndex.read(SidecarIndex::getPath(filePath)) && io::getFileStamp(filePath, fileStamp)) {
+        if (sidecarIndex.isValidFor(_header, fileSize, readRecord, fileStamp.modificationTime)) {
+          _hasRanges = true;
+          _ranges = sidecarIndex.getRecordRanges(_filter);
+          _LLAS_logInfo("nRecordRanges: " + std::to_string(_ranges.size()));
+        } else {
+          _LLAS_logInfo("Ignore outdated sidecar index: " + SidecarIndex::getPath(filePath));
+        }
+      }
+    }
+
+    return seek(0);
+  }
+
+  /// @brief Close file and release buffers
+  inline void close() {
+    if (_file.is_open()) {
+      _file.close();
+    }
+    _file.clear();
+    _header = PublicHeader();
+    _variableLengthRecords.clear();
+    _extendedVariableLengthRecords.clear();
+    _chunkBytes.clear();
+    _chunkBytes.shrink_to_fit();
+    _nPointRecords = 0;
+    _iNextRecord = 0;
+    _filter = RawPointFilter();
+    _fileSize = 0;
+    _hasRanges = false;
+    _ranges.clear();
+    _iRange = 0;
+  }
+
+  inline bool isOpen() const {
+    return _file.is_open();
+  }
+
+  inline const PublicHeader& getHeader() const {
+    return _header;
+  }
+
+  inline const std::vector<VariableLengthRecord>& getVariableLengthRecords() const {
+    return _variableLengthRecords;
+  }
+
+  inline const std::vector<ExtendedVariableLengthRecord>& getExtendedVariableLengthRecords() const {
+    return _extendedVariableLengthRecords;
+  }
+
+  /// @brief Get the number of points in the file
+  inline LLAS_ULLONG getNumPoints() const {
+    return _nPointRecords;
+  }
+
+  /// @brief Get the size of the file in bytes
+  inline LLAS_ULLONG getFileSize() const {
+    return _fileSize;
+  }
+
+  /// @brief Get the index of the next record to be read
+  inline LLAS_ULLONG tell() const {
+    return _iNextRecord;
+  }
+
+  /// @brief Check whether all records have been read
+  inline bool eof() const {
+    return _iNextRecord >= _nPointRecords;
+  }
+
+  /// @brief Move to the record `iRecord`
+  /// @param iRecord Index of the next record to read
+  /// @return `true` if the record exists
+  inline bool seek(const LLAS_ULLONG iRecord) {
+    if (!isOpen() || iRecord > _nPointRecords) {
+      return false;
+    }
+
+    _iNextRecord = iRecord;
+    _iRange = 0;
+    return true;
+  }
+
+  /// @brief Decode the next chunk of 'Point Data Records'.
+  ///        With a filter, records are read until at least one of them passes, so a chunk may hold fewer than `maxPoints` points.
+  /// @param pointDataRecords Output buffer which is resized to the number of decoded points. Reusing the same buffer avoids re-allocation.
+  /// @param maxPoints Maximum number of records read from the file for a chunk
+  /// @return `nPoints` (`size_t`): number of decoded points. `0` at the end of file or on failure.
+  inline size_t nextChunk(std::vector<PointDataRecord>& pointDataRecords,
+                          const size_t maxPoints = DEFAULT_CHUNK_SIZE) {
+    size_t nPoints = 0;
+    size_t nRecords = 0;
+
+    do {
+      nRecords = _readChunkBytes(maxPoints);
+      nPoints = decodePointDataRecords(_chunkBytes.data(), nRecords, _header.pointDataRecordLength, _header.pointDataRecordFormat, _fields, _filter, _numThreads, pointDataRecords);
+    } while (nPoints == 0 && nRecords > 0);
+
+    return nPoints;
+  }
+
+  /// @brief Decode the next chunk of 'Point Data Records' into columns.
+  ///        With a filter, records are read until at least one of them passes, so a chunk may hold fewer than `maxPoints` points.
+  /// @param pointDataColumns Output columns which are resized to the number of decoded points. Reusing the same columns avoids re-allocation.
+  /// @param maxPoints Maximum number of records read from the file for a chunk
+  /// @return `nPoints` (`size_t`): number of decoded points. `0` at the end of file or on failure.
+  inline size_t nextChunk(PointDataColumns& pointDataColumns,
+                          const size_t maxPoints = DEFAULT_CHUNK_SIZE) {
+    size_t nPoints = 0;
+    size_t nRecords = 0;
+
+    do {
+      nRecords = _readChunkBytes(maxPoints);
+      nPoints = decodePointDataRecords(_chunkBytes.data(), nRecords, _header.pointDataRecordLength, _header.pointDataRecordFormat, _fields, _filter, _numThreads, pointDataColumns);
+    } while (nPoints == 0 && nRecords > 0);
+
+    return nPoints;
+  }
+
+  /// @brief Copy the next chunk of 'Point Data Records' into packed records.
+  ///        With a filter, records are read until at least one of them passes, so a chunk may hold fewer than `maxPoints` points.
+  /// @param packedPointData Output records which are resized to the number of copied points. Reusing the same records avoids re-allocation.
+  /// @param maxPoints Maximum number of records read from the file for a chunk
+  /// @return `nPoints` (`size_t`): number of copied points. `0` at the end of file or on failure.
+  inline size_t nextChunk(PackedPointData& packedPointData,
+                          const size_t maxPoints = DEFAULT_CHUNK_SIZE) {
+    size_t nPoints = 0;
+    size_t nRecords = 0;
+
+    do {
+      nRecords = _readChunkBytes(maxPoints);
+      nPoints = decodePointDataRecords(_chunkBytes.data(), nRecords, _header.pointDataRecordLength, _header.pointDataRecordFormat, _filter, _numThreads, packedPointData);
+    } while (nPoints == 0 && nRecords > 0);
+
+    return nPoints;
+  }
+
+ private:
+  /// @brief Read raw bytes of the next chunk into `_chunkBytes`
+  inline size_t _readChunkBytes(const size_t maxPoints) {
+    if (!isOpen() || eof()) {
+      return 0;
+    }
+
+    if (_filter.isEmpty) {
+      // NOTE: No record can pass the filter
+      _iNextRecord = _nPointRecords;
+      return 0;
+    }
+
+    LLAS_ULLONG rangeEnd = _nPointRecords;
+    if (_hasRanges) {
+      // NOTE: Skip the records outside the ranges of the sidecar index
+      while (_iRange < _ranges.size() && _ranges[_iRange].end <= _iNextRecord) {
+        ++_iRange;
+      }
+      if (_iRange == _ranges.size()) {
+        _iNextRecord = _nPointRecords;
+        return 0;
+      }
+      _iNextRecord = std::max(_iNextRecord, _ranges[_iRange].begin);
+      rangeEnd = _ranges[_iRange].end;
+    }
+
+    const size_t nPoints = (size_t)std::min<LLAS_ULLONG>(maxPoints, rangeEnd - _iNextRecord);
+    const size_t nBytes = nPoints * _header.pointDataRecordLength;
+
+    if (_chunkBytes.size() < nBytes) {
+      _chunkBytes.resize(nBytes);
+    }
+
+    // NOTE: Move to the starting point of the next Point Data Record
+    const LLAS_ULLONG offset = _header.offsetToPointData + _iNextRecord * _header.pointDataRecordLength;
+    _file.seekg((std::streamoff)offset, std::ios::beg);
+    _file.read(_chunkBytes.data(), (std::streamsize)nBytes);
+
+    if (_file.gcount() != (std::streamsize)nBytes) {
+      _LLAS_logError("Failed to read Point Data Records at: " + std::to_string(offset));
+      _file.clear();
+      return 0;
+    }
+
+    _iNextRecord += nPoints;
+
+    return nPoints;
+  }
+
+  std::ifstream _file;
+  PublicHeader _header;
+  std::vector<VariableLengthRecord> _variableLengthRecords;
+  std::vector<ExtendedVariableLengthRecord> _extendedVariableLengthRecords;
+  std::vector<char> _chunkBytes;
+  LLAS_ULLONG _nPointRecords;
+  LLAS_ULLONG _iNextRecord;
+  size_t _numThreads;
+  LLAS_ULONG _fields;
+  RawPointFilter _filter;
+  LLAS_ULLONG _fileSize;
+  bool _hasRanges;                   // Read only `_ranges`
+  std::vector<RecordRange> _ranges;  // Ranges to read given by the sidecar index
+  size_t _iRange;
+};
+
+/// @brief Build the sidecar index of a las file and write it next to the file (`SidecarIndex::getPath`)
+/// @param filePath Path to the las file
+/// @param cellsPerSide Number of cells along the longer side of the grid. `0` chooses about `SidecarIndex::DEFAULT_POINTS_PER_CELL` points per cell.
+/// @param numThreads Number of threads used to decode the coordinates. `0` means all hardware threads.
+/// @return `true` if the index is written
+LLAS_FUNC_DECL_PREFIX bool writeSidecarIndex(const std::string& filePath,
+                                             const size_t cellsPerSide = 0,
+                                             const size_t numThreads = 1) {
+  ReadOptions options;
+  options.numThreads = numThreads;
+  options.layout = PointDataLayout::StructOfArrays;
+  options.fields = PointField::XYZ;
+
+  // NOTE: The stamp is taken first, so that a file changed while it is indexed does not match the index
+  io::FileStamp fileStamp;
+  if (!io::getFileStamp(filePath, fileStamp)) {
+    _LLAS_logError("Failed to open file: " + filePath);
+    return false;
+  }
+
+  LasReader reader;
+  if (!reader.open(filePath, options)) {
+    return false;
+  }
+  const PublicHeader& header = reader.getHeader();
+
+  SidecarIndex sidecarIndex;
+  sidecarIndex.reset(header, reader.getFileSize(), cellsPerSide);
+  sidecarIndex.modificationTime = fileStamp.modificationTime;
+
+  const io::FileByteSource source(filePath);
+  const auto readRecord = [&](const LLAS_ULLONG iRecord, char* recordData) {
+    return source.read(header.offsetToPointData + iRecord * header.pointDataRecordLength, header.pointDataRecordLength, recordData);
+  };
+  if (!SidecarIndex::hashPointData(header, readRecord, sidecarIndex.pointDataHash)) {
+    _LLAS_logError("Failed to read Point Data Records: " + filePath);
+    return false;
+  }
+
+  PointDataColumns pointDataColumns;
+  LLAS_ULLONG iRecord = 0;
+  while (const size_t nPoints = reader.nextChunk(pointDataColumns)) {
+    for (size_t iPoint = 0; iPoint < nPoints; ++iPoint, ++iRecord) {
+      sidecarIndex.addPoint(iRecord, pointDataColumns.x[iPoint], pointDataColumns.y[iPoint], pointDataColumns.z[iPoint]);
+    }
+  }
+
+  if (iRecord != reader.getNumPoints()) {
+    _LLAS_logError("Failed to read all Point Data Records: " + filePath);
+    return false;
+  }
+
+  sidecarIndex.finalize();
+
+  return sidecarIndex.write(SidecarIndex::getPath(filePath));
+}
+
+// ==========================================================================
+// Spatial index
+// ==========================================================================
+
+/// @brief k-d tree over the integer coordinates of the points of a `LasData`.
+///        Points are stored in tree order together with the index of their record, so that a leaf is a contiguous range of memory.
+///        Queries are given in world coordinates and return the indices of the points (`LasData::getPointDataRecord`).
+class PointIndex {
+ public:
+  inline static const size_t DEFAULT_LEAF_SIZE = 32;
+
+  PointIndex()
+      : _header(),
+        _leafSize(DEFAULT_LEAF_SIZE),
+        _points(),
+        _nodes() {}
+
+  PointIndex(const LasData& lasData,
+             const size_t numThreads = 1,
+             const size_t leafSize = DEFAULT_LEAF_SIZE)
+      : PointIndex() {
+    build(lasData, numThreads, leafSize);
+  }
+
+  /// @brief Build the index
+  /// @param lasData Points to index. Only the header and the coordinates are copied, so `lasData` may be released afterwards.
+  /// @param numThreads Number of threads. `0` means all hardware threads.
+  /// @param leafSize Maximum number of points in a leaf
+  /// @return `true` if the coordinates of `lasData` are available
+  inline bool build(const LasData& lasData,
+                    const size_t numThreads = 1,
+                    const size_t leafSize = DEFAULT_LEAF_SIZE) {
+    clear();
+
+    const bool isColumnar = lasData.layout == PointDataLayout::StructOfArrays;
+    const bool isPacked = lasData.layout == PointDataLayout::Packed;
+    if (isColumnar && (lasData.pointDataColumns.fields & PointField::XYZ) != PointField::XYZ) {
+      _LLAS_logError("Point coordinates were not decoded");
+      return false;
+    }
+
+    if (lasData.header.xScaleFactor == 0.0 || lasData.header.yScaleFactor == 0.0 || lasData.header.zScaleFactor == 0.0) {
+      _LLAS_logError("Scale factors must not be zero");
+      return false;
+    }
+
+    const size_t nPoints = lasData.getNumPoints();
+    _header = lasData.header;
+    _leafSize = std::max<size_t>(1, leafSize);
+
+    // NOTE: Box queries are bounded by the tree itself rather than by the bounds in the header
+    const double inf = std::numeric_limits<double>::infinity();
+    _header.minX = _header.minY = _header.minZ = -inf;
+    _header.maxX = _header.maxY = _header.maxZ = inf;
+    _points.resize(nPoints);
+
+    parallelFor(nPoints, numThreads, [&](const size_t begin, const size_t end) {
+      for (size_t iPoint = begin; iPoint < end; ++iPoint) {
+        IndexedPoint& point = _points[iPoint];
+        point.index = iPoint;
+
+        if (isColumnar) {
+          point.coords = {lasData.pointDataColumns.x[iPoint], lasData.pointDataColumns.y[iPoint], lasData.pointDataColumns.z[iPoint]};
+        } else if (isPacked) {
+          const std::array<LLAS_LONG, 3> coords = lasData.packedPointData.getCoords(iPoint);
+          point.coords = {coords[0], coords[1], coords[2]};
+        } else {
+          const PointDataRecord& pointDataRecord = lasData.pointDataRecords[iPoint];
+          point.coords = {pointDataRecord.x, pointDataRecord.y, pointDataRecord.z};
+        }
+      }
+    });
+
+    _nodes.resize(_countNodes(nPoints));
+
+    // NOTE: Subtrees are built on their own thread down to the depth which gives a subtree to every thread
+    size_t parallelDepth = 0;
+    while (((size_t)1 << parallelDepth) < resolveNumThreads(numThreads)) {
+      ++parallelDepth;
+    }
+
+    _build(0, 0, nPoints, parallelDepth);
+
+    return true;
+  }
+
+  /// @brief Release the index
+  inline void clear() {
+    _header = PublicHeader();
+    _points.clear();
+    _points.shrink_to_fit();
+    _nodes.clear();
+    _nodes.shrink_to_fit();
+  }
+
+  /// @brief Get the number of indexed points
+  inline size_t size() const {
+    return _points.size();
+  }
+
+  inline bool empty() const {
+    return _points.empty();
+  }
+
+  /// @brief Find the `k` nearest points
+  /// @param point Query point in world coordinates
+  /// @param k Number of neighbors
+  /// @param indices Indices of the neighbors, nearest first
+  /// @param squaredDistances Squared distances of the neighbors in world units
+  /// @return `nNeighbors` (`size_t`): `min(k, size())`
+  inline size_t knnSearch(const math::vec3d_t& point,
+                          const size_t k,
+                          std::vector<size_t>& indices,
+                          std::vector<double>& squaredDistances) const {
+    indices.clear();
+    squaredDistances.clear();
+
+    if (empty() || k == 0) {
+      return 0;
+    }
+
+    const math::vec3d_t query = _toRaw(point);
+
+    // NOTE: Max-heap of the best candidates, the farthest on top
+    std::priority_queue<std::pair<double, size_t>> candidates;
+    _knnSearch(0, query, k, candidates);
+
+    const size_t nNeighbors = candidates.size();
+    indices.resize(nNeighbors);
+    squaredDistances.resize(nNeighbors);
+
+    for (size_t iNeighbor = nNeighbors; iNeighbor-- > 0;) {
+      squaredDistances[iNeighbor] = candidates.top().first;
+      indices[iNeighbor] = _points[candidates.top().second].index;
+      candidates.pop();
+    }
+
+    return nNeighbors;
+  }
+
+  /// @brief Find the `k` nearest points
+  /// @return `indices` (`std::vector<size_t>`): nearest first
+  inline std::vector<size_t> knnSearch(const math::vec3d_t& point,
+                                       const size_t k) const {
+    std::vector<size_t> indices;
+    std::vector<double> squaredDistances;
+    knnSearch(point, k, indices, squaredDistances);
+    return indices;
+  }
+
+  /// @brief Find the points within `radius` of `point` (inclusive)
+  /// @param point Query point in world coordinates
+  /// @param radius Radius in world units
+  /// @param indices Indices of the points, in no particular order
+  /// @return `nPoints` (`size_t`): number of found points
+  inline size_t radiusSearch(const math::vec3d_t& point,
+                             const double radius,
+                             std::vector<size_t>& indices) const {
+    indices.clear();
+
+    if (empty() || !(radius >= 0.0)) {
+      return 0;
+    }
+
+    _radiusSearch(0, _toRaw(point), radius * radius, indices);
+
+    return indices.size();
+  }
+
+  /// @brief Find the points within `radius` of `point` (inclusive)
+  /// @return `indices` (`std::vector<size_t>`): in no particular order
+  inline std::vector<size_t> radiusSearch(const math::vec3d_t& point,
+                                          const double radius) const {
+    std::vector<size_t> indices;
+    radiusSearch(point, radius, indices);
+    return indices;
+  }
+
+  /// @brief Find the points inside an axis-aligned box (inclusive)
+  /// @param minBound Minimum corner in world coordinates
+  /// @param maxBound Maximum corner in world coordinates
+  /// @param indices Indices of the points, in no particular order
+  /// @return `nPoints` (`size_t`): number of found points
+  inline size_t boxSearch(const math::vec3d_t& minBound,
+                          const math::vec3d_t& maxBound,
+                          std::vector<size_t>& indices) const {
+    indices.clear();
+
+    if (empty()) {
+      return 0;
+    }
+
+    PointFilter filter;
+    filter.setBoundingBox(minBound, maxBound);
+
+    const RawPointFilter rawFilter(filter, _header);
+    if (rawFilter.isEmpty) {
+      return 0;
+    }
+
+    const std::array<LLAS_LLONG, 3> rawMin = {rawFilter.minX, rawFilter.minY, rawFilter.minZ};
+    const std::array<LLAS_LLONG, 3> rawMax = {rawFilter.maxX, rawFilter.maxY, rawFilter.maxZ};
+    _boxSearch(0, rawMin, rawMax, indices);
+
+    return indices.size();
+  }
+
+  /// @brief Find the points inside an axis-aligned box (inclusive)
+  /// @return `indices` (`std::vector<size_t>`): in no particular order
+  inline std::vector<size_t> boxSearch(const math::vec3d_t& minBound,
+                                       const math::vec3d_t& maxBound) const {
+    std::vector<size_t> indices;
+    boxSearch(minBound, maxBound, indices);
+    return indices;
+  }
+
+ private:
+  struct IndexedPoint {
+    std::array<LLAS_LONG, 3> coords;
+    size_t index;
+  };
+
+  struct Node {
+    std::array<LLAS_LONG, 3> minBound;
+    std::array<LLAS_LONG, 3> maxBound;
+    size_t begin;
+    size_t end;
+    size_t right;  // Index of the right child. `0` for a leaf. The left child always follows its parent.
+  };
+
+  /// @brief Number of nodes of the tree over `nPoints` points
+  inline size_t _countNodes(const size_t nPoints) const {
+    if (nPoints <= _leafSize) {
+      return 1;
+    }
+    return 1 + _countNodes(nPoints / 2) + _countNodes(nPoints - nPoints / 2);
+  }
+
+  inline void _build(const size_t iNode,
+                     const size_t begin,
+                     const size_t end,
+                     const size_t parallelDepth) {
+    Node& node = _nodes[iNode];
+    node.begin = begin;
+    node.end = end;
+    node.right = 0;
+    node.minBound = {std::numeric_limits<LLAS_LONG>::max(), std::numeric_limits<LLAS_LONG>::max(), std::numeric_limits<LLAS_LONG>::max()};
+    node.maxBound = {std::numeric_limits<LLAS_LONG>::min(), std::numeric_limits<LLAS_LONG>::min(), std::numeric_limits<LLAS_LONG>::min()};
+
+    for (size_t iPoint = begin; iPoint < end; ++iPoint) {
+      for (int axis = 0; axis < 3; ++axis) {
+        node.minBound[axis] = std::min(node.minBound[axis], _points[iPoint].coords[axis]);
+        node.maxBound[axis] = std::max(node.maxBound[axis], _points[iPoint].coords[axis]);
+      }
+    }
+
+    if (end - begin <= _leafSize) {
+      return;
+    }
+
+    // NOTE: Split at the median of the axis with the largest extent in world units
+    const math::vec3d_t scale = {_header.xScaleFactor, _header.yScaleFactor, _header.zScaleFactor};
+    int splitAxis = 0;
+    double maxExtent = -1.0;
+    for (int axis = 0; axis < 3; ++axis) {
+      const double extent = ((double)node.maxBound[axis] - (double)node.minBound[axis]) * std::abs(scale[axis]);
+      if (extent > maxExtent) {
+        maxExtent = extent;
+        splitAxis = axis;
+      }
+    }
+
+    const size_t mid = begin + (end - begin) / 2;
+    std::nth_element(_points.begin() + begin, _points.begin() + mid, _points.begin() + end,
+                     [splitAxis](const IndexedPoint& a, const IndexedPoint& b) { return a.coords[splitAxis] < b.coords[splitAxis]; });
+
+    const size_t left = iNode + 1;
+    const size_t right = left + _countNodes(mid - begin);
+    node.right = right;
+
+    if (parallelDepth > 0 && end - begin >= LLAS_MIN_ITEMS_PER_THREAD) {
+      std::thread thread([&]() { _build(left, begin, mid, parallelDepth - 1); });
+      _build(right, mid, end, parallelDepth - 1);
+      thread.join();
+    } else {
+      _build(left, begin, mid, 0);
+      _build(right, mid, end, 0);
+    }
+  }
+
+  /// @brief Convert world coordinates into the (fractional) integer domain of the records
+  inline math::vec3d_t _toRaw(const math::vec3d_t& point) const {
+    return {(point[0] - _header.xOffset) / _header.xScaleFactor,
+            (point[1] - _header.yOffset) / _header.yScaleFactor,
+            (point[2] - _header.zOffset) / _header.zScaleFactor};
+  }
+
+  /// @brief Squared distance in world units between an indexed point and a query in the integer domain
+  inline double _squaredDistance(const IndexedPoint& point, const math::vec3d_t& query) const {
+    const double dx = ((double)point.coords[0] - query[0]) * _header.xScaleFactor;
+    const double dy = ((double)point.coords[1] - query[1]) * _header.yScaleFactor;
+    const double dz = ((double)point.coords[2] - query[2]) * _header.zScaleFactor;
+    return dx * dx + dy * dy + dz * dz;
+  }
+
+  /// @brief Squared distance in world units between the box of a node and a query in the integer domain
+  /// @param isFarthest Use the farthest corner of the box instead of the nearest point
+  inline double _squaredDistance(const Node& node, const math::vec3d_t& query, const bool isFarthest = false) const {
+    const math::vec3d_t scale = {_header.xScaleFactor, _header.yScaleFactor, _header.zScaleFactor};
+    double squaredDistance = 0.0;
+
+    for (int axis = 0; axis < 3; ++axis) {
+      const double lower = (double)node.minBound[axis] - query[axis];
+      const double upper = query[axis] - (double)node.maxBound[axis];
+      const double gap = isFarthest ? std::max(-lower, -upper) : std::max(0.0, std::max(lower, upper));
+      squaredDistance += gap * gap * scale[axis] * scale[axis];
+    }
+
+    return squaredDistance;
+  }
+
+  inline void _knnSearch(const size_t iNode,
+                         const math::vec3d_t& query,
+                         const size_t k,
+                         std::priority_queue<std::pair<double, size_t>>& candidates) const {
+    const Node& node = _nodes[iNode];
+
+    if (node.right == 0) {
+      for (size_t iPoint = node.begin; iPoint < node.end; ++iPoint) {
+        const double squaredDistance = _squaredDistance(_points[iPoint], query);
+
+        if (candidates.size() < k) {
+          candidates.emplace(squaredDistance, iPoint);
+        } else if (squaredDistance < candidates.top().first) {
+          candidates.pop();
+          candidates.emplace(squaredDistance, iPoint);
+        }
+      }
+      return;
+    }
+
+    // NOTE: Visit the nearer child first so that the farther one is more likely to be pruned
+    size_t nearChild = iNode + 1;
+    size_t farChild = node.right;
+    double nearDistance = _squaredDistance(_nodes[nearChild], query);
+    double farDistance = _squaredDistance(_nodes[farChild], query);
+    if (farDistance < nearDistance) {
+      std::swap(nearChild, farChild);
+      std::swap(nearDistance, farDistance);
+    }
+
+    if (candidates.size() < k || nearDistance < candidates.top().first) {
+      _knnSearch(nearChild, query, k, candidates);
+    }
+    if (candidates.size() < k || farDistance < candidates.top().first) {
+      _knnSearch(farChild, query, k, candidates);
+    }
+  }
+
+  inline void _radiusSearch(const size_t iNode,
+                            const math::vec3d_t& query,
+                            const double squaredRadius,
+                            std::vector<size_t>& indices) const {
+    const Node& node = _nodes[iNode];
+
+    if (_squaredDistance(node, query) > squaredRadius) {
+      return;
+    }
+
+    if (_squaredDistance(node, query, true) <= squaredRadius) {
+      // NOTE: The whole node is inside the sphere
+      _appendAll(node, indices);
+      return;
+    }
+
+    if (node.right == 0) {
+      for (size_t iPoint = node.begin; iPoint < node.end; ++iPoint) {
+        if (_squaredDistance(_points[iPoint], query) <= squaredRadius) {
+          indices.push_back(_points[iPoint].index);
+        }
+      }
+      return;
+    }
+
+    _radiusSearch(iNode + 1, query, squaredRadius, indices);
+    _radiusSearch(node.right, query, squaredRadius, indices);
+  }
+
+  inline void _boxSearch(const size_t iNode,
+                         const std::array<LLAS_LLONG, 3>& rawMin,
+                         const std::array<LLAS_LLONG, 3>& rawMax,
+                         std::vector<size_t>& indices) const {
+    const Node& node = _nodes[iNode];
+
+    bool isInside = true;
+    for (int axis = 0; axis < 3; ++axis) {
+      if (node.maxBound[axis] < rawMin[axis] || rawMax[axis] < node.minBound[axis]) {
+        return;
+      }
+      isInside = isInside && rawMin[axis] <= node.minBound[axis] && node.maxBound[axis] <= rawMax[axis];
+    }
+
+    if (isInside) {
+      _appendAll(node, indices);
+      return;
+    }
+
+    if (node.right == 0) {
+      for (size_t iPoint = node.begin; iPoint < node.end; ++iPoint) {
+        const std::array<LLAS_LONG, 3>& coords = _points[iPoint].coords;
+        if (rawMin[0] <= coords[0] && coords[0] <= rawMax[0] &&
+            rawMin[1] <= coords[1] && coords[1] <= rawMax[1] &&
+            rawMin[2] <= coords[2] && coords[2] <= rawMax[2]) {
+          indices.push_back(_points[iPoint].index);
+        }
+      }
+      return;
+    }
+
+    _boxSearch(iNode + 1, rawMin, rawMax, indices);
+    _boxSearch(node.right, rawMin, rawMax, indices);
+  }
+
+  inline void _appendAll(const Node& node, std::vector<size_t>& indices) const {
+    for (size_t iPoint = node.begin; iPoint < node.end; ++iPoint) {
+      indices.push_back(_points[iPoint].index);
+    }
+  }
+
+  PublicHeader _header;
+  size_t _leafSize;
+  std::vector<IndexedPoint> _points;
+  std::vector<Node> _nodes;
+};
+
+// ==========================================================================
+// Functions
+// ==========================================================================
+
+LLAS_FUNC_DECL_PREFIX LasData_ptr read(const std::string& filePath,
+                                       const ReadOptions& options);
+
+LLAS_FUNC_DECL_PREFIX LasData_ptr read(const std::string& filePath,
+                                       const bool pointDataOnly = true);
+
+/// @brief Read '.las' format file
+/// @param filePath Path to the las file
+/// @param pointDataOnly Read only "PointDataRecords"
+/// @return `Las data` (`LasData_ptr`): Las content
+LLAS_FUNC_DECL_PREFIX LasData_ptr read(const std::string& filePath,
+                                       const bool pointDataOnly) {
+  ReadOptions options;
+  options.pointDataOnly = pointDataOnly;
+  return read(filePath, options);
+}
+
+/// @brief Get the ranges of records near the bounding box of `filter` from the sidecar index, if it is enabled and up to date
+/// @param readRecord Reads the records of the file to check that the index is up to date
+/// @param filePath Path of the las file whose sidecar index is read if `sidecarIndex` is `nullptr`, and whose modification time is checked.
+///                 No index is read if empty.
+/// @param sidecarIndex Index to use instead of reading it, if not `nullptr`
+/// @return `Ranges` (`std::vector<RecordRange>`): all the records if no index is used
+LLAS_FUNC_DECL_PREFIX std::vector<RecordRange> _getSidecarRecordRanges(const PublicHeader& publicHeader,
+                                                                       const LLAS_ULLONG fileSize,
+                                                                       const RawPointFilter& filter,
+                                                                       const ReadOptions& options,
+                                                                       const SidecarIndex::ReadRecordFunction& readRecord,
+                                                                       const std::string& filePath,
+                                                                       const SidecarIndex* sidecarIndex) {
+  std::vector<RecordRange> ranges = {{0, publicHeader.getNumPointRecords()}};
+  if (!options.useSidecarIndex || !filter.hasBoundingBox || filter.isEmpty || (sidecarIndex == nullptr && filePath.empty())) {
+    return ranges;
+  }
+
+  SidecarIndex fileSidecarIndex;
+  if (sidecarIndex == nullptr) {
+    if (!fileSidecarIndex.read(SidecarIndex::getPath(filePath))) {
+      return ranges;
+    }
+    sidecarIndex = &fileSidecarIndex;
+  }
+
+  // NOTE: The modification time is unknown without a path, then only the records are compared
+  io::FileStamp fileStamp;
+  if (!filePath.empty() && !io::getFileStamp(filePath, fileStamp)) {
+    return ranges;
+  }
+
+  if (sidecarIndex->isValidFor(publicHeader, fileSize, readRecord, fileStamp.modificationTime)) {
+    ranges = sidecarIndex->getRecordRanges(filter);
+    _LLAS_logInfo("nRecordRanges: " + std::to_string(ranges.size()));
+  } else {
+    _LLAS_logInfo("Ignore outdated sidecar index: " + (filePath.empty() ? std::string("byte source") : SidecarIndex::getPath(filePath)));
+  }
+  return ranges;
+}
+
+/// @brief Set up the progress of decoding with the callback and the cancellation token of `options`
+/// @param nProgressRecords Total number of records passed to the callback, which may be set later
+/// @return `progress` (`DecodeProgress*`): `nullptr` if there is neither a callback nor a kept copy of the token, then records are decoded in one step
+LLAS_FUNC_DECL_PREFIX DecodeProgress* _getDecodeProgress(const ReadOptions& options,
+                                                         const LLAS_ULLONG& nProgressRecords,
+                                                         DecodeProgress& progress) {
+  // NOTE: Checked before the token is copied into `progress`
+  const bool isCancellable = options.cancellationToken.isShared();
+
+  if (options.progressCallback) {
+    progress.callback = [&options, &nProgressRecords](const size_t nDecodedRecords) { options.progressCallback(nDecodedRecords, nProgressRecords); };
+  }
+  progress.cancellationToken = options.cancellationToken;
+
+  return options.progressCallback || isCancellable ? &progress : nullptr;
+}
+
+/// @brief Subsample the records of `ranges` and decode them into `lasData` in `options.layout`
+/// @param byteData Bytes starting at the beginning of the record `0`
+/// @param progress Progress of decoding, if reported or cancellable (`_getDecodeProgress`)
+/// @param nProgressRecords Total number of records reported to the progress callback.
+///                         Set to the number of decoded records if `0`, otherwise decoding is not reported.
+LLAS_FUNC_DECL_PREFIX void _decodeRecordRanges(const char* byteData,
+                                               std::vector<RecordRange> ranges,
+                                               const RawPointFilter& filter,
+                                               const ReadOptions& options,
+                                               DecodeProgress* progress,
+                                               LLAS_ULLONG& nProgressRecords,
+                                               ReadStats& stats,
+                                               LasData& lasData) {
+  const PublicHeader& publicHeader = lasData.header;
+  const LLAS_USHORT recordLength = publicHeader.pointDataRecordLength;
+  const LLAS_UCHAR format = publicHeader.pointDataRecordFormat;
+  lasData.layout = options.layout;
+  lasData.fields = options.fields;
+
+  // NOTE: Records selected by a stride are decoded as virtual records spanning `stride` records, so no range per record is built
+  LLAS_USHORT decodeRecordLength = recordLength;
+  if (options.subsampling.mode == SubsamplingMode::Stride && _getStridedRanges(ranges, options.subsampling.stride, recordLength, ranges, decodeRecordLength)) {
+    _LLAS_logInfo("nSubsampledRecords: " + std::to_string(_getRangeFirsts(ranges).back()));
+  } else if (options.subsampling.isEnabled()) {
+    ranges = subsamplePointDataRecords(byteData, ranges, recordLength, format, filter, options.subsampling, publicHeader, options.numThreads);
+    _LLAS_logInfo("nSubsampledRecords: " + std::to_string(_getRangeFirsts(ranges).back()));
+  }
+
+  stats.nDecodedRecords = _getRangeFirsts(ranges).back();
+  if (nProgressRecords == 0) {
+    nProgressRecords = stats.nDecodedRecords;
+  } else if (progress != nullptr) {
+    progress->callback = nullptr;
+  }
+
+  if (options.layout == PointDataLayout::StructOfArrays) {
+    decodePointDataRecords(byteData, ranges, decodeRecordLength, format, options.fields, filter, options.numThreads, lasData.pointDataColumns, progress);
+  } else if (options.layout == PointDataLayout::Packed) {
+    decodePointDataRecords(byteData, ranges, decodeRecordLength, format, filter, options.numThreads, lasData.packedPointData, progress);
+  } else {
+    decodePointDataRecords(byteData, ranges, decodeRecordLength, format, options.fields, filter, options.numThreads, lasData.pointDataRecords, progress);
+  }
+  stats.nPoints = lasData.getNumPoints();
+}
+
+/// @brief Read '.las' format data which is already in memory
+/// @param fileData Bytes of the whole file
+/// @param fileSize Number of bytes of `fileData`
+/// @param options Read options
+/// @param filePath Path of the file of `fileData` for messages and the sidecar index. The sidecar index is not used if empty.
+/// @param stats Output durations of the phases after opening the file, and the numbers of decoded records and points
+/// @param sidecarIndex Sidecar index to use instead of the one next to `filePath`, if not `nullptr`
+/// @return `Las data` (`LasData_ptr`): Las content
+LLAS_FUNC_DECL_PREFIX LasData_ptr read(const char* fileData,
+                                       const size_t fileSize,
+                                       const ReadOptions& options,
+                                       const std::string& filePath,
+                                       ReadStats& stats,
+                                       const SidecarIndex* sidecarIndex = nullptr) {
+  const bool pointDataOnly = options.pointDataOnly;
+
+  bool isOK = true;
+
+  Stopwatch stopwatch;
+
+  if (fileSize < (size_t)PublicHeader::MIN_HEADER_SIZE) {
+    _LLAS_logError("File is too small to contain a public header: " + filePath);
+    return nullptr;  // return nullptr
+  }
+
+  // NOTE: Every section is decoded in place into the output object to avoid copies of large vectors
+  LasData_ptr lasData = std::make_shared<LasData>();
+
+  // ======================================================================================================================
+  // Read 'Public Header'
+  // ======================================================================================================================
+  lasData->header = PublicHeader::readPublicHeader(fileData);
+  const PublicHeader& publicHeader = lasData->header;
+
+  // NOTE: The points of LAZ files are returned decompressed in their actual format
+  const bool isCompressed = publicHeader.isCompressed();
+  lasData->header.pointDataRecordFormat &= 0x3F;
+
+  _LLAS_logInfo("version: " + std::to_string(publicHeader.versionMajor) + "." + std::to_string(publicHeader.versionMinor));
+
+  const LLAS_UCHAR format = publicHeader.pointDataRecordFormat;
+  _LLAS_logInfo("format: " + std::to_string(format));
+
+  if (format < 0 || 10 < format) {
+    // NOTE: Format is defined from 0 to 10
+    _LLAS_logError("Invalid point data record format:  " + std::to_string(format));
+    return nullptr;  // return nullptr
+  }
+
+  stats.headerTime = stopwatch.lap();
+
+  // ======================================================================================================================
+  // Read 'Variable Length Records'
+  // ======================================================================================================================
+
+  if ((size_t)publicHeader.offsetToPointData > fileSize) {
+    _LLAS_logError("Variable Length Records exceed the end of file: " + filePath);
+    return nullptr;  // return nullptr
+  }
+
+  // NOTE: LAZ files need the 'laszip encoded' VLR
+  std::vector<VariableLengthRecord> variableLengthRecords;
+  {
+    if (!pointDataOnly || isCompressed) {
+      isOK = readVariableLengthRecords(fileData, fileSize, publicHeader, variableLengthRecords) && isOK;
+    }
+  }
+
+  stats.variableLengthRecordsTime = stopwatch.lap();
+
+  if (options.cancellationToken.isCancelled()) {
+    _LLAS_logInfo("Reading was cancelled: " + filePath);
+    return nullptr;  // return nullptr
+  }
+
+  // ======================================================================================================================
+  // Read 'Point Data Records'
+  // ======================================================================================================================
+
+  {
+    const LLAS_ULLONG nPointRecords = publicHeader.getNumPointRecords();
+    _LLAS_logInfo("nPointRecords: " + std::to_string(nPointRecords));
+
+    if (!isCompressed && (LLAS_ULLONG)publicHeader.offsetToPointData + nPointRecords * publicHeader.pointDataRecordLength > fileSize) {
+      _LLAS_logError("Point Data Records exceed the end of file: " + filePath);
+      return nullptr;  // return nullptr
+    }
+
+    if (publicHeader.pointDataRecordLength < PointDataRecord::getFormatSize(format)) {
+      _LLAS_logError("Point data record length is shorter than the point data record format: " + std::to_string(publicHeader.pointDataRecordLength));
+      return nullptr;  // return nullptr
+    }
+
+    const char* byteData = fileData + publicHeader.offsetToPointData;
+
+    // NOTE: The records of LAZ files are counted while they are decompressed, which takes most of the time
+    DecodeProgress progress;
+    LLAS_ULLONG nProgressRecords = 0;
+    DecodeProgress* decodeProgress = _getDecodeProgress(options, nProgressRecords, progress);
+
+    std::vector<char> decompressedBytes;
+    if (isCompressed) {
+      nProgressRecords = nPointRecords;
+      if (!laz::decompressPointDataRecords(fileData, fileSize, publicHeader, variableLengthRecords, options.numThreads, decompressedBytes, decodeProgress)) {
+        if (progress.isCancelled()) {
+          _LLAS_logInfo("Reading was cancelled: " + filePath);
+          return nullptr;  // return nullptr
+        }
+        _LLAS_logError("Failed to decompress LAZ file: " + filePath);
+        return nullptr;  // return nullptr
+      }
+      byteData = decompressedBytes.data();
+
+      // NOTE: The compression VLR does not describe the decompressed points
+      variableLengthRecords.erase(std::remove_if(variableLengthRecords.begin(), variableLengthRecords.end(), laz::LasZip::isLasZipVLR), variableLengthRecords.end());
+    }
+    const RawPointFilter filter(options.filter, publicHeader);
+    const auto readRecord = [&](const LLAS_ULLONG iRecord, char* recordData) {
+      std::memcpy(recordData, byteData + iRecord * publicHeader.pointDataRecordLength, publicHeader.pointDataRecordLength);
+      return true;
+    };
+    const std::vector<RecordRange> ranges = _getSidecarRecordRanges(publicHeader, fileSize, filter, options, readRecord, filePath, sidecarIndex);
+    _decodeRecordRanges(byteData, ranges, filter, options, decodeProgress, nProgressRecords, stats, *lasData);
+
+    if (progress.isCancelled()) {
+      _LLAS_logInfo("Reading was cancelled: " + filePath);
+      return nullptr;  // return nullptr
+    }
+
+    if (options.progressCallback) {
+      options.progressCallback(nProgressRecords, nProgressRecords);
+    }
+
+    if (filter.isEnabled) {
+      _LLAS_logInfo("nFilteredPoints: " + std::to_string(lasData->getNumPoints()));
+    }
+  }
+
+  stats.pointDataRecordsTime = stopwatch.lap();
+
+  // ======================================================================================================================
+  // Read 'Extended Variable Length Records'
+  // ======================================================================================================================
+
+  {
+    // version >= 1.4
+    if (!pointDataOnly && publicHeader.hasStartOfFirstExtendedVariableLengthRecord && publicHeader.hasNumOfExtendedVariableLengthRecords) {
+      // NOTE: Move to the starting point of EVLR
+      const std::streamsize offset = publicHeader.startOfFirstExtendedVariableLengthRecord;
+
+      isOK = readExtendedVariableLengthRecords(fileData, fileSize, offset, publicHeader, lasData->extendedVariableLengthRecord) && isOK;
+    }
+  }
+
+  stats.extendedVariableLengthRecordsTime = stopwatch.lap();
+
+  // ======================================================================================================================
+  // Create output object
+  // ======================================================================================================================
+  if (!pointDataOnly) {
+    lasData->variableLengthRecords = std::move(variableLengthRecords);
+  }
+
+  if (!isOK) {
+    lasData = nullptr;
+  }
+
+  stats.assembleTime = stopwatch.lap();
+
+  return lasData;
+};
+
+/// @brief Read '.las' format data which is already in memory
+/// @param fileData Bytes of the whole file
+/// @param fileSize Number of bytes of `fileData`
+/// @param options Read options
+/// @param filePath Path of the file of `fileData` for messages and the sidecar index. The sidecar index is not used if empty.
+/// @return `Las data` (`LasData_ptr`): Las content
+LLAS_FUNC_DECL_PREFIX LasData_ptr read(const char* fileData,
+                                       const size_t fileSize,
+                                       const ReadOptions& options,
+                                       const std::string& filePath = "") {
+  ReadStats stats;
+  return read(fileData, fileSize, options, filePath, stats);
+};
+
+/// @brief Read '.las' format file
+/// @param filePath Path to the las file
+/// @param options Read options
+/// @param stats Output durations of the phases and the amount of data read
+/// @return `Las data` (`LasData_ptr`): Las content
+LLAS_FUNC_DECL_PREFIX LasData_ptr read(const std::string& filePath,
+                                       const ReadOptions& options,
+                                       ReadStats& stats) {
+#if defined(LLAS_PRINT_BYTES)
+  _LLAS_logDebug("LLAS_CHAR   = " + std::to_string(sizeof(LLAS_CHAR)));
+  _LLAS_logDebug("LLAS_SCHAR  = " + std::to_string(sizeof(LLAS_SCHAR)));
+  _LLAS_logDebug("LLAS_UCHAR  = " + std::to_string(sizeof(LLAS_UCHAR)));
+  _LLAS_logDebug("LLAS_SHORT  = " + std::to_string(sizeof(LLAS_SHORT)));
+  _LLAS_logDebug("LLAS_USHORT = " + std::to_string(sizeof(LLAS_USHORT)));
+  _LLAS_logDebug("LLAS_LONG   = " + std::to_string(sizeof(LLAS_LONG)));
+  _LLAS_logDebug("LLAS_ULONG  = " + std::to_string(sizeof(LLAS_ULONG)));
+  _LLAS_logDebug("LLAS_LLONG  = " + std::to_string(sizeof(LLAS_LLONG)));
+  _LLAS_logDebug("LLAS_ULLONG = " + std::to_string(sizeof(LLAS_ULLONG)));
+  _LLAS_logDebug("LLAS_FLOAT  = " + std::to_string(sizeof(LLAS_FLOAT)));
+  _LLAS_logDebug("LLAS_DOUBLE = " + std::to_string(sizeof(LLAS_DOUBLE)));
+  _LLAS_logDebug("LLAS_STRING = " + std::to_string(sizeof(LLAS_STRING)));
+#endif
+
+#if defined(LLAS_CHECK_BYTE_SIZE)
+  if (sizeof(LLAS_CHAR) != 1) {
+    _LLAS_logError("Byte size check failed: LLAS_CHAR");
+    return nullptr;
+  }
+  if (sizeof(LLAS_SCHAR) != 1) {
+    _LLAS_logError("Byte size check failed: LLAS_SCHAR");
+    return nullptr;
+  }
+  if (sizeof(LLAS_UCHAR) != 1) {
+    _LLAS_logError("Byte size check failed: LLAS_UCHAR");
+    return nullptr;
+  }
+  if (sizeof(LLAS_SHORT) != 2) {
+    _LLAS_logError("Byte size check failed: LLAS_SHORT");
+    return nullptr;
+  }
+  if (sizeof(LLAS_USHORT) != 2) {
+    _LLAS_logError("Byte size check failed: LLAS_USHORT");
+    return nullptr;
+  }
+  if (sizeof(LLAS_LONG) != 4) {
+    _LLAS_logError("Byte size check failed: LLAS_LONG");
+    return nullptr;
+  }
+  if (sizeof(LLAS_ULONG) != 4) {
+    _LLAS_logError("Byte size check failed: LLAS_ULONG");
+    return nullptr;
+  }
+  if (sizeof(LLAS_LLONG) != 8) {
+    _LLAS_logError("Byte size check failed: LLAS_LLONG");
+    return nullptr;
+  }
+  if (sizeof(LLAS_ULLONG) != 8) {
+    _LLAS_logError("Byte size check failed: LLAS_ULLONG");
+    return nullptr;
+  }
+  if (sizeof(LLAS_FLOAT) != 4) {
+    _LLAS_logError("Byte size check failed: LLAS_FLOAT");
+    return nullptr;
+  }
+  if (sizeof(LLAS_DOUBLE) != 8) {
+    _LLAS_logError("Byte size check failed: LLAS_DOUBLE");
+    return nullptr;
+  }
+#endif
+
+  stats = ReadStats();
+  Stopwatch stopwatch;
+  Stopwatch totalStopwatch;
+
+  _LLAS_logInfo("Start reading file: " + filePath);
+
+  // ======================================================================================================================
+  // Open file
+  // ======================================================================================================================
+  io::MappedFile mappedFile;
+  std::vector<char> fileBytes;
+  const char* fileData = nullptr;
+  size_t fileSize = 0;
+  {
+    if (options.useMemoryMap && mappedFile.open(filePath)) {
+      fileData = mappedFile.data();
+      fileSize = mappedFile.size();
+      stats.openTime = stopwatch.lap();
+    } else {
+      if (options.useMemoryMap) {
+        _LLAS_logDebug("Failed to map file, fall back to buffered read: " + filePath);
+      }
+      stats.openTime = stopwatch.lap();
+
+      if (!io::readFileBytes(filePath, fileBytes)) {
+        _LLAS_logError("Failed to open file: " + filePath);
+        return nullptr;  // return nullptr
+      }
+
+      fileData = fileBytes.data();
+      fileSize = fileBytes.size();
+      stats.readBytesTime = stopwatch.lap();
+    }
+  }
+  stats.nBytesRead = fileSize;
+
+  LasData_ptr lasData = read(fileData, fileSize, options, filePath, stats);
+
+  stats.totalTime = totalStopwatch.lap();
+
+#if defined(LLAS_MEASURE_TIME)
+  _LLAS_logInfo("Elapsed time: " + std::to_string(stats.totalTime) + " [sec]" +
+                " (open: " + std::to_string(stats.openTime) +
+                ", read bytes: " + std::to_string(stats.readBytesTime) +
+                ", header: " + std::to_string(stats.headerTime) +
+                ", VLRs: " + std::to_string(stats.variableLengthRecordsTime) +
+                ", points: " + std::to_string(stats.pointDataRecordsTime) +
+                ", EVLRs: " + std::to_string(stats.extendedVariableLengthRecordsTime) +
+                ", assemble: " + std::to_string(stats.assembleTime) + ")");
+#endif
+
+  return lasData;
+};
+
+/// @brief Read '.las' format file
+/// @param filePath Path to the las file
+/// @param options Read options
+/// @return `Las data` (`LasData_ptr`): Las content
+LLAS_FUNC_DECL_PREFIX LasData_ptr read(const std::string& filePath,
+                                       const ReadOptions& options) {
+  ReadStats stats;
+  return read(filePath, options, stats);
+};
+
+/// @brief Read '.las' format file from a byte source, e.g. object storage through `io::RangeReadByteSource`.
+///        Only the public header, the VLRs (unless `options.pointDataOnly`), the EVLRs and the spans of 'Point Data Records'
+///        which may be decoded are fetched, in up to `options.numConcurrentRequests` concurrent reads.
+///        Spans are narrowed by `sidecarIndex` for bounding box filters, and by stride or random (without attribute filters) subsampling.
+///        Sources whose bytes are in memory are parsed in place. LAZ files are fetched whole since their chunk table lies at the end.
+/// @param source Bytes of the las file
+/// @param options Read options
+/// @param stats Output durations of the phases and the number of bytes fetched (`nBytesRead`)
+/// @param sidecarIndex Sidecar index of the file (e.g. fetched with `SidecarIndex::read(const io::ByteSource&)`), if not `nullptr`
+/// @return `Las data` (`LasData_ptr`): Las content
+LLAS_FUNC_DECL_PREFIX LasData_ptr read(const io::ByteSource& source,
+                                       const ReadOptions& options,
+                                       ReadStats& stats,
+                                       const SidecarIndex* sidecarIndex = nullptr) {
+  stats = ReadStats();
+  Stopwatch stopwatch;
+  Stopwatch totalStopwatch;
+
+  const LLAS_ULLONG fileSize = source.size();
+  if (fileSize < (LLAS_ULLONG)PublicHeader::MIN_HEADER_SIZE) {
+    _LLAS_logError("Byte source is too small to contain a public header");
+    return nullptr;  // return nullptr
+  }
+
+  // NOTE: Bytes which are in memory are parsed in place
+  if (source.data() != nullptr) {
+    stats.nBytesRead = fileSize;
+    LasData_ptr lasData = read(source.data(), (size_t)fileSize, options, "", stats, sidecarIndex);
+    stats.totalTime = totalStopwatch.lap();
+    return lasData;
+  }
+
+  // ======================================================================================================================
+  // Read 'Public Header'
+  // ======================================================================================================================
+  LasData_ptr lasData = std::make_shared<LasData>();
+  {
+    // NOTE: 375 bytes is the size of the largest public header (v1.4)
+    std::vector<char> headerBytes(PublicHeader::HEADER_SIZE_V14, 0);
+    const size_t nHeaderBytes = (size_t)std::min<LLAS_ULLONG>(fileSize, headerBytes.size());
+    if (!source.read(0, nHeaderBytes, headerBytes.data())) {
+      _LLAS_logError("Failed to read the public header");
+      return nullptr;  // return nullptr
+    }
+    stats.nBytesRead += nHeaderBytes;
+
+    lasData->header = PublicHeader::readPublicHeader(headerBytes);
+  }
+  const PublicHeader& publicHeader = lasData->header;
+
+  // NOTE: LAZ chunks are located through the chunk table, so the whole file is fetched and decompressed in memory
+  if (publicHeader.isCompressed()) {
+    std::vector<char> fileBytes;
+    if (!source.readBytes(0, (size_t)fileSize, fileBytes)) {
+      _LLAS_logError("Failed to read LAZ file from byte source");
+      return nullptr;  // return nullptr
+    }
+    stats.readBytesTime = stopwatch.lap();
+
+    ReadStats fileStats;
+    lasData = read(fileBytes.data(), fileBytes.size(), options, "", fileStats, sidecarIndex);
+    fileStats.readBytesTime = stats.readBytesTime;
+    fileStats.nBytesRead = fileSize;
+    stats = fileStats;
+    stats.totalTime = totalStopwatch.lap();
+    return lasData;
+  }
+
+  const LLAS_UCHAR format = publicHeader.pointDataRecordFormat;
+  if (format < 0 || 10 < format) {
+    // NOTE: Format is defined from 0 to 10
+    _LLAS_logError("Invalid point data record format:  " + std::to_string(format));
+    return nullptr;  // return nullptr
+  }
+
+  const LLAS_ULLONG nPointRecords = publicHeader.getNumPointRecords();
+  const LLAS_USHORT recordLength = publicHeader.pointDataRecordLength;
+  if ((LLAS_ULLONG)publicHeader.offsetToPointData + nPointRecords * recordLength > fileSize) {
+    _LLAS_logError("Point Data Records exceed the end of file");
+    return nullptr;  // return nullptr
+  }
+
+  if (recordLength < PointDataRecord::getFormatSize(format)) {
+    _LLAS_logError("Point data record length is shorter than the point data record format: " + std::to_string(recordLength));
+    return nullptr;  // return nullptr
+  }
+
+  stats.headerTime = stopwatch.lap();
+
+  // ======================================================================================================================
+  // Read 'Variable Length Records'
+  // ======================================================================================================================
+  if (!options.pointDataOnly) {
+    std::vector<char> bytes;
+    if (!source.readBytes(0, publicHeader.offsetToPointData, bytes) ||
+        !readVariableLengthRecords(bytes.data(), bytes.size(), publicHeader, lasData->variableLengthRecords)) {
+      _LLAS_logError("Failed to read Variable Length Records");
+      return nullptr;  // return nullptr
+    }
+    stats.nBytesRead += bytes.size();
+  }
+
+  stats.variableLengthRecordsTime = stopwatch.lap();
+
+  if (options.cancellationToken.isCancelled()) {
+    _LLAS_logInfo("Reading was cancelled");
+    return nullptr;  // return nullptr
+  }
+
+  // ======================================================================================================================
+  // Read 'Point Data Records'
+  // ======================================================================================================================
+  {
+    const RawPointFilter filter(options.filter, publicHeader);
+    const auto readRecord = [&](const LLAS_ULLONG iRecord, char* recordData) {
+      return source.read(publicHeader.offsetToPointData + iRecord * recordLength, recordLength, recordData);
+    };
+    std::vector<RecordRange> ranges = _getSidecarRecordRanges(publicHeader, fileSize, filter, options, readRecord, "", sidecarIndex);
+
+    // NOTE: Stride and unfiltered random subsampling select records without their bytes, so only the selected records are fetched.
+    //       Records selected by a stride are fetched from the first to the last selected one of every range and stay selected in the buffer
+    //       (`spanAlignment`), where they are decoded strided.
+    ReadOptions decodeOptions = options;
+    const SubsamplingMode mode = options.subsampling.mode;
+    size_t spanAlignment = 1;  // Positions of the spans in the buffer are multiples of it
+    std::vector<RecordRange> stridedRanges;
+    LLAS_USHORT stridedRecordLength = 0;
+    if (mode == SubsamplingMode::Stride && _getStridedRanges(ranges, options.subsampling.stride, recordLength, stridedRanges, stridedRecordLength)) {
+      spanAlignment = std::max<size_t>(1, options.subsampling.stride);
+      ranges.clear();
+      for (const RecordRange& stridedRange : stridedRanges) {
+        ranges.push_back({stridedRange.begin * spanAlignment, (stridedRange.end - 1) * spanAlignment + 1});
+      }
+    } else if (mode == SubsamplingMode::Stride || (mode == SubsamplingMode::Random && !filter.isEnabled)) {
+      ranges = subsamplePointDataRecords(nullptr, ranges, recordLength, format, filter, options.subsampling, publicHeader, options.numThreads);
+      _LLAS_logInfo("nSubsampledRecords: " + std::to_string(_getRangeFirsts(ranges).back()));
+      decodeOptions.subsampling = PointSubsampling();
+    }
+
+    // NOTE: Ranges with small gaps are fetched as one span, and long spans are split into requests fetched concurrently
+    struct Request {
+      LLAS_ULLONG fileOffset;
+      size_t nBytes;
+      size_t bufferOffset;
+    };
+
+    std::vector<RecordRange> spans;
+    for (const RecordRange& range : ranges) {
+      if (range.begin >= range.end) {
+        continue;
+      }
+      if (!spans.empty() && (range.begin - spans.back().end) * recordLength <= io::ByteSource::MAX_REQUEST_GAP) {
+        spans.back().end = range.end;
+      } else {
+        spans.push_back(range);
+      }
+    }
+
+    std::vector<Request> requests;
+    std::vector<size_t> spanFirsts(spans.size(), 0);  // Position of the first record of every span in the buffer
+    size_t nBufferBytes = 0;
+    size_t nFetchedBytes = 0;
+    for (size_t iSpan = 0; iSpan < spans.size(); ++iSpan) {
+      spanFirsts[iSpan] = (nBufferBytes / recordLength + spanAlignment - 1) / spanAlignment * spanAlignment;
+      nBufferBytes = spanFirsts[iSpan] * recordLength;
+
+      const LLAS_ULLONG spanOffset = publicHeader.offsetToPointData + spans[iSpan].begin * recordLength;
+      const size_t nSpanBytes = (size_t)((spans[iSpan].end - spans[iSpan].begin) * recordLength);
+      for (size_t offset = 0; offset < nSpanBytes; offset += io::ByteSource::MAX_REQUEST_SIZE) {
+        requests.push_back({spanOffset + offset, std::min(io::ByteSource::MAX_REQUEST_SIZE, nSpanBytes - offset), nBufferBytes + offset});
+      }
+      nBufferBytes += nSpanBytes;
+      nFetchedBytes += nSpanBytes;
+    }
+
+    std::vector<char> buffer(nBufferBytes);
+    std::vector<char> isRequestOK(requests.size(), 1);
+    parallelFor(requests.size(), std::max<size_t>(1, options.numConcurrentRequests), [&](const size_t begin, const size_t end) {
+      for (size_t iRequest = begin; iRequest < end; ++iRequest) {
+        if (options.cancellationToken.isCancelled()) {
+          return;
+        }
+        const Request& request = requests[iRequest];
+        isRequestOK[iRequest] = source.read(request.fileOffset, request.nBytes, buffer.data() + request.bufferOffset);
+      }
+    }, 1);
+    stats.nBytesRead += nFetchedBytes;
+    stats.readBytesTime = stopwatch.lap();
+
+    if (options.cancellationToken.isCancelled()) {
+      _LLAS_logInfo("Reading was cancelled");
+      return nullptr;  // return nullptr
     }
 
-    {
-      // Z
-      const std::streamsize nBytes = PointDataRecord::NUM_BYTES_Z;
-      std::memcpy(&pointDataRecord.z, byteData + offset, nBytes);
-      offset += nBytes;
+    if (std::find(isRequestOK.begin(), isRequestOK.end(), 0) != isRequestOK.end()) {
+      _LLAS_logError("Failed to read Point Data Records");
+      return nullptr;  // return nullptr
     }
+    _LLAS_logInfo("nRequests: " + std::to_string(requests.size()) + ", nBytes: " + std::to_string(nFetchedBytes));
 
-    {
-      // Intensity
-      const std::streamsize nBytes = PointDataRecord::NUM_BYTES_INTENSITY;
-      std::memcpy(&pointDataRecord.intensity, byteData + offset, nBytes);
-      offset += nBytes;
+    // NOTE: The ranges are renumbered into the records of the buffer
+    size_t iSpan = 0;
+    for (RecordRange& range : ranges) {
+      while (iSpan < spans.size() && spans[iSpan].end < range.end) {
+        ++iSpan;
+      }
+      if (iSpan == spans.size() || range.begin >= range.end) {
+        range = {0, 0};
+        continue;
+      }
+      const LLAS_ULLONG nRangeRecords = range.end - range.begin;
+      range.begin = spanFirsts[iSpan] + (range.begin - spans[iSpan].begin);
+      range.end = range.begin + nRangeRecords;
     }
 
-    {
-      // Sensor Data
-      const std::streamsize nBytes = PointDataRecord::NUM_BYTES_SENSOR_DATA;
-      // TODO: set variables
-      offset += nBytes;
-    }
+    DecodeProgress progress;
+    LLAS_ULLONG nProgressRecords = 0;
+    DecodeProgress* decodeProgress = _getDecodeProgress(options, nProgressRecords, progress);
 
-    {
-      // Classification
-      const std::streamsize nBytes = PointDataRecord::NUM_BYTES_CLASSIFICATION;
-      std::memcpy(&pointDataRecord.classification, byteData + offset, nBytes);
-      offset += nBytes;
+    _decodeRecordRanges(buffer.data(), ranges, filter, decodeOptions, decodeProgress, nProgressRecords, stats, *lasData);
+
+    if (progress.isCancelled()) {
+      _LLAS_logInfo("Reading was cancelled");
+      return nullptr;  // return nullptr
     }
 
-    {
-      // Scan Angle Rank
-      const std::streamsize nBytes = PointDataRecord::NUM_BYTES_SCAN_ANGLE_RANK;
-      std::memcpy(&pointDataRecord.scanAngleRank, byteData + offset, nBytes);
-      offset += nBytes;
+    if (options.progressCallback) {
+      options.progressCallback(nProgressRecords, nProgressRecords);
     }
+  }
 
-    {
-      // User Data
-      const std::streamsize nBytes = PointDataRecord::NUM_BYTES_USER_DATA;
-      std::memcpy(&pointDataRecord.userData, byteData + offset, nBytes);
-      offset += nBytes;
+  stats.pointDataRecordsTime = stopwatch.lap();
+
+  // ======================================================================================================================
+  // Read 'Extended Variable Length Records'
+  // ======================================================================================================================
+  if (!options.pointDataOnly && publicHeader.hasStartOfFirstExtendedVariableLengthRecord && publicHeader.hasNumOfExtendedVariableLengthRecords &&
+      publicHeader.numOfExtendedVariableLengthRecords > 0 && publicHeader.startOfFirstExtendedVariableLengthRecord < fileSize) {
+    // NOTE: The records run to the end of file
+    const LLAS_ULLONG offset = publicHeader.startOfFirstExtendedVariableLengthRecord;
+    std::vector<char> bytes;
+    if (!source.readBytes(offset, (size_t)(fileSize - offset), bytes) ||
+        !readExtendedVariableLengthRecords(bytes.data(), bytes.size(), 0, publicHeader, lasData->extendedVariableLengthRecord)) {
+      _LLAS_logError("Failed to read Extended Variable Length Records");
+      return nullptr;  // return nullptr
     }
+    stats.nBytesRead += bytes.size();
+  }
+
+  stats.extendedVariableLengthRecordsTime = stopwatch.lap();
+  stats.totalTime = totalStopwatch.lap();
+
+  return lasData;
+};
+
+/// @brief Read '.las' format file from a byte source
+/// @param source Bytes of the las file
+/// @param options Read options
+/// @return `Las data` (`LasData_ptr`): Las content
+LLAS_FUNC_DECL_PREFIX LasData_ptr read(const io::ByteSource& source,
+                                       const ReadOptions& options) {
+  ReadStats stats;
+  return read(source, options, stats);
+};
 
+/// @brief Read '.las' format file on a worker thread without blocking the calling thread.
+///        `options.progressCallback` is called on the worker thread. Cancelling `options.cancellationToken`
+///        makes the future return `nullptr` after the current step of decoding.
+/// @param filePath Path to the las file
+/// @param options Read options
+/// @return `std::future<LasData_ptr>`: Las content once read. It rethrows exceptions of the worker (e.g. `std::bad_alloc`).
+///         Like `std::async`, destroying it joins the worker, so cancel the token first to drop a read early.
+LLAS_FUNC_DECL_PREFIX std::future<LasData_ptr> readAsync(const std::string& filePath,
+                                                         const ReadOptions& options = ReadOptions()) {
+  // NOTE: The worker owns copies of the arguments. Its thread belongs to the shared state of the future, which joins it.
+  return std::async(std::launch::async, [filePath, options]() { return read(filePath, options); });
+};
+
+/// @brief Read only the public header and, unless `headerOnly`, the VLRs and EVLRs from a byte source.
+///        Point data is neither read nor decoded, so `LasData` has no points.
+/// @param source Bytes of the las file. Only the regions of the header and the records are read.
+/// @param headerOnly Read only the public header
+/// @return `Las data` (`LasData_ptr`): Las content without points
+LLAS_FUNC_DECL_PREFIX LasData_ptr readHeader(const io::ByteSource& source,
+                                             const bool headerOnly = false) {
+  if (source.size() < (LLAS_ULLONG)PublicHeader::MIN_HEADER_SIZE) {
+    _LLAS_logError("Byte source is too small to contain a public header");
+    return nullptr;  // return nullptr
+  }
+
+  LasData_ptr lasData = std::make_shared<LasData>();
+  if (!readFileHeader(source, !headerOnly, lasData->header, lasData->variableLengthRecords, lasData->extendedVariableLengthRecord)) {
+    return nullptr;  // return nullptr
+  }
+
+  // NOTE: Same as `read`, the header describes the decompressed points of LAZ files
+  lasData->header.pointDataRecordFormat &= 0x3F;
+  std::vector<VariableLengthRecord>& variableLengthRecords = lasData->variableLengthRecords;
+  variableLengthRecords.erase(std::remove_if(variableLengthRecords.begin(), variableLengthRecords.end(), laz::LasZip::isLasZipVLR), variableLengthRecords.end());
+
+  return lasData;
+};
+
+/// @brief Read only the public header and, unless `headerOnly`, the VLRs and EVLRs of '.las' format file.
+///        Point data is neither read nor decoded, so `LasData` has no points.
+/// @param filePath Path to the las file
+/// @param headerOnly Read only the public header
+/// @return `Las data` (`LasData_ptr`): Las content without points
+LLAS_FUNC_DECL_PREFIX LasData_ptr readHeader(const std::string& filePath,
+                                             const bool headerOnly = false) {
+  const io::FileByteSource source(filePath);
+  if (!source.isOpen()) {
+    _LLAS_logError("Failed to open file: " + filePath);
+    return nullptr;  // return nullptr
+  }
+
+  return readHeader(source, headerOnly);
+};
+
+/// @brief Callback of `readBatch`, called once per file
+/// @param iFile Index of the file in `filePaths`
+/// @param filePath Path to the las file
+/// @param lasData Las content, or `nullptr` if the file could not be read
+using ReadBatchCallback = std::function<void(const size_t iFile, const std::string& filePath, LasData_ptr lasData)>;
+
+/// @brief Read many '.las' format files on a shared pool of `options.numThreads` threads
+///        while an I/O thread loads the next files in the background.
+///        Each result is handed to `callback` as soon as its file is decoded, so memory does not grow with the number of files.
+/// @param filePaths Paths to the las files
+/// @param callback Called for every file in the order of completion. Calls are serialized, never concurrent.
+/// @param options Read options of every file. `numThreads` is shared among the files decoded at the same time.
+///                `progressCallback` is not used since files are decoded concurrently.
+/// @param nPrefetchFiles Maximum number of loaded files waiting for a free thread
+/// @return `true` if all the files were read. The first exception of reading or of `callback` (e.g. `std::bad_alloc`) stops the batch
+///         and is rethrown once all the threads are joined.
+LLAS_FUNC_DECL_PREFIX bool readBatch(const std::vector<std::string>& filePaths,
+                                     const ReadBatchCallback& callback,
+                                     const ReadOptions& options = ReadOptions(),
+                                     const size_t nPrefetchFiles = 2) {
+  const size_t nFiles = filePaths.size();
+  if (nFiles == 0) {
+    return true;
+  }
+
+  // NOTE: Small files are decoded one per thread, a few large files share the threads
+  const size_t nThreads = resolveNumThreads(options.numThreads);
+  const size_t nWorkers = std::min(nThreads, nFiles);
+  ReadOptions fileOptions = options;
+  fileOptions.numThreads = std::max<size_t>(1, nThreads / nWorkers);
+  fileOptions.progressCallback = nullptr;
+
+  struct LoadedFile {
+    size_t iFile;
+    bool isLoaded;
+    std::vector<char> fileBytes;
+  };
+
+  std::mutex queueMutex;
+  std::condition_variable loadedCondition;  // A file was queued or all the files were loaded
+  std::condition_variable takenCondition;   // A file was taken from the queue
+  std::queue<LoadedFile> loadedFiles;
+  bool isLoadingDone = false;
+
+  std::mutex callbackMutex;
+  bool isAllOK = true;
+
+  // NOTE: An exception must not escape a thread or leave a thread unjoined, both of which terminate the process.
+  //       The first exception stops the batch and is rethrown once all the threads are joined.
+  std::exception_ptr exception = nullptr;
+  bool isStopped = false;
+  const auto stop = [&]() {
     {
-      // Point Soruce ID
-      const std::streamsize nBytes = PointDataRecord::NUM_BYTES_POINT_SOURCE_ID;
-      std::memcpy(&pointDataRecord.pointSourceID, byteData + offset, nBytes);
-      offset += nBytes;
+      std::lock_guard<std::mutex> lock(queueMutex);
+      if (exception == nullptr) {
+        exception = std::current_exception();
+      }
+      isStopped = true;
     }
+    loadedCondition.notify_all();
+    takenCondition.notify_all();
+  };
 
-    if (format == 1 || format == 3 || format == 4) {
-      // GPS Time
-      const std::streamsize nBytes = PointDataRecord::NUM_BYTES_GPS_TIME;
-      std::memcpy(&pointDataRecord.GPSTime, byteData + offset, nBytes);
-      offset += nBytes;
-    }
+  // NOTE: Reads from disk overlap with decoding, the queue bounds the number of loaded files
+  const auto loadFiles = [&]() {
+    try {
+      for (size_t iFile = 0; iFile < nFiles; ++iFile) {
+        {
+          std::unique_lock<std::mutex> lock(queueMutex);
+          takenCondition.wait(lock, [&]() { return isStopped || loadedFiles.size() < std::max<size_t>(1, nPrefetchFiles); });
+          if (isStopped) {
+            return;
+          }
+        }
 
-    if (format == 2 || format == 3) {
-      {
-        // Red
-        const std::streamsize nBytes = PointDataRecord::NUM_BYTES_RED;
-        std::memcpy(&pointDataRecord.red, byteData + offset, nBytes);
-        offset += nBytes;
+        LoadedFile loadedFile{iFile, false, {}};
+        loadedFile.isLoaded = io::readFileBytes(filePaths[iFile], loadedFile.fileBytes);
+
+        {
+          std::lock_guard<std::mutex> lock(queueMutex);
+          loadedFiles.push(std::move(loadedFile));
+        }
+        loadedCondition.notify_one();
       }
 
       {
-        // Green
-        const std::streamsize nBytes = PointDataRecord::NUM_BYTES_GREEN;
-        std::memcpy(&pointDataRecord.green, byteData + offset, nBytes);
-        offset += nBytes;
+        std::lock_guard<std::mutex> lock(queueMutex);
+        isLoadingDone = true;
       }
+      loadedCondition.notify_all();
+    } catch (...) {
+      stop();
+    }
+  };
 
-      {
-        // Blue
-        const std::streamsize nBytes = PointDataRecord::NUM_BYTES_BLUE;
-        std::memcpy(&pointDataRecord.blue, byteData + offset, nBytes);
-        offset += nBytes;
+  const auto decodeFiles = [&]() {
+    try {
+      while (true) {
+        LoadedFile loadedFile;
+        {
+          std::unique_lock<std::mutex> lock(queueMutex);
+          loadedCondition.wait(lock, [&]() { return isStopped || !loadedFiles.empty() || isLoadingDone; });
+          if (isStopped || loadedFiles.empty()) {
+            return;
+          }
+
+          loadedFile = std::move(loadedFiles.front());
+          loadedFiles.pop();
+        }
+        takenCondition.notify_one();
+
+        const std::string& filePath = filePaths[loadedFile.iFile];
+        _LLAS_logInfo("Start reading file: " + filePath);
+
+        LasData_ptr lasData = nullptr;
+        if (loadedFile.isLoaded) {
+          lasData = read(loadedFile.fileBytes.data(), loadedFile.fileBytes.size(), fileOptions, filePath);
+        } else {
+          _LLAS_logError("Failed to open file: " + filePath);
+        }
+
+        // NOTE: Release the file before the callback keeps the thread busy
+        loadedFile.fileBytes = std::vector<char>();
+
+        {
+          std::lock_guard<std::mutex> lock(callbackMutex);
+          isAllOK = isAllOK && lasData != nullptr;
+          callback(loadedFile.iFile, filePath, lasData);
+        }
       }
+    } catch (...) {
+      stop();
     }
+  };
 
-    return pointDataRecord;
+  std::thread loader;
+  std::vector<std::thread> workers;
+  try {
+    loader = std::thread(loadFiles);
+    workers.reserve(nWorkers - 1);
+    for (size_t iWorker = 1; iWorker < nWorkers; ++iWorker) {
+      workers.emplace_back(decodeFiles);
+    }
+  } catch (...) {
+    // NOTE: The threads which were started stop if another one can not be started
+    stop();
   }
+  decodeFiles();
 
-  static PointDataRecord _readPointDataRecordFotmat5to15(const char* byteData,
-                                                         std::streamsize& offset,
-                                                         const LLAS_UCHAR& format) {
-    _LLAS_logError("Unsupported point data record format: " + std::to_string((int)format));
-    PointDataRecord pointDataRecord;
-    return pointDataRecord;
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+  if (loader.joinable()) {
+    loader.join();
   }
 
-  static PointDataRecord readPointDataRecord(const char* byteData,
-                                             std::streamsize& offset,
-                                             const LLAS_UCHAR& format) {
-    PointDataRecord pointDataRecord;
+  if (exception != nullptr) {
+    std::rethrow_exception(exception);
+  }
 
-    if (0 <= (int)format && (int)format < 5) {
-      pointDataRecord = _readPointDataRecordFotmat0to4(byteData, offset, format);
-    } else if (5 <= (int)format && (int)format < 16) {
-      pointDataRecord = _readPointDataRecordFotmat5to15(byteData, offset, format);
-    } else {
-      _LLAS_logError("Unsupported point data record format: " + std::to_string((int)format));
-    }
+  return isAllOK;
+};
 
-    return pointDataRecord;
+/// @brief Set the point counts and, if `updateBounds`, the bounding box of `header` from the statistics of the points
+/// @param header Header whose version and point data record format are set
+/// @param nPoints Number of points
+/// @param statistics Statistics of the points
+/// @param updateBounds Set the bounding box
+LLAS_FUNC_DECL_PREFIX void _updatePointCounts(PublicHeader& header,
+                                              const size_t nPoints,
+                                              const PointStatistics& statistics,
+                                              const bool updateBounds) {
+  const LLAS_UCHAR versionMinor = header.versionMinor;
+  const std::array<LLAS_ULLONG, 16>& counts = statistics.returnNumberCounts;
+
+  // NOTE: The legacy fields are zero if they can not represent the points
+  const bool hasLegacyCounts = !PointDataRecord::isExtendedFormat(header.pointDataRecordFormat) && nPoints <= std::numeric_limits<LLAS_ULONG>::max();
+  header.legacyNumOfPointRecords = hasLegacyCounts ? (LLAS_ULONG)nPoints : 0;
+  header.numOfPointRecords = versionMinor >= 4 ? nPoints : 0;
+  for (size_t iReturn = 0; iReturn < 5; ++iReturn) {
+    header.legacyNumOfPointByReturn[iReturn] = hasLegacyCounts ? (LLAS_ULONG)std::min<LLAS_ULLONG>(counts[iReturn + 1], std::numeric_limits<LLAS_ULONG>::max()) : 0;
+  }
+  for (size_t iReturn = 0; iReturn < 15; ++iReturn) {
+    header.numOfPointsByReturn[iReturn] = versionMinor >= 4 ? counts[iReturn + 1] : 0;
   }
-};
 
-struct ExtendedVariableLengthRecord {
-  // clang-format off
-  inline static const std::streamsize NUM_BYTES_RESERVED                                            = 2;
-  inline static const std::streamsize NUM_BYTES_USER_ID                                             = 16;
-  inline static const std::streamsize NUM_BYTES_RECORD_ID                                           = 2;
-  inline static const std::streamsize NUM_BYTES_RECORD_LENGTH_AFTER_HEADER                          = 16;
-  inline static const std::streamsize NUM_BYTES_DESCPIPTION                                         = 32;
-  // clang-format on
+  if (updateBounds) {
+    const math::vec3d_t& minBound = statistics.minBound;
+    const math::vec3d_t& maxBound = statistics.maxBound;
+    header.minX = minBound[0];
+    header.minY = minBound[1];
+    header.minZ = minBound[2];
+    header.maxX = maxBound[0];
+    header.maxY = maxBound[1];
+    header.maxZ = maxBound[2];
+  }
+}
 
-  ExtendedVariableLengthRecord()
-      : reserved(),
-        userID(),
-        recordID(),
-        recordLengthAfterHeader(),
-        description(),
-        record() {}
+/// @brief Build the public header of a file of the header and the records of `lasData` followed by `nPoints` points
+/// @param lasData Las content whose header, VLRs and EVLRs are written
+/// @param nPoints Number of points written
+/// @param statistics Statistics of the points, which provide the points by return and, if `updateBounds`, the bounding box
+/// @param updateBounds Set the bounding box from `statistics`
+/// @param header Output header
+/// @return `true` if the content can be written
+LLAS_FUNC_DECL_PREFIX bool _buildPublicHeader(const LasData& lasData,
+                                              const size_t nPoints,
+                                              const PointStatistics& statistics,
+                                              const bool updateBounds,
+                                              PublicHeader& header) {
+  const LLAS_UCHAR format = lasData.header.pointDataRecordFormat;
+  const std::streamsize formatSize = PointDataRecord::getFormatSize(format);
+  if (formatSize == 0) {
+    _LLAS_logError("Invalid point data record format:  " + std::to_string(format));
+    return false;
+  }
 
-  // clang-format off
-  LLAS_UCHAR        reserved;
-  LLAS_CHAR         userID[NUM_BYTES_USER_ID + 1];          // plus null-termination
-  LLAS_USHORT       recordID;
-  LLAS_ULLONG       recordLengthAfterHeader;
-  LLAS_CHAR         description[NUM_BYTES_DESCPIPTION + 1]; // plus null-termination
-  std::vector<char> record;
-  // clang-format on
+  // NOTE: Formats 6 to 10 need the 64-bit point counts of LAS 1.4
+  const LLAS_UCHAR versionMinor = lasData.header.versionMinor;
+  if ((PointDataRecord::isExtendedFormat(format) && versionMinor < 4) || 4 < versionMinor) {
+    _LLAS_logError("Point data record format " + std::to_string(format) + " can not be written as LAS 1." + std::to_string(versionMinor));
+    return false;
+  }
 
-  static ExtendedVariableLengthRecord readExtendedVariableLengthRecord(const std::vector<char>& fileBytes,
-                                                                       std::streamsize& offset) {
-    ExtendedVariableLengthRecord evlr;
+  if (versionMinor < 4 && nPoints > std::numeric_limits<LLAS_ULONG>::max()) {
+    _LLAS_logError("Too many points for LAS 1." + std::to_string(versionMinor) + ": " + std::to_string(nPoints));
+    return false;
+  }
 
-    {
-      // Reserved
-      const std::streamsize nBytes = ExtendedVariableLengthRecord::NUM_BYTES_RESERVED;
-      std::memcpy(&evlr.reserved, fileBytes.data() + offset, nBytes);
-      offset += nBytes;
-    }
+  if (versionMinor < 4 && !lasData.extendedVariableLengthRecord.empty()) {
+    _LLAS_logError("Extended Variable Length Records need LAS 1.4");
+    return false;
+  }
 
-    {
-      // User ID
-      const std::streamsize nBytes = ExtendedVariableLengthRecord::NUM_BYTES_USER_ID;
-      std::memcpy(&evlr.userID, fileBytes.data() + offset, nBytes);
-      offset += nBytes;
+  for (const VariableLengthRecord& vlr : lasData.variableLengthRecords) {
+    if (vlr.record.size() > std::numeric_limits<LLAS_USHORT>::max()) {
+      _LLAS_logError("Exceed the payload limit of variable length record: " << vlr.record.size());
+      return false;
     }
+  }
 
-    {
-      // Record ID
-      const std::streamsize nBytes = ExtendedVariableLengthRecord::NUM_BYTES_RECORD_ID;
-      std::memcpy(&evlr.recordID, fileBytes.data() + offset, nBytes);
-      offset += nBytes;
+  const LLAS_USHORT recordLength = (LLAS_USHORT)std::max<std::streamsize>(lasData.header.pointDataRecordLength, formatSize);
+
+  header = lasData.header;
+  std::memcpy(header.fileSignature, "LASF", PublicHeader::NUM_BYTES_FILE_SIGNATURE);
+  header.versionMajor = 1;
+  header.headerSize = (LLAS_USHORT)PublicHeader::getHeaderSize(versionMinor);
+  header.hasStartOfWaveformDataPacketRecord = versionMinor >= 3;
+  header.hasStartOfFirstExtendedVariableLengthRecord = versionMinor >= 4;
+  header.hasNumOfExtendedVariableLengthRecords = versionMinor >= 4;
+  header.hasNumOfPointRecords = versionMinor >= 4;
+  header.hasNumOfPointsByReturn = versionMinor >= 4;
+
+  LLAS_ULLONG offsetToPointData = header.headerSize;
+  for (const VariableLengthRecord& vlr : lasData.variableLengthRecords) {
+    offsetToPointData += VariableLengthRecord::NUM_BYTES_HEADER + vlr.record.size();
+  }
+  if (offsetToPointData > std::numeric_limits<LLAS_ULONG>::max()) {
+    _LLAS_logError("Variable Length Records are too large");
+    return false;
+  }
+
+  header.numOfVariableLengthRecords = (LLAS_ULONG)lasData.variableLengthRecords.size();
+  header.offsetToPointData = (LLAS_ULONG)offsetToPointData;
+  header.pointDataRecordLength = recordLength;
+
+  // NOTE: The EVLRs follow the point data. The waveform data packets, if any, are the EVLR with record ID 65535.
+  LLAS_ULLONG offsetToEVLR = offsetToPointData + (LLAS_ULLONG)nPoints * recordLength;
+  header.startOfFirstExtendedVariableLengthRecord = lasData.extendedVariableLengthRecord.empty() ? 0 : offsetToEVLR;
+  header.numOfExtendedVariableLengthRecords = (LLAS_ULONG)lasData.extendedVariableLengthRecord.size();
+  header.startOfWaveformDataPacketRecord = 0;
+  for (const ExtendedVariableLengthRecord& evlr : lasData.extendedVariableLengthRecord) {
+    if (evlr.recordID == 65535 && header.startOfWaveformDataPacketRecord == 0) {
+      header.startOfWaveformDataPacketRecord = offsetToEVLR;
     }
+    offsetToEVLR += ExtendedVariableLengthRecord::NUM_BYTES_HEADER + evlr.record.size();
+  }
 
-    {
-      // Record Length After Header
-      const std::streamsize nBytes = ExtendedVariableLengthRecord::NUM_BYTES_RECORD_LENGTH_AFTER_HEADER;
-      std::memcpy(&evlr.recordLengthAfterHeader, fileBytes.data() + offset, nBytes);
-      offset += nBytes;
+  _updatePointCounts(header, nPoints, statistics, updateBounds);
+
+  return true;
+}
+
+/// @brief Write the public header and the VLRs at the current position of `file`
+LLAS_FUNC_DECL_PREFIX void _writePublicHeader(const PublicHeader& header,
+                                              const std::vector<VariableLengthRecord>& variableLengthRecords,
+                                              std::ofstream& file) {
+  std::vector<char> byteData(header.offsetToPointData, 0);
+  header.writePublicHeader(byteData.data());
+
+  std::streamsize offset = header.headerSize;
+  for (const VariableLengthRecord& vlr : variableLengthRecords) {
+    vlr.writeVariableLengthRecord(byteData.data(), offset);
+  }
+
+  file.write(byteData.data(), (std::streamsize)byteData.size());
+}
+
+/// @brief Write '.las' format file
+/// @param filePath Path to the las file
+/// @param lasData Las content in either layout. The public header, the VLRs and the EVLRs are written as they are except for
+///                the signature, the header size, the point counts, the offsets and, if `options.updateBounds`, the bounding box.
+/// @param options Write options
+/// @return `true` if the file was written
+LLAS_FUNC_DECL_PREFIX bool write(const std::string& filePath,
+                                 const LasData& lasData,
+                                 const WriteOptions& options = WriteOptions()) {
+#if defined(LLAS_MEASURE_TIME)
+  const auto startTime = std::chrono::system_clock::now();
+#endif
+
+  _LLAS_logInfo("Start writing file: " + filePath);
+
+  // ======================================================================================================================
+  // Build 'Public Header'
+  // ======================================================================================================================
+  const size_t nPoints = lasData.getNumPoints();
+  PublicHeader header;
+  if (!_buildPublicHeader(lasData, nPoints, lasData.getStatistics(options.numThreads), options.updateBounds, header)) {
+    return false;
+  }
+
+  const LLAS_UCHAR format = header.pointDataRecordFormat;
+  const LLAS_USHORT recordLength = header.pointDataRecordLength;
+
+  // NOTE: Attributes which were not read would silently become zero in the file
+  const LLAS_ULONG missingFields = PointDataRecord::getFormatFields(format) & ~lasData.getFields();
+  if (missingFields != 0 && nPoints > 0) {
+    if (!options.allowMissingFields) {
+      _LLAS_logError("Points lack attributes of point data record format " + std::to_string((int)format) + ": " + PointField::getNames(missingFields) +
+                     ". Set `WriteOptions::allowMissingFields` to write them as zero: " + filePath);
+      return false;
     }
+    _LLAS_logInfo("Write missing attributes as zero: " + PointField::getNames(missingFields));
+  }
 
-    {
-      // Description
-      const std::streamsize nBytes = ExtendedVariableLengthRecord::NUM_BYTES_DESCPIPTION;
-      std::memcpy(&evlr.description, fileBytes.data() + offset, nBytes);
-      offset += nBytes;
+  std::ofstream file(filePath, std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!file) {
+    _LLAS_logError("Failed to open file: " + filePath);
+    return false;
+  }
+
+  // ======================================================================================================================
+  // Write 'Public Header' and 'Variable Length Records'
+  // ======================================================================================================================
+  _writePublicHeader(header, lasData.variableLengthRecords, file);
+
+  // ======================================================================================================================
+  // Write 'Point Data Records'
+  // ======================================================================================================================
+  {
+    const size_t nChunkRecords = std::max<size_t>(1, options.bufferSize / recordLength);
+    const size_t nChunks = (nPoints + nChunkRecords - 1) / nChunkRecords;
+
+    // NOTE: The next chunk is encoded while the previous one is being written
+    std::vector<char> buffers[2];
+    std::thread writerThread;
+    bool isOK = true;
+
+    for (size_t iChunk = 0; iChunk < nChunks && isOK; ++iChunk) {
+      const size_t firstIndex = iChunk * nChunkRecords;
+      const size_t nRecords = std::min(nChunkRecords, nPoints - firstIndex);
+
+      std::vector<char>& buffer = buffers[iChunk % 2];
+      buffer.resize(nRecords * recordLength);
+      isOK = writePointDataRecords(lasData, firstIndex, nRecords, recordLength, format, options.numThreads, buffer.data());
+
+      if (writerThread.joinable()) {
+        writerThread.join();
+      }
+      if (isOK) {
+        writerThread = std::thread([&file, &buffer]() { file.write(buffer.data(), (std::streamsize)buffer.size()); });
+      }
     }
 
-    {
-      // Record
-      const std::streamsize nBytes = (std::streamsize)evlr.recordLengthAfterHeader;
-      evlr.record.assign(fileBytes.begin() + offset, fileBytes.begin() + offset + nBytes);
-      offset += nBytes;
+    if (writerThread.joinable()) {
+      writerThread.join();
     }
 
-    return evlr;
+    if (!isOK) {
+      return false;
+    }
   }
-};
 
-struct LasData {
-  LasData()
-      : header(),
-        variableLengthRecords(),
-        pointDataRecords(),
-        extendedVariableLengthRecord() {}
+  // ======================================================================================================================
+  // Write 'Extended Variable Length Records'
+  // ======================================================================================================================
+  for (const ExtendedVariableLengthRecord& evlr : lasData.extendedVariableLengthRecord) {
+    std::vector<char> byteData(ExtendedVariableLengthRecord::NUM_BYTES_HEADER + evlr.record.size());
+    std::streamsize offset = 0;
+    evlr.writeExtendedVariableLengthRecord(byteData.data(), offset);
+    file.write(byteData.data(), (std::streamsize)byteData.size());
+  }
 
-  PublicHeader header;
-  std::vector<VariableLengthRecord> variableLengthRecords;
-  std::vector<PointDataRecord> pointDataRecords;
-  std::vector<ExtendedVariableLengthRecord> extendedVariableLengthRecord;
+  file.close();
+  if (!file) {
+    _LLAS_logError("Failed to write file: " + filePath);
+    return false;
+  }
 
-  /// @brief Get the number of points
-  /// @return `nPoints` (`size_t`)
-  inline size_t getNumPoints() const {
-    return pointDataRecords.size();
-  };
+#if defined(LLAS_MEASURE_TIME)
+  const auto endTime = std::chrono::system_clock::now();
+  const double elapsedTime = std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count();
+  _LLAS_logInfo("Elapsed time: " + std::to_string(elapsedTime * 1e-6) + " [sec]");
+#endif
 
-  /// @brief Get point coords
-  /// @param rescale by scales and add offsets based on values in public header
-  /// @return `Point coordinates` (`vecd_t`): arranged like `[x0, y0, z0, x1, y1, z1, ...]`.
-  inline math::vecd_t getPointCoords(const bool rescale = true) const {
-    math::vecd_t coords;
+  return true;
+}
 
-    const size_t nPoints = getNumPoints();
-    coords.resize(3 * nPoints);
+// ==========================================================================
+// Merging
+// ==========================================================================
 
-    for (size_t i = 0; i < nPoints; ++i) {
-      double x = (double)pointDataRecords[i].x;
-      double y = (double)pointDataRecords[i].y;
-      double z = (double)pointDataRecords[i].z;
+/// @brief Build the public header of the merge of tiles with `headers`: the common point data record format, the finest scale factor of every axis,
+///        the shared offsets or, if they differ, offsets at the center of the union of the bounding boxes, the summed point counts and the union of the bounding boxes.
+///        Other fields are those of the first tile. EVLRs are not merged.
+/// @param headers Public headers of the tiles
+/// @param options Merge options
+/// @param header Output header
+/// @return `true` if the tiles can be merged and the merged bounding box fits into 32-bit integer coordinates
+LLAS_FUNC_DECL_PREFIX bool mergePublicHeaders(const std::vector<PublicHeader>& headers,
+                                              const MergeOptions& options,
+                                              PublicHeader& header) {
+  if (headers.empty()) {
+    _LLAS_logError("No tiles to merge");
+    return false;
+  }
 
-      if (rescale) {
-        x = x * header.xScaleFactor + header.xOffset;
-        y = y * header.yScaleFactor + header.yOffset;
-        z = z * header.zScaleFactor + header.zOffset;
+  LLAS_UCHAR format = headers[0].pointDataRecordFormat & 0x3F;
+  if (options.pointDataRecordFormat >= 0) {
+    format = (LLAS_UCHAR)options.pointDataRecordFormat;
+  } else {
+    for (const PublicHeader& tileHeader : headers) {
+      if ((tileHeader.pointDataRecordFormat & 0x3F) != format) {
+        _LLAS_logError("Tiles have different point data record formats. Set `MergeOptions::pointDataRecordFormat`.");
+        return false;
       }
+    }
+  }
+  if (PointDataRecord::getFormatSize(format) == 0) {
+    _LLAS_logError("Invalid point data record format:  " + std::to_string(format));
+    return false;
+  }
 
-      const size_t offset = 3 * i;
-
-      coords[offset + 0] = x;
-      coords[offset + 1] = y;
-      coords[offset + 2] = z;
+  const double inf = std::numeric_limits<double>::infinity();
+  LLAS_UCHAR versionMinor = 0;
+  PointStatistics statistics;
+  statistics.minBound = {inf, inf, inf};
+  statistics.maxBound = {-inf, -inf, -inf};
+  math::vec3d_t scaleFactors = {inf, inf, inf};
+  bool hasSameOffsets = true;
+
+  for (const PublicHeader& tileHeader : headers) {
+    versionMinor = std::max(versionMinor, tileHeader.versionMinor);
+    statistics.nPoints += (size_t)tileHeader.getNumPointRecords();
+
+    // NOTE: The 64-bit counts of LAS 1.4 are used if present, since they cover 15 returns
+    for (size_t iReturn = 0; iReturn < 15; ++iReturn) {
+      const LLAS_ULLONG legacyCount = iReturn < 5 ? tileHeader.legacyNumOfPointByReturn[iReturn] : 0;
+      statistics.returnNumberCounts[iReturn + 1] += tileHeader.hasNumOfPointsByReturn ? tileHeader.numOfPointsByReturn[iReturn] : legacyCount;
     }
 
-    return coords;
-  };
+    statistics.minBound = {std::min(statistics.minBound[0], tileHeader.minX), std::min(statistics.minBound[1], tileHeader.minY), std::min(statistics.minBound[2], tileHeader.minZ)};
+    statistics.maxBound = {std::max(statistics.maxBound[0], tileHeader.maxX), std::max(statistics.maxBound[1], tileHeader.maxY), std::max(statistics.maxBound[2], tileHeader.maxZ)};
+    scaleFactors = {std::min(scaleFactors[0], std::abs(tileHeader.xScaleFactor)), std::min(scaleFactors[1], std::abs(tileHeader.yScaleFactor)), std::min(scaleFactors[2], std::abs(tileHeader.zScaleFactor))};
+    hasSameOffsets = hasSameOffsets && tileHeader.xOffset == headers[0].xOffset && tileHeader.yOffset == headers[0].yOffset && tileHeader.zOffset == headers[0].zOffset;
+  }
 
-  /// @brief Get point colors
-  /// @return `Point colors` (`std::vector<unsigned char>`): arranged like `[r0, g0, b0, r1, g1, b1, ...]`.
-  inline math::vec_t<unsigned char> getPointColors() const {
-    math::vec_t<unsigned char> colors;
+  // NOTE: Formats 6 to 10 need the 64-bit point counts of LAS 1.4
+  if (PointDataRecord::isExtendedFormat(format)) {
+    versionMinor = 4;
+  }
 
-    const size_t nPoints = getNumPoints();
-    colors.resize(3 * nPoints);
+  math::vec3d_t offsets = {headers[0].xOffset, headers[0].yOffset, headers[0].zOffset};
+  if (options.hasQuantization) {
+    scaleFactors = options.scaleFactors;
+    offsets = options.offsets;
+  } else if (!hasSameOffsets) {
+    // NOTE: A multiple of the scale factor keeps the coordinates of tiles with the same scale factor and offsets on that multiple exact
+    for (size_t axis = 0; axis < 3; ++axis) {
+      const double center = 0.5 * (statistics.minBound[axis] + statistics.maxBound[axis]);
+      offsets[axis] = std::round(center / scaleFactors[axis]) * scaleFactors[axis];
+    }
+  }
 
-    const double scaleFactor = 255.0 / 65535.0;
+  for (size_t axis = 0; axis < 3; ++axis) {
+    if (!(scaleFactors[axis] > 0.0) || !std::isfinite(scaleFactors[axis])) {
+      _LLAS_logError("Invalid scale factor: " << scaleFactors[axis]);
+      return false;
+    }
+
+    const double minCoord = (statistics.minBound[axis] - offsets[axis]) / scaleFactors[axis];
+    const double maxCoord = (statistics.maxBound[axis] - offsets[axis]) / scaleFactors[axis];
+    if (minCoord < (double)std::numeric_limits<LLAS_LONG>::min() || (double)std::numeric_limits<LLAS_LONG>::max() < maxCoord) {
+      _LLAS_logError("Merged bounding box does not fit into 32-bit coordinates with scale factor " << scaleFactors[axis] << " and offset " << offsets[axis]);
+      return false;
+    }
+  }
 
-    for (size_t i = 0; i < nPoints; ++i) {
-      const double red_d = (double)pointDataRecords[i].red * scaleFactor;
-      const double green_d = (double)pointDataRecords[i].green * scaleFactor;
-      const double blue_d = (double)pointDataRecords[i].blue * scaleFactor;
+  header = headers[0];
+  header.versionMinor = versionMinor;
+  header.pointDataRecordFormat = format;
+  header.pointDataRecordLength = (LLAS_USHORT)PointDataRecord::getFormatSize(format);
+  header.xScaleFactor = scaleFactors[0];
+  header.yScaleFactor = scaleFactors[1];
+  header.zScaleFactor = scaleFactors[2];
+  header.xOffset = offsets[0];
+  header.yOffset = offsets[1];
+  header.zOffset = offsets[2];
+  header.hasNumOfPointRecords = versionMinor >= 4;
+  header.hasNumOfPointsByReturn = versionMinor >= 4;
+  header.startOfWaveformDataPacketRecord = 0;
+  header.startOfFirstExtendedVariableLengthRecord = 0;
+  header.numOfExtendedVariableLengthRecords = 0;
+
+  _updatePointCounts(header, statistics.nPoints, statistics, true);
+
+  return true;
+}
 
-      const size_t offset = 3 * i;
+/// @brief Re-quantize the integer coordinates of the points `[begin, begin + nPoints)` of `lasData`
+///        from the scale factors and the offsets of `sourceHeader` into those of `lasData.header`
+/// @param sourceHeader Header which the coordinates were quantized with
+/// @param begin Index of the first point
+/// @param nPoints Number of points
+/// @param lasData Las content in any layout
+/// @return `true` if all the coordinates fit into 32 bits. Others are clamped.
+LLAS_FUNC_DECL_PREFIX bool _requantizePoints(const PublicHeader& sourceHeader,
+                                             const size_t begin,
+                                             const size_t nPoints,
+                                             LasData& lasData) {
+  const math::vec3d_t sourceScaleFactors = {sourceHeader.xScaleFactor, sourceHeader.yScaleFactor, sourceHeader.zScaleFactor};
+  const math::vec3d_t sourceOffsets = {sourceHeader.xOffset, sourceHeader.yOffset, sourceHeader.zOffset};
+  const math::vec3d_t scaleFactors = lasData.getScaleFactors();
+  const math::vec3d_t offsets = lasData.getOffsets();
+
+  LLAS_LONG PointDataRecord::*const members[3] = {&PointDataRecord::x, &PointDataRecord::y, &PointDataRecord::z};
+  std::vector<LLAS_LONG>* const columns[3] = {&lasData.pointDataColumns.x, &lasData.pointDataColumns.y, &lasData.pointDataColumns.z};
+
+  // NOTE: Records are re-quantized through a small buffer per axis, which stays in cache
+  const size_t BLOCK_SIZE = 1024;
+  LLAS_LONG buffer[BLOCK_SIZE];
+  bool isInRange = true;
+
+  for (size_t axis = 0; axis < 3; ++axis) {
+    const double scale = sourceScaleFactors[axis] / scaleFactors[axis];
+    const double offset = (sourceOffsets[axis] - offsets[axis]) / scaleFactors[axis];
+    if (scale == 1.0 && offset == 0.0) {
+      continue;
+    }
 
-      colors[offset + 0] = (unsigned char)red_d;
-      colors[offset + 1] = (unsigned char)green_d;
-      colors[offset + 2] = (unsigned char)blue_d;
+    if (lasData.layout == PointDataLayout::StructOfArrays) {
+      // NOTE: Coordinates which were not decoded are left empty
+      std::vector<LLAS_LONG>& column = *columns[axis];
+      if (!column.empty()) {
+        isInRange = simd::requantizeCoords(column.data() + begin, nPoints, scale, offset, column.data() + begin) && isInRange;
+      }
+      continue;
     }
 
-    return colors;
-  };
+    for (size_t blockBegin = 0; blockBegin < nPoints; blockBegin += BLOCK_SIZE) {
+      const size_t nBlockPoints = std::min(BLOCK_SIZE, nPoints - blockBegin);
+      const size_t firstIndex = begin + blockBegin;
 
-  inline bool validate() const {
-    const size_t& nPoints = getNumPoints();
-    const math::vecd_t& pointCoords = getPointCoords();
-
-    math::vec3d_t minCoords, maxCoords;
-    for (size_t iPoint = 0; iPoint < nPoints; ++iPoint) {
-      const size_t offset = 3 * iPoint;
-
-      if (iPoint == 0) {
-        minCoords[0] = pointCoords[offset + 0];
-        minCoords[1] = pointCoords[offset + 1];
-        minCoords[2] = pointCoords[offset + 2];
-        maxCoords[0] = pointCoords[offset + 0];
-        maxCoords[1] = pointCoords[offset + 1];
-        maxCoords[2] = pointCoords[offset + 2];
-      } else {
-        if (pointCoords[offset + 0] < minCoords[0]) {
-          minCoords[0] = pointCoords[offset + 0];
-        }
-        if (pointCoords[offset + 1] < minCoords[1]) {
-          minCoords[1] = pointCoords[offset + 1];
-        }
-        if (pointCoords[offset + 2] < minCoords[2]) {
-          minCoords[2] = pointCoords[offset + 2];
+      if (lasData.layout == PointDataLayout::Packed) {
+        for (size_t i = 0; i < nBlockPoints; ++i) {
+          std::memcpy(&buffer[i], lasData.packedPointData.getRecord(firstIndex + i) + axis * sizeof(LLAS_LONG), sizeof(LLAS_LONG));
         }
-        if (pointCoords[offset + 0] > maxCoords[0]) {
-          maxCoords[0] = pointCoords[offset + 0];
+      } else {
+        for (size_t i = 0; i < nBlockPoints; ++i) {
+          buffer[i] = lasData.pointDataRecords[firstIndex + i].*members[axis];
         }
-        if (pointCoords[offset + 1] > maxCoords[1]) {
-          maxCoords[1] = pointCoords[offset + 1];
+      }
+
+      isInRange = simd::requantizeCoords(buffer, nBlockPoints, scale, offset, buffer) && isInRange;
+
+      if (lasData.layout == PointDataLayout::Packed) {
+        for (size_t i = 0; i < nBlockPoints; ++i) {
+          std::memcpy(lasData.packedPointData.getRecord(firstIndex + i) + axis * sizeof(LLAS_LONG), &buffer[i], sizeof(LLAS_LONG));
         }
-        if (pointCoords[offset + 2] > maxCoords[2]) {
-          maxCoords[2] = pointCoords[offset + 2];
+      } else {
+        for (size_t i = 0; i < nBlockPoints; ++i) {
+          lasData.pointDataRecords[firstIndex + i].*members[axis] = buffer[i];
         }
       }
     }
+  }
 
-    char logMessage[LLAS_BUFFER_SIZE];
+  return isInRange;
+}
 
-#if defined(_WIN64)
-    std::fill_n(logMessage, LLAS_BUFFER_SIZE, '\0');
-    sprintf_s(logMessage, "minCoords        = (%.5lf, %.5lf, %.5lf)", minCoords[0], minCoords[1], minCoords[2]);
-    _LLAS_logDebug(logMessage);
+/// @brief Copy the points of `tile` into `lasData` from `firstIndex` and re-quantize them into the scale factors and the offsets of `lasData.header`
+/// @param tile Las content in any layout
+/// @param firstIndex Index of the first point of `tile` in `lasData`
+/// @param nThreads Number of threads. `0` means all hardware threads.
+/// @param lasData Las content with room for the points of `tile`
+/// @return `true` if all the coordinates fit into 32 bits
+LLAS_FUNC_DECL_PREFIX bool _appendTilePoints(const LasData& tile,
+                                             const size_t firstIndex,
+                                             const size_t nThreads,
+                                             LasData& lasData) {
+  const size_t nPoints = tile.getNumPoints();
+  const bool isSameFormat = (tile.header.pointDataRecordFormat & 0x3F) == lasData.header.pointDataRecordFormat;
+
+  // NOTE: Every block is re-quantized right after it is copied while it is still in cache
+  const size_t BLOCK_SIZE = 4096;
+  std::atomic<bool> isInRange(true);
+
+  parallelFor(nPoints, nThreads, [&](const size_t begin, const size_t end) {
+    for (size_t blockBegin = begin; blockBegin < end; blockBegin += BLOCK_SIZE) {
+      const size_t nBlockPoints = std::min(BLOCK_SIZE, end - blockBegin);
+      const size_t index = firstIndex + blockBegin;
+
+      if (lasData.layout == PointDataLayout::ArrayOfStructs) {
+        if (tile.layout == PointDataLayout::ArrayOfStructs) {
+          std::copy(tile.pointDataRecords.begin() + blockBegin, tile.pointDataRecords.begin() + blockBegin + nBlockPoints, lasData.pointDataRecords.begin() + index);
+        } else {
+          for (size_t i = 0; i < nBlockPoints; ++i) {
+            lasData.pointDataRecords[index + i] = tile.getPointDataRecord(blockBegin + i);
+          }
+        }
+      } else if (lasData.layout == PointDataLayout::StructOfArrays) {
+        if (tile.layout == PointDataLayout::StructOfArrays && isSameFormat) {
+          lasData.pointDataColumns.copy(tile.pointDataColumns, blockBegin, nBlockPoints, index);
+        } else {
+          for (size_t i = 0; i < nBlockPoints; ++i) {
+            lasData.pointDataColumns.set(index + i, tile.getPointDataRecord(blockBegin + i));
+          }
+        }
+      } else {
+        if (tile.layout == PointDataLayout::Packed && tile.packedPointData.format == lasData.packedPointData.format) {
+          std::memcpy(lasData.packedPointData.getRecord(index), tile.packedPointData.getRecord(blockBegin), nBlockPoints * lasData.packedPointData.recordSize);
+        } else {
+          for (size_t i = 0; i < nBlockPoints; ++i) {
+            lasData.packedPointData.set(index + i, tile.getPointDataRecord(blockBegin + i));
+          }
+        }
+      }
 
-    std::fill_n(logMessage, LLAS_BUFFER_SIZE, '\0');
-    sprintf_s(logMessage, "publicHeader.min = (%.5lf, %.5lf, %.5lf)", header.minX, header.minY, header.minZ);
-    _LLAS_logDebug(logMessage);
+      if (!_requantizePoints(tile.header, index, nBlockPoints, lasData)) {
+        isInRange = false;
+      }
+    }
+  });
 
-    std::fill_n(logMessage, LLAS_BUFFER_SIZE, '\0');
-    sprintf_s(logMessage, "maxCoords        = (%.5lf, %.5lf, %.5lf)", maxCoords[0], maxCoords[1], maxCoords[2]);
-    _LLAS_logDebug(logMessage);
+  return isInRange;
+}
 
-    std::fill_n(logMessage, LLAS_BUFFER_SIZE, '\0');
-    sprintf_s(logMessage, "publicHeader.max = (%.5lf, %.5lf, %.5lf)", header.maxX, header.maxY, header.maxZ);
-    _LLAS_logDebug(logMessage);
-#else
-    std::fill_n(logMessage, LLAS_BUFFER_SIZE, '\0');
-    sprintf(logMessage, "minCoords        = (%.5lf, %.5lf, %.5lf)", minCoords[0], minCoords[1], minCoords[2]);
-    _LLAS_logDebug(logMessage);
+/// @brief Merge tiles into one `LasData` with shared scale factors and offsets (`mergePublicHeaders`).
+///        The points are allocated once for all the tiles and their integer coordinates are re-quantized while they are copied, without converting them to double.
+///        The VLRs of the first tile (e.g. the coordinate reference system) are kept and EVLRs are dropped.
+///        The point counts and the bounding box are recomputed from the merged points.
+/// @param tiles Las contents in any layout. Attributes which some tiles lack (e.g. `ReadOptions::fields`) are left out of the merged points.
+/// @param options Merge options
+/// @return `Las data` (`LasData_ptr`): merged content, or `nullptr` if a tile is missing, the formats differ, the coordinates do not fit into 32 bits
+///         or packed records would lack attributes
+LLAS_FUNC_DECL_PREFIX LasData_ptr merge(const std::vector<LasData_ptr>& tiles,
+                                        const MergeOptions& options = MergeOptions()) {
+  std::vector<PublicHeader> headers;
+  size_t nPoints = 0;
+  LLAS_ULONG fields = PointField::ALL;  // NOTE: Only the attributes held by every tile are merged
+  for (const LasData_ptr& tile : tiles) {
+    if (tile == nullptr) {
+      _LLAS_logError("Tile to merge is null");
+      return nullptr;  // return nullptr
+    }
 
-    std::fill_n(logMessage, LLAS_BUFFER_SIZE, '\0');
-    sprintf(logMessage, "publicHeader.min = (%.5lf, %.5lf, %.5lf)", header.minX, header.minY, header.minZ);
-    _LLAS_logDebug(logMessage);
+    headers.push_back(tile->header);
+    nPoints += tile->getNumPoints();
+    fields &= tile->getFields();
+  }
 
-    std::fill_n(logMessage, LLAS_BUFFER_SIZE, '\0');
-    sprintf(logMessage, "maxCoords        = (%.5lf, %.5lf, %.5lf)", maxCoords[0], maxCoords[1], maxCoords[2]);
-    _LLAS_logDebug(logMessage);
+  LasData_ptr lasData = std::make_shared<LasData>();
+  if (!mergePublicHeaders(headers, options, lasData->header)) {
+    return nullptr;  // return nullptr
+  }
 
-    std::fill_n(logMessage, LLAS_BUFFER_SIZE, '\0');
-    sprintf(logMessage, "publicHeader.max = (%.5lf, %.5lf, %.5lf)", header.maxX, header.maxY, header.maxZ);
-    _LLAS_logDebug(logMessage);
-#endif
+  // NOTE: Packed records always hold every attribute of their format
+  const LLAS_ULONG missingFields = PointDataRecord::getFormatFields(lasData->header.pointDataRecordFormat) & ~fields;
+  if (options.layout == PointDataLayout::Packed && missingFields != 0) {
+    _LLAS_logError("Tiles lack attributes which packed records hold: " + PointField::getNames(missingFields));
+    return nullptr;  // return nullptr
+  }
+  lasData->layout = options.layout;
+  lasData->fields = fields;
+  lasData->variableLengthRecords = tiles[0]->variableLengthRecords;
+
+  const LLAS_UCHAR format = lasData->header.pointDataRecordFormat;
+  if (options.layout == PointDataLayout::StructOfArrays) {
+    lasData->pointDataColumns.resize(nPoints, format, fields);
+  } else if (options.layout == PointDataLayout::Packed) {
+    if (!lasData->packedPointData.resize(nPoints, format)) {
+      return nullptr;  // return nullptr
+    }
+  } else {
+    lasData->pointDataRecords.resize(nPoints);
+  }
 
-    return true;
+  size_t firstIndex = 0;
+  for (const LasData_ptr& tile : tiles) {
+    if (!_appendTilePoints(*tile, firstIndex, options.numThreads, *lasData)) {
+      _LLAS_logError("Coordinates do not fit into 32 bits with the merged scale factors and offsets");
+      return nullptr;  // return nullptr
+    }
+    firstIndex += tile->getNumPoints();
   }
-};
 
-using LasData_ptr = std::shared_ptr<LasData>;
+  _updatePointCounts(lasData->header, nPoints, lasData->getStatistics(options.numThreads), true);
 
-// ==========================================================================
-// Functions
-// ==========================================================================
+  return lasData;
+}
 
-LLAS_FUNC_DECL_PREFIX LasData_ptr read(const std::string& filePath,
-                                       const bool pointDataOnly = true);
+/// @brief Merge '.las' (or '.laz') format files into one '.las' format file with shared scale factors and offsets (`mergePublicHeaders`) without holding them in memory.
+///        Points are streamed chunk by chunk (LAZ files tile by tile), re-quantized in place and appended to the output file.
+///        The VLRs of the first file are kept and EVLRs are dropped. The point counts and the bounding box are recomputed from the merged points.
+/// @param filePaths Paths to the las files
+/// @param outputPath Path to the merged las file
+/// @param options Merge options. `layout` is not used.
+/// @return `true` if the file was written. On failure, a partially written file is removed.
+LLAS_FUNC_DECL_PREFIX bool mergeFiles(const std::vector<std::string>& filePaths,
+                                      const std::string& outputPath,
+                                      const MergeOptions& options = MergeOptions()) {
+  _LLAS_logInfo("Start merging files into: " + outputPath);
 
-/// @brief Read '.las' format file
-/// @param filePath Path to the las file
-/// @param pointDataOnly Read only "PointDataRecords"
-/// @return `Las data` (`LasData_ptr`): Las content
-LLAS_FUNC_DECL_PREFIX LasData_ptr read(const std::string& filePath,
-                                       const bool pointDataOnly) {
-#if defined(LLAS_PRINT_BYTES)
-  _LLAS_logDebug("LLAS_CHAR   = " + std::to_string(sizeof(LLAS_CHAR)));
-  _LLAS_logDebug("LLAS_SCHAR  = " + std::to_string(sizeof(LLAS_SCHAR)));
-  _LLAS_logDebug("LLAS_UCHAR  = " + std::to_string(sizeof(LLAS_UCHAR)));
-  _LLAS_logDebug("LLAS_SHORT  = " + std::to_string(sizeof(LLAS_SHORT)));
-  _LLAS_logDebug("LLAS_USHORT = " + std::to_string(sizeof(LLAS_USHORT)));
-  _LLAS_logDebug("LLAS_LONG   = " + std::to_string(sizeof(LLAS_LONG)));
-  _LLAS_logDebug("LLAS_ULONG  = " + std::to_string(sizeof(LLAS_ULONG)));
-  _LLAS_logDebug("LLAS_LLONG  = " + std::to_string(sizeof(LLAS_LLONG)));
-  _LLAS_logDebug("LLAS_ULLONG = " + std::to_string(sizeof(LLAS_ULLONG)));
-  _LLAS_logDebug("LLAS_FLOAT  = " + std::to_string(sizeof(LLAS_FLOAT)));
-  _LLAS_logDebug("LLAS_DOUBLE = " + std::to_string(sizeof(LLAS_DOUBLE)));
-  _LLAS_logDebug("LLAS_STRING = " + std::to_string(sizeof(LLAS_STRING)));
-#endif
+  // ======================================================================================================================
+  // Read 'Public Header' of every file and 'Variable Length Records' of the first one
+  // ======================================================================================================================
+  // NOTE: `lasData` holds the merged header and VLRs, and the points of the current chunk
+  LasData lasData;
+  std::vector<PublicHeader> headers(filePaths.size());
+  std::vector<bool> isCompressed(filePaths.size());
+
+  for (size_t iFile = 0; iFile < filePaths.size(); ++iFile) {
+    const io::FileByteSource source(filePaths[iFile]);
+    if (!source.isOpen()) {
+      _LLAS_logError("Failed to open file: " + filePaths[iFile]);
+      return false;
+    }
 
-#if defined(LLAS_CHECK_BYTE_SIZE)
-  if (sizeof(LLAS_CHAR) != 1) {
-    _LLAS_logError("Byte size check failed: LLAS_CHAR");
-    return nullptr;
-  }
-  if (sizeof(LLAS_SCHAR) != 1) {
-    _LLAS_logError("Byte size check failed: LLAS_SCHAR");
-    return nullptr;
-  }
-  if (sizeof(LLAS_UCHAR) != 1) {
-    _LLAS_logError("Byte size check failed: LLAS_UCHAR");
-    return nullptr;
-  }
-  if (sizeof(LLAS_SHORT) != 2) {
-    _LLAS_logError("Byte size check failed: LLAS_SHORT");
-    return nullptr;
-  }
-  if (sizeof(LLAS_USHORT) != 2) {
-    _LLAS_logError("Byte size check failed: LLAS_USHORT");
-    return nullptr;
-  }
-  if (sizeof(LLAS_LONG) != 4) {
-    _LLAS_logError("Byte size check failed: LLAS_LONG");
-    return nullptr;
-  }
-  if (sizeof(LLAS_ULONG) != 4) {
-    _LLAS_logError("Byte size check failed: LLAS_ULONG");
-    return nullptr;
-  }
-  if (sizeof(LLAS_LLONG) != 8) {
-    _LLAS_logError("Byte size check failed: LLAS_LLONG");
-    return nullptr;
-  }
-  if (sizeof(LLAS_ULLONG) != 8) {
-    _LLAS_logError("Byte size check failed: LLAS_ULLONG");
-    return nullptr;
+    std::vector<VariableLengthRecord> variableLengthRecords;
+    std::vector<ExtendedVariableLengthRecord> extendedVariableLengthRecords;
+    if (!readFileHeader(source, iFile == 0, headers[iFile], variableLengthRecords, extendedVariableLengthRecords)) {
+      return false;
+    }
+
+    isCompressed[iFile] = headers[iFile].isCompressed();
+    headers[iFile].pointDataRecordFormat &= 0x3F;
+    if (iFile == 0) {
+      variableLengthRecords.erase(std::remove_if(variableLengthRecords.begin(), variableLengthRecords.end(), laz::LasZip::isLasZipVLR), variableLengthRecords.end());
+      lasData.variableLengthRecords = std::move(variableLengthRecords);
+    }
   }
-  if (sizeof(LLAS_FLOAT) != 4) {
-    _LLAS_logError("Byte size check failed: LLAS_FLOAT");
-    return nullptr;
+
+  if (!mergePublicHeaders(headers, options, lasData.header)) {
+    return false;
   }
-  if (sizeof(LLAS_DOUBLE) != 8) {
-    _LLAS_logError("Byte size check failed: LLAS_DOUBLE");
-    return nullptr;
+
+  // ======================================================================================================================
+  // Write 'Public Header' and 'Variable Length Records'
+  // ======================================================================================================================
+  // NOTE: The header is rewritten with the point counts and the bounding box of the merged points at the end
+  PublicHeader header;
+  if (!_buildPublicHeader(lasData, (size_t)lasData.header.getNumPointRecords(), PointStatistics(), false, header)) {
+    return false;
   }
-#endif
 
-#if defined(LLAS_MEASURE_TIME)
-  const auto startTime = std::chrono::system_clock::now();
-#endif
+  const LLAS_UCHAR format = header.pointDataRecordFormat;
+  const LLAS_USHORT recordLength = header.pointDataRecordLength;
 
-  bool isOK = true;
+  std::ofstream file(outputPath, std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!file) {
+    _LLAS_logError("Failed to open file: " + outputPath);
+    return false;
+  }
 
-  _LLAS_logInfo("Start reading file: " + filePath);
+  // NOTE: A partial output file is removed on failure, so that it is not taken for a merged file
+  const auto removeOutput = [&]() {
+    file.close();
+    std::remove(outputPath.c_str());
+    return false;
+  };
+
+  _writePublicHeader(header, lasData.variableLengthRecords, file);
 
   // ======================================================================================================================
-  // Open file
+  // Re-quantize and write 'Point Data Records'
   // ======================================================================================================================
-  std::vector<char> fileBytes;
-  {
-    std::ifstream file = std::ifstream(filePath, std::ios::binary);
+  ReadOptions readOptions;
+  readOptions.numThreads = options.numThreads;
+
+  PointStatistics statistics;
+  size_t nPoints = 0;
+  std::vector<char> buffer;
+
+  const auto writeChunk = [&](const PublicHeader& sourceHeader) {
+    const size_t nChunkPoints = lasData.pointDataRecords.size();
+
+    std::atomic<bool> isInRange(true);
+    parallelFor(nChunkPoints, options.numThreads, [&](const size_t begin, const size_t end) {
+      if (!_requantizePoints(sourceHeader, begin, end - begin, lasData)) {
+        isInRange = false;
+      }
+    });
+    if (!isInRange) {
+      _LLAS_logError("Coordinates do not fit into 32 bits with the merged scale factors and offsets");
+      return false;
+    }
+
+    statistics.merge(lasData.getStatistics(options.numThreads));
+
+    buffer.resize(nChunkPoints * recordLength);
+    if (!writePointDataRecords(lasData, 0, nChunkPoints, recordLength, format, options.numThreads, buffer.data())) {
+      return false;
+    }
+    file.write(buffer.data(), (std::streamsize)buffer.size());
     if (!file) {
-      _LLAS_logError("Failed to open file: " + filePath);
-      return nullptr;  // return nullptr
+      _LLAS_logError("Failed to write file: " + outputPath);
+      return false;
     }
+    nPoints += nChunkPoints;
+
+    return true;
+  };
 
-    file.seekg(0, std::ios::end);
-    std::streampos fileSize = file.tellg();
-    file.seekg(0, std::ios::beg);
+  for (size_t iFile = 0; iFile < filePaths.size(); ++iFile) {
+    if (isCompressed[iFile]) {
+      // NOTE: LAZ files can not be streamed, so they are decompressed tile by tile
+      const LasData_ptr tile = read(filePaths[iFile], readOptions);
+      if (tile == nullptr) {
+        return removeOutput();
+      }
 
-    fileBytes.resize(fileSize);
-    file.read(fileBytes.data(), fileSize);
+      lasData.pointDataRecords = std::move(tile->pointDataRecords);
+      if (!writeChunk(tile->header)) {
+        return removeOutput();
+      }
+      continue;
+    }
 
-    file.close();
+    LasReader reader(filePaths[iFile], readOptions);
+    if (!reader.isOpen()) {
+      return removeOutput();
+    }
+    while (reader.nextChunk(lasData.pointDataRecords, MergeOptions::NUM_POINTS_PER_CHUNK) > 0) {
+      if (!writeChunk(reader.getHeader())) {
+        return removeOutput();
+      }
+    }
+
+    // NOTE: `nextChunk` also returns `0` on a read error, which leaves records unread
+    if (!reader.eof()) {
+      _LLAS_logError("Failed to read Point Data Records: " + filePaths[iFile]);
+      return removeOutput();
+    }
   }
 
   // ======================================================================================================================
-  // Read 'Public Header'
+  // Rewrite 'Public Header'
   // ======================================================================================================================
-  const PublicHeader publicHeader = PublicHeader::readPublicHeader(fileBytes);
-
-  _LLAS_logInfo("version: " + std::to_string(publicHeader.versionMajor) + "." + std::to_string(publicHeader.versionMinor));
+  if (!_buildPublicHeader(lasData, nPoints, statistics, true, header)) {
+    return removeOutput();
+  }
 
-  const LLAS_UCHAR format = publicHeader.pointDataRecordFormat;
-  _LLAS_logInfo("format: " + std::to_string(format));
+  std::vector<char> byteData(header.headerSize, 0);
+  header.writePublicHeader(byteData.data());
+  file.seekp(0);
+  file.write(byteData.data(), (std::streamsize)byteData.size());
 
-  if (format < 0 || 10 < format) {
-    // NOTE: Format is defined from 0 to 10
-    _LLAS_logError("Invalid point data record format:  " + std::to_string(format));
-    return nullptr;  // return nullptr
+  file.close();
+  if (!file) {
+    _LLAS_logError("Failed to write file: " + outputPath);
+    return removeOutput();
   }
 
-  const bool isLegacyFormat = format <= 5;
-
-  // ======================================================================================================================
-  // Read 'Variable Length Records'
-  // ======================================================================================================================
+  return true;
+}
 
-  std::vector<VariableLengthRecord> variableLengthRecords;
-  {
-    if (!pointDataOnly) {
-      const LLAS_ULONG nVariableLengthRecords = publicHeader.numOfVariableLengthRecords;
-      _LLAS_logInfo("nVariableLengthRecords: " + std::to_string(nVariableLengthRecords));
+// ==========================================================================
+// Tile cache
+// ==========================================================================
 
-      variableLengthRecords.resize(nVariableLengthRecords);  // allocate
+/// @brief Thread-safe cache of decoded files (e.g. the hot tiles of a tile server) evicted in least recently used order beyond a memory budget.
+///        Files are keyed by path and reloaded once their modification time or size changes (`io::FileStamp`).
+///        Concurrent requests for a file which is being loaded wait for that load instead of reading the file again.
+///        Cached `LasData` is shared by all callers and must not be modified.
+class TileCache {
+ public:
+  // clang-format off
+  inline static const size_t DEFAULT_MEMORY_BUDGET                                                  = (size_t)1 << 30;
+  // clang-format on
 
-      // NOTE: Move to the starting point of VLR
-      std::streamsize offset = publicHeader.headerSize;
+  /// @param memoryBudget Maximum number of bytes of cached files (`LasData::getMemorySize`)
+  /// @param options Read options of every file
+  TileCache(const size_t memoryBudget = DEFAULT_MEMORY_BUDGET,
+            const ReadOptions& options = ReadOptions())
+      : _memoryBudget(memoryBudget),
+        _options(options),
+        _mutex(),
+        _entries(),
+        _index(),
+        _loads(),
+        _memorySize(),
+        _nextLoadID(),
+        _nHits(),
+        _nMisses() {}
+
+  TileCache(const TileCache&) = delete;
+  TileCache& operator=(const TileCache&) = delete;
+
+  /// @brief Get a decoded file, which is read unless it is cached and unchanged on disk. Safe to call from any thread.
+  /// @param filePath Path to the las file
+  /// @return `Las data` (`LasData_ptr`): shared content, or `nullptr` if the file could not be read. Failures are not cached.
+  ///         Exceptions of reading (e.g. `std::bad_alloc`) are thrown to every request waiting for the file.
+  inline LasData_ptr get(const std::string& filePath) {
+    io::FileStamp fileStamp;
+    if (!io::getFileStamp(filePath, fileStamp)) {
+      _LLAS_logError("Failed to open file: " + filePath);
+      return nullptr;  // return nullptr
+    }
 
-      for (LLAS_ULONG iRecord = 0; iRecord < nVariableLengthRecords; ++iRecord) {
-        if ((LLAS_ULONG)offset >= publicHeader.offsetToPointData) {
-          isOK = false;
-          _LLAS_logError("The total size of VLRs exceeds the start of Point Data records!");
-          break;
+    std::promise<LasData_ptr> promise;
+    std::shared_future<LasData_ptr> pendingLoad;
+    LLAS_ULLONG loadID = 0;
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+
+      const auto found = _index.find(filePath);
+      if (found != _index.end()) {
+        if (found->second->fileStamp == fileStamp) {
+          _entries.splice(_entries.begin(), _entries, found->second);
+          ++_nHits;
+          return found->second->lasData;
         }
 
-        const auto variableLengthRecord = VariableLengthRecord::readVariableLengthRecord(fileBytes, offset);
-        variableLengthRecords[iRecord] = variableLengthRecord;
+        // NOTE: The file was rewritten
+        _erase(found->second);
+      }
+
+      const auto loading = _loads.find(filePath);
+      if (loading != _loads.end() && loading->second.fileStamp == fileStamp) {
+        pendingLoad = loading->second.future;
+        ++_nHits;
+      } else {
+        loadID = ++_nextLoadID;
+        _loads[filePath] = Load{fileStamp, loadID, promise.get_future().share()};
+        ++_nMisses;
       }
     }
-  }
 
-  // ======================================================================================================================
-  // Read 'Point Data Records'
-  // ======================================================================================================================
+    // NOTE: Another request is reading the same file
+    if (pendingLoad.valid()) {
+      return pendingLoad.get();
+    }
 
-  std::vector<PointDataRecord> pointDataRecords;
-  {
-    const LLAS_ULLONG nPointRecords = isLegacyFormat ? publicHeader.legacyNumOfPointRecords : publicHeader.numOfPointRecords;
-    _LLAS_logInfo("nPointRecords: " + std::to_string(nPointRecords));
+    // NOTE: The file is read without the lock so that other files are served meanwhile
+    LasData_ptr lasData;
+    try {
+      lasData = read(filePath, _options);
+    } catch (...) {
+      // NOTE: The requests waiting for this load get the exception, and the next request reads the file again
+      {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _eraseLoad(filePath, loadID);
+      }
+      promise.set_exception(std::current_exception());
+      throw;
+    }
 
-    const char* byteData = fileBytes.data();
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      if (_eraseLoad(filePath, loadID) && lasData != nullptr) {
+        _insert(filePath, fileStamp, lasData);
+      }
+    }
 
-    pointDataRecords.resize(nPointRecords);  // allocate
+    promise.set_value(lasData);
 
-    for (LLAS_ULLONG iRecord = 0; iRecord < nPointRecords; ++iRecord) {
-      // NOTE: Move to the starting point of each Point Data Record
-      std::streamsize offset = publicHeader.offsetToPointData + iRecord * publicHeader.pointDataRecordLength;
+    return lasData;
+  }
 
-      // Read
-      const auto pointDataRecord = PointDataRecord::readPointDataRecord(byteData, offset, format);
-      pointDataRecords[iRecord] = pointDataRecord;
+  /// @brief Remove a file from the cache. Callers which hold it keep it.
+  inline void erase(const std::string& filePath) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    const auto found = _index.find(filePath);
+    if (found != _index.end()) {
+      _erase(found->second);
     }
   }
 
-  // ======================================================================================================================
-  // Read 'Extended Variable Length Records'
-  // ======================================================================================================================
+  /// @brief Remove all the files from the cache
+  inline void clear() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _entries.clear();
+    _index.clear();
+    _memorySize = 0;
+  }
 
-  std::vector<ExtendedVariableLengthRecord> extendedVariableLengthRecords;
-  {
-    // version >= 1.4
-    if (!pointDataOnly && publicHeader.hasStartOfFirstExtendedVariableLengthRecord && publicHeader.hasNumOfExtendedVariableLengthRecords) {
-      const LLAS_ULONG nExtendedVariableLengthRecords = publicHeader.numOfExtendedVariableLengthRecords;
-      _LLAS_logInfo("nExtendedVariableLengthRecords: " + std::to_string(nExtendedVariableLengthRecords));
+  /// @brief Change the memory budget and evict files beyond it
+  inline void setMemoryBudget(const size_t memoryBudget) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _memoryBudget = memoryBudget;
+    _evict();
+  }
+
+  inline size_t getMemoryBudget() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _memoryBudget;
+  }
 
-      // Allocate
-      extendedVariableLengthRecords.resize(nExtendedVariableLengthRecords);
+  /// @brief Get the number of bytes of the cached files
+  inline size_t getMemorySize() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _memorySize;
+  }
 
-      // NOTE: Move to the starting point of EVLR
-      std::streamsize offset = publicHeader.startOfFirstExtendedVariableLengthRecord;
+  /// @brief Get the number of cached files
+  inline size_t size() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _entries.size();
+  }
 
-      // Read
-      for (LLAS_ULONG iRecord = 0; iRecord < nExtendedVariableLengthRecords; ++iRecord) {
-        const auto extendedVariableLengthRecord = ExtendedVariableLengthRecord::readExtendedVariableLengthRecord(fileBytes, offset);
-        extendedVariableLengthRecords[iRecord] = extendedVariableLengthRecord;
-      }
-    }
+  /// @brief Get the number of requests served from the cache or by waiting for a load of another request
+  inline LLAS_ULLONG getNumHits() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _nHits;
   }
 
-  // ======================================================================================================================
-  // Create output object
-  // ======================================================================================================================
-  LasData_ptr lasData = nullptr;
+  /// @brief Get the number of requests which read the file
+  inline LLAS_ULLONG getNumMisses() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _nMisses;
+  }
+
+ private:
+  struct Entry {
+    std::string filePath;
+    io::FileStamp fileStamp;
+    LasData_ptr lasData;
+    size_t memorySize;
+  };
+
+  struct Load {
+    io::FileStamp fileStamp;
+    LLAS_ULLONG loadID;
+    std::shared_future<LasData_ptr> future;
+  };
+
+  inline void _insert(const std::string& filePath,
+                      const io::FileStamp& fileStamp,
+                      const LasData_ptr& lasData) {
+    const auto found = _index.find(filePath);
+    if (found != _index.end()) {
+      _erase(found->second);
+    }
 
-  if (isOK) {
-    lasData = std::make_shared<LasData>();
+    const size_t memorySize = lasData->getMemorySize();
+    if (memorySize > _memoryBudget) {
+      _LLAS_logInfo("File exceeds the memory budget of the cache: " + filePath);
+      return;
+    }
+
+    _entries.push_front(Entry{filePath, fileStamp, lasData, memorySize});
+    _index[filePath] = _entries.begin();
+    _memorySize += memorySize;
 
-    lasData->header = publicHeader;
-    lasData->variableLengthRecords = variableLengthRecords;
-    lasData->pointDataRecords = pointDataRecords;
-    lasData->extendedVariableLengthRecord = extendedVariableLengthRecords;
+    _evict();
   }
 
-#if defined(LLAS_MEASURE_TIME)
-  const auto endTime = std::chrono::system_clock::now();
-  const double elapsedTime = std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count();
-  _LLAS_logInfo("Elapsed time: " + std::to_string(elapsedTime * 1e-6) + " [sec]");
-#endif
+  inline void _erase(const std::list<Entry>::iterator entry) {
+    _memorySize -= entry->memorySize;
+    _index.erase(entry->filePath);
+    _entries.erase(entry);
+  }
 
-  return lasData;
+  /// @brief Remove the load `loadID` of a file
+  /// @return `false` if a newer load of the rewritten file replaced it
+  inline bool _eraseLoad(const std::string& filePath,
+                         const LLAS_ULLONG loadID) {
+    const auto loading = _loads.find(filePath);
+    if (loading == _loads.end() || loading->second.loadID != loadID) {
+      return false;
+    }
+    _loads.erase(loading);
+    return true;
+  }
+
+  inline void _evict() {
+    while (_memorySize > _memoryBudget && !_entries.empty()) {
+      _erase(std::prev(_entries.end()));
+    }
+  }
+
+  size_t _memoryBudget;
+  ReadOptions _options;
+  mutable std::mutex _mutex;
+  std::list<Entry> _entries;                                           // Most recently used first
+  std::unordered_map<std::string, std::list<Entry>::iterator> _index;  // Entries by path
+  std::unordered_map<std::string, Load> _loads;                        // Loads in progress by path
+  size_t _memorySize;
+  LLAS_ULLONG _nextLoadID;
+  LLAS_ULLONG _nHits;
+  LLAS_ULLONG _nMisses;
 };
 };  // namespace llas
 
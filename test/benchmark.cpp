@@ -0,0 +1,294 @@
+// NOTE: Per-file logs would dominate the measured time
+#undef LLAS_LOG_INFO
+#undef LLAS_LOG_DEBUG
+#undef LLAS_MEASURE_TIME
+
+#include <llas.hpp>
+
+#include <cstdio>
+#include <filesystem>
+#include <functional>
+
+#if defined(_WIN32)
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace {
+
+/// @brief Peak resident memory of the process so far in MiB. It never decreases, so a phase only shows up if it raises the peak.
+double getPeakMemoryMiB() {
+#if defined(_WIN32)
+  PROCESS_MEMORY_COUNTERS counters;
+  if (K32GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+    return (double)counters.PeakWorkingSetSize / (1024.0 * 1024.0);
+  }
+  return 0.0;
+#else
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+#if defined(__APPLE__)
+  return (double)usage.ru_maxrss / (1024.0 * 1024.0);  // bytes
+#else
+  return (double)usage.ru_maxrss / 1024.0;  // KiB
+#endif
+#endif
+}
+
+/// @brief Best elapsed time of `nRepeats` runs of `func` in seconds
+double measure(const std::function<void()>& func, const size_t nRepeats) {
+  double bestTime = std::numeric_limits<double>::max();
+  for (size_t iRepeat = 0; iRepeat < nRepeats; ++iRepeat) {
+    const auto startTime = std::chrono::steady_clock::now();
+    func();
+    const auto endTime = std::chrono::steady_clock::now();
+    bestTime = std::min(bestTime, std::chrono::duration<double>(endTime - startTime).count());
+  }
+  return bestTime;
+}
+
+void printRow(const int format,
+              const size_t nPoints,
+              const std::string& phase,
+              const double seconds,
+              const size_t nItems,
+              const size_t nBytes) {
+  std::printf("%6d %10zu  %-28s %10.4f %12.2f %10.1f %20.1f\n",
+              format, nPoints, phase.c_str(), seconds * 1e3, (double)nItems / seconds * 1e-6, (double)nBytes / seconds / (1024.0 * 1024.0), getPeakMemoryMiB());
+}
+
+/// @brief Number of bytes of the points of `lasData` in its layout, which accessors like `getStatistics` scan
+size_t getPointBytes(const llas::LasData& lasData) {
+  const size_t nPoints = lasData.getNumPoints();
+  if (lasData.layout == llas::PointDataLayout::Packed) {
+    return nPoints * lasData.packedPointData.recordSize;
+  }
+  if (lasData.layout == llas::PointDataLayout::StructOfArrays) {
+    return lasData.pointDataColumns.getMemorySize();
+  }
+  return nPoints * sizeof(llas::PointDataRecord);
+}
+
+/// @brief Parse a non-negative decimal count
+/// @return `false` if `text` is not a number or does not fit into `size_t`
+bool parseCount(const std::string& text,
+                size_t& value) {
+  if (text.empty() || text.find_first_not_of("0123456789") != std::string::npos) {
+    return false;
+  }
+
+  try {
+    const unsigned long long parsed = std::stoull(text);
+    if (parsed > std::numeric_limits<size_t>::max()) {
+      return false;
+    }
+    value = (size_t)parsed;
+  } catch (const std::out_of_range&) {
+    return false;
+  }
+  return true;
+}
+
+/// @brief Create points with every attribute of `format` set
+llas::LasData createLasData(const int format,
+                            const size_t nPoints) {
+  llas::LasData lasData;
+
+  llas::PublicHeader& header = lasData.header;
+  header.versionMajor = 1;
+  header.versionMinor = llas::PointDataRecord::isExtendedFormat((LLAS_UCHAR)format) ? 4 : 2;
+  header.pointDataRecordFormat = (LLAS_UCHAR)format;
+  header.pointDataRecordLength = llas::PointDataRecord::getFormatSize((LLAS_UCHAR)format);
+  header.xScaleFactor = 0.001;
+  header.yScaleFactor = 0.001;
+  header.zScaleFactor = 0.001;
+  header.xOffset = 500000.0;
+  header.yOffset = 4000000.0;
+  header.zOffset = 0.0;
+
+  // NOTE: A linear congruential generator keeps the files identical between runs
+  LLAS_ULONG state = 12345;
+  const auto next = [&state]() {
+    state = state * 1664525U + 1013904223U;
+    return state >> 8;
+  };
+
+  lasData.pointDataRecords.resize(nPoints);
+  for (size_t iPoint = 0; iPoint < nPoints; ++iPoint) {
+    llas::PointDataRecord& point = lasData.pointDataRecords[iPoint];
+    point.x = (LLAS_LONG)(next() % 1000000);
+    point.y = (LLAS_LONG)(next() % 1000000);
+    point.z = (LLAS_LONG)(next() % 100000);
+    point.intensity = (LLAS_USHORT)next();
+    point.numberOfReturns = (LLAS_UCHAR)(1 + next() % 5);
+    point.returnNumber = (LLAS_UCHAR)(1 + next() % point.numberOfReturns);
+    point.classification = (LLAS_UCHAR)(next() % 20);
+    point.scanDirectionFlag = (LLAS_UCHAR)(next() % 2);
+    point.scanAngleRank = (LLAS_SCHAR)(next() % 61 - 30);
+    point.scanAngle = (LLAS_SHORT)(next() % 10001 - 5000);
+    point.userData = (LLAS_UCHAR)next();
+    point.pointSourceID = (LLAS_USHORT)(next() % 16);
+    point.GPSTime = 1e5 + (double)iPoint * 1e-5;
+    point.red = (LLAS_USHORT)next();
+    point.green = (LLAS_USHORT)next();
+    point.blue = (LLAS_USHORT)next();
+    point.NIR = (LLAS_USHORT)next();
+  }
+
+  return lasData;
+}
+
+void runBenchmark(const std::string& filePath,
+                  const int format,
+                  const size_t nPoints,
+                  const size_t nThreads,
+                  const size_t nRepeats) {
+  if (!llas::write(filePath, createLasData(format, nPoints))) {
+    std::printf("Failed to write %s\n", filePath.c_str());
+    return;
+  }
+
+  std::vector<char> fileBytes;
+  const double ioTime = measure([&]() { llas::io::readFileBytes(filePath, fileBytes); }, nRepeats);
+  const size_t fileSize = fileBytes.size();
+  printRow(format, nPoints, "file I/O", ioTime, nPoints, fileSize);
+
+  // NOTE: A single header is too fast to time, so it is parsed many times
+  const size_t N_HEADERS = 100000;
+  llas::PublicHeader header;
+  const double headerTime = measure([&]() {
+    for (size_t i = 0; i < N_HEADERS; ++i) {
+      header = llas::PublicHeader::readPublicHeader(fileBytes.data());
+    }
+  }, nRepeats);
+  printRow(format, nPoints, "readPublicHeader", headerTime, N_HEADERS, N_HEADERS * (size_t)header.headerSize);
+
+  const char* byteData = fileBytes.data() + header.offsetToPointData;
+  const size_t nPointBytes = nPoints * header.pointDataRecordLength;
+  const llas::RawPointFilter filter;
+
+  for (const size_t decodeThreads : {(size_t)1, nThreads}) {
+    std::vector<llas::PointDataRecord> pointDataRecords;
+    const double aosTime = measure([&]() {
+      llas::decodePointDataRecords(byteData, nPoints, header.pointDataRecordLength, (LLAS_UCHAR)format, llas::PointField::ALL, filter, decodeThreads, pointDataRecords);
+    }, nRepeats);
+    printRow(format, nPoints, "decode AoS (" + std::to_string(decodeThreads) + " threads)", aosTime, nPoints, nPointBytes);
+
+    llas::PointDataColumns pointDataColumns;
+    const double soaTime = measure([&]() {
+      llas::decodePointDataRecords(byteData, nPoints, header.pointDataRecordLength, (LLAS_UCHAR)format, llas::PointField::ALL, filter, decodeThreads, pointDataColumns);
+    }, nRepeats);
+    printRow(format, nPoints, "decode SoA (" + std::to_string(decodeThreads) + " threads)", soaTime, nPoints, nPointBytes);
+
+    if (decodeThreads == nThreads) {
+      break;
+    }
+  }
+  fileBytes = std::vector<char>();
+
+  llas::ReadOptions options;
+  llas::LasData_ptr lasData;
+
+  options.useMemoryMap = true;
+  const double mmapTime = measure([&]() { lasData = llas::read(filePath, options); }, nRepeats);
+  printRow(format, nPoints, "read (mmap)", mmapTime, nPoints, fileSize);
+
+  options.useMemoryMap = false;
+  const double bufferedTime = measure([&]() { lasData = llas::read(filePath, options); }, nRepeats);
+  printRow(format, nPoints, "read (buffered)", bufferedTime, nPoints, fileSize);
+
+  options.useMemoryMap = true;
+  options.numThreads = nThreads;
+  const double parallelTime = measure([&]() { lasData = llas::read(filePath, options); }, nRepeats);
+  printRow(format, nPoints, "read (" + std::to_string(nThreads) + " threads)", parallelTime, nPoints, fileSize);
+
+  // NOTE: The packed points are kept apart, so that the accessors below measure the default layout like before
+  llas::LasData_ptr packedData;
+  options.layout = llas::PointDataLayout::Packed;
+  const double packedTime = measure([&]() { packedData = llas::read(filePath, options); }, nRepeats);
+  printRow(format, nPoints, "read (packed)", packedTime, nPoints, fileSize);
+  options.layout = llas::PointDataLayout::ArrayOfStructs;
+
+  const double streamingTime = measure([&]() {
+    llas::LasReader reader(filePath, options);
+    std::vector<llas::PointDataRecord> chunk;
+    while (reader.nextChunk(chunk, 1 << 16) > 0) {
+    }
+  }, nRepeats);
+  printRow(format, nPoints, "read (streaming)", streamingTime, nPoints, fileSize);
+
+  if (lasData == nullptr || packedData == nullptr) {
+    return;
+  }
+
+  const double coordsTime = measure([&]() { lasData->getPointCoords(); }, nRepeats);
+  printRow(format, nPoints, "getPointCoords", coordsTime, nPoints, nPoints * 3 * sizeof(double));
+
+  const double statisticsTime = measure([&]() { lasData->getStatistics(nThreads); }, nRepeats);
+  printRow(format, nPoints, "getStatistics (" + std::to_string(nThreads) + " threads)", statisticsTime, nPoints, getPointBytes(*lasData));
+
+  const double packedStatisticsTime = measure([&]() { packedData->getStatistics(nThreads); }, nRepeats);
+  printRow(format, nPoints, "getStatistics packed (" + std::to_string(nThreads) + " thr)", packedStatisticsTime, nPoints, getPointBytes(*packedData));
+  packedData = nullptr;
+
+  if (llas::PointDataRecord::hasRGB((LLAS_UCHAR)format)) {
+    const double colorsTime = measure([&]() { lasData->getPointColors(); }, nRepeats);
+    printRow(format, nPoints, "getPointColors", colorsTime, nPoints, nPoints * 3);
+
+    std::vector<unsigned char> rgba(4 * nPoints);
+    const double rgbaTime = measure([&]() { lasData->getPointColorsRGBA(rgba.data(), 0, llas::ColorDepth::Bits16, nThreads); }, nRepeats);
+    printRow(format, nPoints, "getPointColorsRGBA (" + std::to_string(nThreads) + " thr)", rgbaTime, nPoints, nPoints * 4);
+
+    std::vector<float> normalized(3 * nPoints);
+    const double normalizedTime = measure([&]() { lasData->getPointColors(normalized.data(), 0, llas::ColorDepth::Bits16, nThreads); }, nRepeats);
+    printRow(format, nPoints, "getPointColors float (" + std::to_string(nThreads) + " thr)", normalizedTime, nPoints, nPoints * 3 * sizeof(float));
+  }
+
+  std::remove(filePath.c_str());
+}
+
+}  // namespace
+
+/// @brief Measure the throughput of every step of reading synthetic files of every point data record format.
+///        Usage: `benchmark_llas_read [nPoints ...] [--threads N] [--repeats N]`
+int main(int argc, char** argv) {
+  std::vector<size_t> pointCounts;
+  size_t nThreads = 0;
+  size_t nRepeats = 3;
+
+  for (int iArg = 1; iArg < argc; ++iArg) {
+    const std::string arg = argv[iArg];
+    bool isValid = true;
+    if (arg == "--threads") {
+      isValid = iArg + 1 < argc && parseCount(argv[++iArg], nThreads);
+    } else if (arg == "--repeats") {
+      isValid = iArg + 1 < argc && parseCount(argv[++iArg], nRepeats);
+      nRepeats = std::max<size_t>(1, nRepeats);
+    } else {
+      size_t nPoints = 0;
+      isValid = parseCount(arg, nPoints);
+      pointCounts.push_back(nPoints);
+    }
+
+    if (!isValid) {
+      std::fprintf(stderr, "Invalid argument: %s\nUsage: %s [nPoints ...] [--threads N] [--repeats N]\n", arg.c_str(), argv[0]);
+      return 1;
+    }
+  }
+  if (pointCounts.empty()) {
+    pointCounts = {100000, 1000000};
+  }
+  nThreads = llas::resolveNumThreads(nThreads);
+
+  const std::string filePath = (std::filesystem::temp_directory_path() / "llas_benchmark.las").string();
+
+  std::printf("%6s %10s  %-28s %10s %12s %10s %20s\n", "format", "nPoints", "phase", "time[ms]", "Mitems/s", "MiB/s", "peak RSS so far[MiB]");
+  for (const size_t nPoints : pointCounts) {
+    for (int format = 0; format <= 10; ++format) {
+      runBenchmark(filePath, format, nPoints, nThreads, nRepeats);
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,154 @@
+#include <llas.hpp>
+
+#include <filesystem>
+
+// NOTE: The fixtures are pairs of `laz_fmt<format>.las` and `laz_fmt<format>.laz` in the data directory.
+//       The `.las` files are written by `test_llas_laz --write-las <dir>`, and every `.laz` file is encoded from its `.las` file
+//       by the reference LASzip, so that the decoder is checked against real LASzip output:
+//         laszip -i laz_fmt<format>.las -o laz_fmt<format>.laz -chunk_size 1000
+//       The points span several chunks of 1000 points, the last of which is partial.
+
+namespace {
+
+const LLAS_UCHAR FORMATS[] = {1, 3, 7};
+const size_t NUM_POINTS = 2500;
+
+// NOTE: Exit code which `ctest` reports as skipped (`SKIP_RETURN_CODE`)
+const int SKIP_EXIT_CODE = 77;
+
+std::string getFixturePath(const std::string& dataDir,
+                           const LLAS_UCHAR format,
+                           const std::string& extension) {
+  return (std::filesystem::path(dataDir) / ("laz_fmt" + std::to_string((int)format) + extension)).string();
+}
+
+/// @brief Build points of `format` whose attributes change from point to point, so that every context of the compressors is used
+llas::LasData makeLasData(const LLAS_UCHAR format, const size_t nPoints) {
+  const bool isExtended = llas::PointDataRecord::isExtendedFormat(format);
+
+  llas::LasData lasData;
+  lasData.header.versionMinor = isExtended ? 4 : 2;
+  lasData.header.pointDataRecordFormat = format;
+  lasData.header.xScaleFactor = 0.01;
+  lasData.header.yScaleFactor = 0.01;
+  lasData.header.zScaleFactor = 0.001;
+  lasData.header.xOffset = 500000.0;
+  lasData.header.yOffset = 4000000.0;
+  lasData.header.zOffset = 0.0;
+
+  lasData.pointDataRecords.resize(nPoints);
+  for (size_t i = 0; i < nPoints; ++i) {
+    llas::PointDataRecord& record = lasData.pointDataRecords[i];
+    const LLAS_UCHAR numberOfReturns = (LLAS_UCHAR)(1 + i / 7 % (isExtended ? 15 : 5));
+    record.x = (LLAS_LONG)(i * 37 + (i * i) % 101);
+    record.y = (LLAS_LONG)(i / 50 * 211) - (LLAS_LONG)(i % 13);
+    record.z = (LLAS_LONG)((i * 7919) % 20000) - 5000;
+    record.intensity = (LLAS_USHORT)((i * 131) % 4096);
+    record.numberOfReturns = numberOfReturns;
+    record.returnNumber = (LLAS_UCHAR)(1 + i % numberOfReturns);
+    record.classification = (LLAS_UCHAR)(i / 3 % (isExtended ? 64 : 32));
+    record.classificationFlags = (LLAS_UCHAR)(i / 11 % (isExtended ? 16 : 8));
+    record.scannerChannel = (LLAS_UCHAR)(isExtended ? i / 500 % 4 : 0);
+    record.scanDirectionFlag = (LLAS_UCHAR)(i / 100 % 2);
+    record.edgeOfFlightLine = (LLAS_UCHAR)(i % 100 == 99);
+    record.scanAngleRank = (LLAS_SCHAR)(isExtended ? 0 : (LLAS_LONG)(i / 10 % 61) - 30);
+    record.scanAngle = (LLAS_SHORT)(isExtended ? (LLAS_LONG)(i * 3 % 6001) - 3000 : 0);
+    record.userData = (LLAS_UCHAR)(i / 250);
+    record.pointSourceID = (LLAS_USHORT)(100 + i / 1200);
+    record.GPSTime = 3.0e5 + (double)i * 1.0e-4 + (double)(i / 400) * 0.5;
+    if (llas::PointDataRecord::hasRGB(format)) {
+      record.red = (LLAS_USHORT)((i * 256) % 65536);
+      record.green = (LLAS_USHORT)(i % 5 == 0 ? (i * 97) % 65536 : 32768);
+      record.blue = (LLAS_USHORT)(i / 20 * 256 % 65536);
+    }
+  }
+
+  return lasData;
+}
+
+/// @brief Read the `.laz` fixture of `format` and compare its records byte by byte with the matching `.las` fixture
+/// @return `false` if a file can not be read or a record differs
+bool testFixture(const std::string& dataDir, const LLAS_UCHAR format) {
+  const std::string lasPath = getFixturePath(dataDir, format, ".las");
+  const std::string lazPath = getFixturePath(dataDir, format, ".laz");
+
+  // NOTE: Packed records hold the bytes of every attribute, so equal records decode to equal points in every layout
+  llas::ReadOptions options;
+  options.layout = llas::PointDataLayout::Packed;
+  const llas::LasData_ptr lasData = llas::read(lasPath, options);
+  const llas::LasData_ptr lazData = llas::read(lazPath, options);
+  if (!lasData || !lazData) {
+    std::cout << "format " << (int)format << ": failed to read " << (lasData ? lazPath : lasPath) << std::endl;
+    return false;
+  }
+
+  const size_t nPoints = lasData->getNumPoints();
+  if (lazData->getNumPoints() != nPoints || lazData->header.pointDataRecordFormat != format || lasData->packedPointData.recordSize != lazData->packedPointData.recordSize) {
+    std::cout << "format " << (int)format << ": " << lazData->getNumPoints() << " points of format " << (int)lazData->header.pointDataRecordFormat
+              << " instead of " << nPoints << " points of format " << (int)format << std::endl;
+    return false;
+  }
+
+  const size_t recordSize = lasData->packedPointData.recordSize;
+  for (size_t i = 0; i < nPoints; ++i) {
+    if (std::memcmp(lasData->packedPointData.getRecord(i), lazData->packedPointData.getRecord(i), recordSize) != 0) {
+      std::cout << "format " << (int)format << ": point " << i << " differs" << std::endl;
+      return false;
+    }
+  }
+
+  // NOTE: Threads decode the chunks independently
+  llas::ReadOptions threadOptions;
+  threadOptions.numThreads = 4;
+  const llas::LasData_ptr threadData = llas::read(lazPath, threadOptions);
+  if (!threadData || threadData->getNumPoints() != nPoints || !threadData->validate()) {
+    std::cout << "format " << (int)format << ": failed to decode with threads" << std::endl;
+    return false;
+  }
+  for (size_t i = 0; i < nPoints; ++i) {
+    const llas::PointDataRecord expected = lasData->getPointDataRecord(i);
+    const llas::PointDataRecord& record = threadData->pointDataRecords[i];
+    if (record.x != expected.x || record.y != expected.y || record.z != expected.z || record.GPSTime != expected.GPSTime) {
+      std::cout << "format " << (int)format << ": point " << i << " differs with threads" << std::endl;
+      return false;
+    }
+  }
+
+  std::cout << "format " << (int)format << ": OK" << std::endl;
+  return true;
+}
+
+}  // namespace
+
+/// @brief Check the LAZ decoder against reference LASzip output.
+///        Usage: `test_llas_laz <dataDir>`, or `test_llas_laz --write-las <dataDir>` to write the `.las` fixtures
+int main(int argc, char** argv) {
+  if (argc == 3 && std::string(argv[1]) == "--write-las") {
+    for (const LLAS_UCHAR format : FORMATS) {
+      if (!llas::write(getFixturePath(argv[2], format, ".las"), makeLasData(format, NUM_POINTS))) {
+        return 1;
+      }
+    }
+    return 0;
+  }
+
+  if (argc != 2) {
+    std::cout << "Usage: " << argv[0] << " [--write-las] <dataDir>" << std::endl;
+    return 1;
+  }
+  const std::string dataDir = argv[1];
+
+  for (const LLAS_UCHAR format : FORMATS) {
+    if (!std::filesystem::exists(getFixturePath(dataDir, format, ".laz"))) {
+      std::cout << "Missing fixture: " << getFixturePath(dataDir, format, ".laz") << ". Encode it from the `.las` fixture with the reference LASzip." << std::endl;
+      return SKIP_EXIT_CODE;
+    }
+  }
+
+  bool isOK = true;
+  for (const LLAS_UCHAR format : FORMATS) {
+    isOK = testFixture(dataDir, format) && isOK;
+  }
+
+  return isOK ? 0 : 1;
+}
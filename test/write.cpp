@@ -0,0 +1,109 @@
+#include <llas.hpp>
+
+namespace {
+
+/// @brief Build points with distinct values in every attribute of `format`
+llas::LasData makeLasData(const LLAS_UCHAR format, const size_t nPoints) {
+  const bool isExtended = llas::PointDataRecord::isExtendedFormat(format);
+
+  llas::LasData lasData;
+  lasData.header.versionMinor = isExtended ? 4 : 2;
+  lasData.header.pointDataRecordFormat = format;
+  lasData.header.xScaleFactor = 0.01;
+  lasData.header.yScaleFactor = 0.01;
+  lasData.header.zScaleFactor = 0.001;
+  lasData.header.xOffset = 1000.0;
+  lasData.header.yOffset = -2000.0;
+  lasData.header.zOffset = 0.0;
+
+  lasData.pointDataRecords.resize(nPoints);
+  for (size_t i = 0; i < nPoints; ++i) {
+    llas::PointDataRecord& record = lasData.pointDataRecords[i];
+    record.x = (LLAS_LONG)(i * 7919) - 100000;
+    record.y = (LLAS_LONG)(i * 104729) % 1000003;
+    record.z = -(LLAS_LONG)(i * 31);
+    record.intensity = (LLAS_USHORT)(i * 13);
+    record.returnNumber = (LLAS_UCHAR)(1 + i % (isExtended ? 15 : 5));
+    record.numberOfReturns = (LLAS_UCHAR)(isExtended ? 15 : 5);
+    record.classification = (LLAS_UCHAR)(i % (isExtended ? 256 : 32));
+    record.classificationFlags = (LLAS_UCHAR)(i % (isExtended ? 16 : 8));
+    record.scannerChannel = (LLAS_UCHAR)(isExtended ? i % 4 : 0);
+    record.scanDirectionFlag = (LLAS_UCHAR)(i % 2);
+    record.edgeOfFlightLine = (LLAS_UCHAR)(i / 2 % 2);
+    record.scanAngleRank = (LLAS_SCHAR)(isExtended ? 0 : (LLAS_LONG)(i % 181) - 90);
+    record.scanAngle = (LLAS_SHORT)(isExtended ? (LLAS_LONG)(i % 30001) - 15000 : 0);
+    record.userData = (LLAS_UCHAR)(i * 3);
+    record.pointSourceID = (LLAS_USHORT)(i * 17);
+    record.GPSTime = llas::PointDataRecord::hasGPSTime(format) ? 1.0e8 + (double)i * 0.25 : 0.0;
+    if (llas::PointDataRecord::hasRGB(format)) {
+      record.red = (LLAS_USHORT)(i * 5);
+      record.green = (LLAS_USHORT)(i * 11);
+      record.blue = (LLAS_USHORT)(i * 23);
+    }
+  }
+
+  return lasData;
+}
+
+bool isSameRecord(const llas::PointDataRecord& a, const llas::PointDataRecord& b) {
+  return a.x == b.x && a.y == b.y && a.z == b.z && a.intensity == b.intensity &&
+         a.returnNumber == b.returnNumber && a.numberOfReturns == b.numberOfReturns &&
+         a.classification == b.classification && a.classificationFlags == b.classificationFlags &&
+         a.scannerChannel == b.scannerChannel && a.scanDirectionFlag == b.scanDirectionFlag && a.edgeOfFlightLine == b.edgeOfFlightLine &&
+         a.scanAngleRank == b.scanAngleRank && a.scanAngle == b.scanAngle && a.userData == b.userData && a.pointSourceID == b.pointSourceID &&
+         a.GPSTime == b.GPSTime && a.red == b.red && a.green == b.green && a.blue == b.blue;
+}
+
+/// @brief Write points of `format`, read them back and compare every attribute
+bool testRoundTrip(const LLAS_UCHAR format, const std::string& filePath) {
+  const llas::LasData lasData = makeLasData(format, 10000);
+  if (!llas::write(filePath, lasData)) {
+    std::cout << "format " << (int)format << ": failed to write" << std::endl;
+    return false;
+  }
+
+  const llas::LasData_ptr readData = llas::read(filePath);
+  if (!readData || readData->getNumPoints() != lasData.getNumPoints() || readData->header.pointDataRecordFormat != format) {
+    std::cout << "format " << (int)format << ": failed to read back" << std::endl;
+    return false;
+  }
+
+  for (size_t i = 0; i < lasData.getNumPoints(); ++i) {
+    if (!isSameRecord(lasData.pointDataRecords[i], readData->pointDataRecords[i])) {
+      std::cout << "format " << (int)format << ": point " << i << " differs" << std::endl;
+      return false;
+    }
+  }
+
+  // NOTE: Points read without some attributes are written only on request
+  llas::ReadOptions readOptions;
+  readOptions.fields = llas::PointField::XYZ;
+  const llas::LasData_ptr xyzData = llas::read(filePath, readOptions);
+  if (!xyzData || llas::write(filePath, *xyzData)) {
+    std::cout << "format " << (int)format << ": points without attributes were written" << std::endl;
+    return false;
+  }
+
+  llas::WriteOptions writeOptions;
+  writeOptions.allowMissingFields = true;
+  if (!llas::write(filePath, *xyzData, writeOptions)) {
+    std::cout << "format " << (int)format << ": failed to write with `allowMissingFields`" << std::endl;
+    return false;
+  }
+
+  std::cout << "format " << (int)format << ": OK" << std::endl;
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const std::string filePath = argc > 1 ? argv[1] : "test_llas_write.las";
+
+  bool isOK = true;
+  isOK = testRoundTrip(1, filePath) && isOK;  // Legacy
+  isOK = testRoundTrip(7, filePath) && isOK;  // Extended
+  std::remove(filePath.c_str());
+
+  return isOK ? 0 : 1;
+}